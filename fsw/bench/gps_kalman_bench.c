@@ -0,0 +1,1153 @@
+/*=======================================================================================
+** File Name:  gps_kalman_bench.c
+**
+** Title:  Host benchmark for the GPS_KALMAN filter core
+**
+** $Author:    GPS_KALMAN Team
+** $Revision: 1.1 $
+** $Date:      2026-10-17
+**
+** Purpose:  This file times the cFE-free filter core (gps_kalman_core.c) on a stream
+**           of fixes, either synthetic or read from a recorded file, and reports the
+**           cost per update, the update rate and the allocations made while filtering.
+**           Run with the estimates of another build as reference, it also reports how
+**           far this build's filter precision strays from it. It also times the decimal
+**           minutes to degrees conversion, per value and as an array, on the stream's
+**           latitudes and longitudes.
+**
+** Usage:
+**    gps_kalman_bench [-n fixes] [-r rate_hz] [-o outliers] [-g gate] [-s sources]
+**                     [-l lag] [-k tol] [-d dops] [-f fixes.csv] [-w out.csv]
+**                     [-c ref.csv [-t m[,kph[,deg]]]]
+**
+**    -n  number of synthetic fixes (default 1000000)
+**    -r  synthetic fix rate, Hz (default 10)
+**    -o  fraction of synthetic fixes thrown BENCH_OUTLIER_M off, as by multipath
+**        (default 0)
+**    -g  innovation gate, chi-square (default the platform GPS_KALMAN_GATE_CHI2;
+**        0 turns it off)
+**    -s  synthetic receivers taking turns, up to GPS_KALMAN_SOURCE_MAX (default 1).
+**        Receiver i is (1 + i) times as noisy as receiver 0 and stamps its fixes
+**        i * BENCH_LATENCY_S late; the filter is told both.
+**    -l  fixed-lag smoother lag, fixes, up to GPS_KALMAN_SMOOTH_LAG (default
+**        GPS_KALMAN_SMOOTH_LAG; 0 turns it off). The stream is filtered again with
+**        the smoother, which is timed and, on a synthetic stream, scored separately.
+**    -k  steady-state gain tolerance (default the platform GPS_KALMAN_STEADY_GAIN_TOL;
+**        0 runs the full filter on every fix)
+**    -d  synthetic HDOP levels (default 1). With more than one, every BENCH_DOP_HOLD
+**        fixes the HDOP is redrawn from 1, 1 + BENCH_DOP_STEP, ..., and the position
+**        noise scales with it, so the steady-state gain cache sees DOP changes.
+**    -f  recorded fixes instead, one per line:
+**            time_s,lat_deg,lon_deg,speed_kph,heading_deg,hdop
+**        with latitude and longitude in signed decimal degrees
+**    -w  write the estimate after each fix, one per line:
+**            time_s,lat_deg,lon_deg,speed_kph,heading_deg
+**    -c  compare the estimates with those of a reference run (-w output of, usually,
+**        the double build on the same fixes): horizontal position, speed and heading
+**        differences
+**    -t  with -c, fail the run if the largest position, speed or heading difference
+**        is over m, kph or deg; any left out are not checked
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. The whole stream is loaded before timing starts, so file I/O and parsing are
+**       not measured. Each timed update is GPS_KALMAN_Core_Step plus
+**       GPS_KALMAN_Core_Estimate, the work GPS_KALMAN_RunFilter does per fix.
+**    2. Allocations are counted by wrapping the glibc allocator; elsewhere they are
+**       reported as unavailable
+**    3. The synthetic vehicle drives a 500 m circle at 15 m/s with 3 m position and
+**       0.3 m/s velocity noise, so the reported errors are a sanity check on the
+**       filter as well
+**    4. Heading differences are only counted where the reference speed is over
+**       BENCH_HDG_MIN_KPH, as heading is meaningless when stopped
+**    5. The conversions are repeated to at least BENCH_DM_VALUES values; the array
+**       form must match the scalar one bit for bit, or the run fails
+**    6. BENCH_BANK_TRACKS tracks are run through the multi-track bank and, one by
+**       one, through the scalar filter; any bitwise difference fails the run
+**    7. A vehicle stopping and moving off again checks that the heading is held
+**       while stopped, with its variance growing as modelled, and follows the
+**       vehicle again afterwards; otherwise the run fails
+**    8. Coasting is timed from the final state over BENCH_COAST_STEPS times up to
+**       twice params.coastMaxSec, and its closed form position error at
+**       params.coastMaxSec is checked against a full covariance prediction
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**   2026-10-17 | GPS_KALMAN Team | Build #: Code Started
+**   2026-10-17 | GPS_KALMAN Team | Estimate output and accuracy against a reference
+**   2026-10-17 | GPS_KALMAN Team | Synthetic outliers and the innovation gate
+**   2026-10-17 | GPS_KALMAN Team | Decimal minutes conversion, scalar against array
+**   2026-10-17 | GPS_KALMAN Team | Several synthetic receivers
+**   2026-10-17 | GPS_KALMAN Team | Fixed-lag smoother
+**   2026-10-17 | GPS_KALMAN Team | Heading error against the truth
+**   2026-10-17 | GPS_KALMAN Team | Steady-state gain
+**   2026-10-17 | GPS_KALMAN Team | Synthetic HDOP changes and gain cache counts
+**   2026-10-17 | GPS_KALMAN Team | Coast timing and position error
+**   2026-10-17 | GPS_KALMAN Team | Multi-track bank against the scalar filter
+**   2026-10-17 | GPS_KALMAN Team | Heading held while stopped
+**   2026-10-17 | GPS_KALMAN Team | Limits on the differences from a reference
+**
+**=====================================================================================*/
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gps_kalman_bank.h"
+#include "gps_kalman_core.h"
+#include "gps_kalman_smooth.h"
+#include "gps_kalman_stats.h"
+
+#define BENCH_PI           (3.14159265358979323846)
+#define BENCH_LAT0         (40.0)     /* synthetic circle centre */
+#define BENCH_LON0         (-105.0)
+#define BENCH_RADIUS_M     (500.0)
+#define BENCH_SPEED_MPS    (15.0)
+#define BENCH_POS_SIGMA_M  (3.0)
+#define BENCH_VEL_SIGMA    (0.3)
+#define BENCH_HDOP         (1.0)
+#define BENCH_DOP_STEP     (0.1)      /* between synthetic HDOP levels */
+#define BENCH_DOP_HOLD     (100)      /* fixes between synthetic HDOP changes */
+#define BENCH_OUTLIER_M    (60.0)     /* synthetic multipath jump */
+#define BENCH_HDG_MIN_KPH  (1.0)      /* slowest reference speed with a heading */
+#define BENCH_DM_VALUES    (10000000) /* fewest values a conversion timing covers */
+#define BENCH_LATENCY_S    (0.05)     /* stamp latency added per synthetic receiver */
+#define BENCH_COAST_STEPS  (1000000)  /* coasts timed */
+#define BENCH_BANK_TRACKS  (257)      /* not a multiple of a vector width */
+#define BENCH_BANK_STEPS   (200)
+#define BENCH_HELD_FIXES   (30)       /* 1 Hz fixes turning, then stopped, then turning */
+#define BENCH_HELD_SPEED   (36.0)     /* kph */
+#define BENCH_HELD_CREEP   (0.5)      /* kph while stopped, under the heading speed */
+#define BENCH_HELD_TURN    (2.0)      /* deg per fix */
+#define BENCH_HELD_RAMP    (5.0)      /* fixes to stop or reach BENCH_HELD_SPEED */
+#define BENCH_HELD_SETTLE  (10)       /* fixes after moving off before the heading counts */
+#define BENCH_HELD_MAX_DEG (5.0)      /* worst heading error allowed once settled */
+
+
+/*
+** Allocation counting
+*/
+static int           g_CountAllocs = 0;
+static unsigned long g_Allocs = 0;
+
+#if defined(__GLIBC__)
+#define BENCH_HAVE_ALLOC_COUNT 1
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+void *malloc(size_t size)
+{
+    g_Allocs += g_CountAllocs;
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t nmemb, size_t size)
+{
+    g_Allocs += g_CountAllocs;
+    return __libc_calloc(nmemb, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    g_Allocs += g_CountAllocs;
+    return __libc_realloc(ptr, size);
+}
+#else
+#define BENCH_HAVE_ALLOC_COUNT 0
+#endif
+
+/*
+** Synthetic stream
+*/
+typedef struct
+{
+    double north; /* truth, metres from the circle centre */
+    double east;
+    double hdg;   /* truth heading, degrees true */
+} BenchTruth_t;
+
+typedef struct
+{
+    double time;  /* time of the fix, s */
+    double lat;   /* filtered position, degrees */
+    double lon;
+    double vel;   /* filtered speed, kph, and heading, degrees true */
+    double hdg;
+} BenchOut_t;
+
+/* xorshift64*: repeatable noise without libc rand */
+static unsigned long long g_RngState = 0x9E3779B97F4A7C15ull;
+
+static double bench_uniform(void)
+{
+    g_RngState ^= g_RngState >> 12;
+    g_RngState ^= g_RngState << 25;
+    g_RngState ^= g_RngState >> 27;
+    return ((double) ((g_RngState * 2685821657736338717ull) >> 11) + 0.5) *
+           (1.0 / 9007199254740992.0);
+}
+
+static double bench_gauss(void)
+{
+    return sqrt(-2.0 * log(bench_uniform())) * cos(2.0 * BENCH_PI * bench_uniform());
+}
+
+static void bench_synthetic(GPS_KALMAN_Fix_t *fix, BenchTruth_t *truth, long n,
+                            double rate, double outliers, int sources, int dops)
+{
+    GPS_KALMAN_EnuAnchor_t centre;
+    double w = BENCH_SPEED_MPS / BENCH_RADIUS_M;
+    double dop = BENCH_HDOP;
+    long   k;
+
+    enu_anchor_set(&centre, BENCH_LAT0, BENCH_LON0);
+
+    for (k = 0; k < n; k++)
+    {
+        double t  = (double) k / rate;
+        double a  = w * t;
+        double vn = -BENCH_SPEED_MPS * sin(a);
+        double ve =  BENCH_SPEED_MPS * cos(a);
+        double jump_e = 0.0;
+        double jump_n = 0.0;
+        int    src    = (int) (k % sources);
+        double scale  = 1.0 + (double) src;
+
+        truth[k].north = BENCH_RADIUS_M * cos(a);
+        truth[k].east  = BENCH_RADIUS_M * sin(a);
+        truth[k].hdg   = fmod(a * (180.0 / BENCH_PI) + 90.0, 360.0);
+
+        /* No draw at all without outliers, so the clean stream is unchanged */
+        if ((outliers > 0.0) && (bench_uniform() < outliers))
+        {
+            double b = 2.0 * BENCH_PI * bench_uniform();
+
+            jump_e = BENCH_OUTLIER_M * sin(b);
+            jump_n = BENCH_OUTLIER_M * cos(b);
+        }
+
+        /* Likewise no draw with one HDOP level */
+        if ((dops > 1) && (k % BENCH_DOP_HOLD == 0))
+        {
+            dop = BENCH_HDOP + BENCH_DOP_STEP * (double) (int) (bench_uniform() * dops);
+        }
+
+        /* Taken at t, stamped late by the receiver's latency */
+        fix[k].time   = t + (double) src * BENCH_LATENCY_S;
+        fix[k].source = (uint32_t) src;
+        enu2geodetic_fast(&centre,
+                truth[k].east  + jump_e + scale * dop * BENCH_POS_SIGMA_M * bench_gauss(),
+                truth[k].north + jump_n + scale * dop * BENCH_POS_SIGMA_M * bench_gauss(),
+                &fix[k].lat, &fix[k].lon);
+        north_east2speed_heading(vn + scale * BENCH_VEL_SIGMA * bench_gauss(),
+                                 ve + scale * BENCH_VEL_SIGMA * bench_gauss(),
+                                 &fix[k].vel, &fix[k].hdg);
+        fix[k].dop = dop;
+    }
+}
+
+/* Squared heading error, the short way round */
+static double bench_hdg_sq(double hdg, double ref)
+{
+    double d = fmod(fabs(hdg - ref), 360.0);
+
+    d = (d > 180.0) ? 360.0 - d : d;
+    return d * d;
+}
+
+/*
+** Recorded stream
+*/
+static GPS_KALMAN_Fix_t *bench_load(const char *path, long *n)
+{
+    FILE *fp = fopen(path, "r");
+    GPS_KALMAN_Fix_t *fix = NULL;
+    long cap = 0;
+    char line[256];
+
+    *n = 0;
+    if (fp == NULL)
+    {
+        perror(path);
+        return NULL;
+    }
+
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        GPS_KALMAN_Fix_t f;
+
+        if (sscanf(line, "%lf,%lf,%lf,%lf,%lf,%lf",
+                   &f.time, &f.lat, &f.lon, &f.vel, &f.hdg, &f.dop) != 6)
+        {
+            continue; /* header or comment */
+        }
+        f.source = 0;
+        if (*n == cap)
+        {
+            GPS_KALMAN_Fix_t *grown;
+
+            cap = (cap == 0) ? 4096 : cap * 2;
+            grown = (GPS_KALMAN_Fix_t *) realloc(fix, (size_t) cap * sizeof(*fix));
+            if (grown == NULL)
+            {
+                free(fix);
+                fclose(fp);
+                return NULL;
+            }
+            fix = grown;
+        }
+        fix[(*n)++] = f;
+    }
+
+    fclose(fp);
+    return fix;
+}
+
+/*
+** Estimates and the accuracy report
+*/
+static int bench_write(const char *path, const BenchOut_t *out, long n)
+{
+    FILE *fp = fopen(path, "w");
+    long k;
+
+    if (fp == NULL)
+    {
+        perror(path);
+        return -1;
+    }
+    for (k = 0; k < n; k++)
+    {
+        fprintf(fp, "%.3f,%.11f,%.11f,%.7f,%.7f\n",
+                out[k].time, out[k].lat, out[k].lon, out[k].vel, out[k].hdg);
+    }
+    return fclose(fp);
+}
+
+static BenchOut_t *bench_load_ref(const char *path, long *n)
+{
+    FILE *fp = fopen(path, "r");
+    BenchOut_t *ref = NULL;
+    long cap = 0;
+    char line[256];
+
+    *n = 0;
+    if (fp == NULL)
+    {
+        perror(path);
+        return NULL;
+    }
+
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        BenchOut_t r;
+
+        if (sscanf(line, "%lf,%lf,%lf,%lf,%lf",
+                   &r.time, &r.lat, &r.lon, &r.vel, &r.hdg) != 5)
+        {
+            continue;
+        }
+        if (*n == cap)
+        {
+            BenchOut_t *grown;
+
+            cap = (cap == 0) ? 4096 : cap * 2;
+            grown = (BenchOut_t *) realloc(ref, (size_t) cap * sizeof(*ref));
+            if (grown == NULL)
+            {
+                free(ref);
+                fclose(fp);
+                return NULL;
+            }
+            ref = grown;
+        }
+        ref[(*n)++] = r;
+    }
+
+    fclose(fp);
+    return ref;
+}
+
+static int bench_cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *) a;
+    double y = *(const double *) b;
+
+    return (x > y) - (x < y);
+}
+
+/* RMS, 95th percentile and maximum of d[0..n-1], which is sorted in place. Returns 1
+** if the maximum is over limit, when limit is not negative. */
+static int bench_report(const char *name, const char *unit, double *d, long n,
+                        double limit)
+{
+    double sq = 0.0;
+    long   k;
+    int    over;
+
+    if (n == 0)
+    {
+        printf("%-14s n/a\n", name);
+        return 0;
+    }
+    for (k = 0; k < n; k++)
+    {
+        sq += d[k] * d[k];
+    }
+    qsort(d, (size_t) n, sizeof(*d), bench_cmp_double);
+    over = (limit >= 0.0) && !(d[n - 1] <= limit);
+    printf("%-14s rms %.6f, p95 %.6f, max %.6f %s%s\n", name, sqrt(sq / n),
+           d[(long) (0.95 * (double) (n - 1))], d[n - 1], unit,
+           over ? ", OVER LIMIT" : "");
+    return over;
+}
+
+/* limit[] is the most position (m), speed (kph) and heading (deg) difference allowed,
+** each ignored if negative */
+static int bench_compare(const char *path, const BenchOut_t *out, long n,
+                         const double *limit)
+{
+    BenchOut_t *ref;
+    double     *d;
+    long n_ref;
+    long n_hdg = 0;
+    long k;
+    int  status = 0;
+
+    ref = bench_load_ref(path, &n_ref);
+    if ((ref == NULL) || (n_ref != n))
+    {
+        fprintf(stderr, "%s: %ld estimates, expected %ld\n", path, n_ref, n);
+        free(ref);
+        return -1;
+    }
+    d = (double *) malloc((size_t) n * sizeof(*d));
+    if (d == NULL)
+    {
+        free(ref);
+        return -1;
+    }
+
+    printf("reference      %s\n", path);
+    for (k = 0; k < n; k++)
+    {
+        GPS_KALMAN_EnuAnchor_t at;
+        double e;
+        double nn;
+
+        enu_anchor_set(&at, ref[k].lat, ref[k].lon);
+        geodetic2enu_fast(&at, out[k].lat, out[k].lon, &e, &nn);
+        d[k] = sqrt(e * e + nn * nn);
+    }
+    status |= bench_report("position diff", "m", d, n, limit[0]);
+
+    for (k = 0; k < n; k++)
+    {
+        d[k] = fabs(out[k].vel - ref[k].vel);
+    }
+    status |= bench_report("speed diff", "kph", d, n, limit[1]);
+
+    for (k = 0; k < n; k++)
+    {
+        double h = fmod(fabs(out[k].hdg - ref[k].hdg), 360.0);
+
+        if (ref[k].vel > BENCH_HDG_MIN_KPH)
+        {
+            d[n_hdg++] = (h > 180.0) ? 360.0 - h : h;
+        }
+    }
+    status |= bench_report("heading diff", "deg", d, n_hdg, limit[2]);
+
+    free(d);
+    free(ref);
+    return status;
+}
+
+/*
+** Fixed-lag smoother, run as GPS_KALMAN_RunFilter runs it
+*/
+static int bench_smooth(const GPS_KALMAN_Fix_t *fix, const BenchTruth_t *truth, long n,
+                        double rate, const GPS_KALMAN_Params_t *params, unsigned int lag)
+{
+    static GPS_KALMAN_Core_t   core;
+    static GPS_KALMAN_Smooth_t sm;
+    GPS_KALMAN_EnuAnchor_t centre;
+    double sq = 0.0;
+    long   n_sq = 0;
+    long   n_out = 0;
+    unsigned long long t0;
+    unsigned long long t1;
+    unsigned long allocs;
+    long   k;
+
+    GPS_KALMAN_Core_Init(&core);
+    GPS_KALMAN_Core_SetParams(&core, params);
+    if (GPS_KALMAN_Smooth_Init(&sm, lag) != GPS_KALMAN_FILTER_SUCCESS)
+    {
+        fprintf(stderr, "lag must be 0 to %d\n", GPS_KALMAN_SMOOTH_LAG);
+        return 2;
+    }
+    enu_anchor_set(&centre, BENCH_LAT0, BENCH_LON0);
+
+    allocs = g_Allocs;
+    g_CountAllocs = 1;
+    t0 = GPS_KALMAN_Stats_NowNs();
+    for (k = 0; k < n; k++)
+    {
+        int step = GPS_KALMAN_Core_Prepare(&core, &fix[k]);
+
+        if (step == GPS_KALMAN_CORE_SKIP)
+        {
+            continue;
+        }
+        if (step == GPS_KALMAN_FILTER_SUCCESS)
+        {
+            GPS_KALMAN_Core_Predict(&core);
+            GPS_KALMAN_Smooth_Predicted(&sm, &core);
+            GPS_KALMAN_Core_Update(&core);
+        }
+        if (GPS_KALMAN_Smooth_Filtered(&sm, &core))
+        {
+            long   i = (long) floor(sm.outTime * rate + 0.5);
+            double lat;
+            double lon;
+            double vel;
+            double hdg;
+            double e;
+            double nn;
+
+            n_out++;
+            if ((truth != NULL) && (i >= 100) && (i < n))
+            {
+                GPS_KALMAN_Smooth_Estimate(&sm, &lat, &lon, &vel, &hdg);
+                geodetic2enu_fast(&centre, lat, lon, &e, &nn);
+                sq += (e - truth[i].east) * (e - truth[i].east) +
+                      (nn - truth[i].north) * (nn - truth[i].north);
+                n_sq++;
+            }
+        }
+    }
+    t1 = GPS_KALMAN_Stats_NowNs();
+    g_CountAllocs = 0;
+
+    printf("smoother       lag %u, %ld estimates\n", lag, n_out);
+    printf("ns/smoothed    %.1f (filter included)\n", (double) (t1 - t0) / (double) n);
+    if (BENCH_HAVE_ALLOC_COUNT)
+    {
+        printf("allocations    %lu\n", g_Allocs - allocs);
+    }
+    if (n_sq > 0)
+    {
+        printf("rms pos error  %.3f m smoothed\n", sqrt(sq / n_sq));
+    }
+
+    return 0;
+}
+
+/*
+** Multi-track bank against the scalar filter, track by track
+*/
+static GPS_KALMAN_Bank_t g_Bank; /* too big for the stack */
+
+static int bench_bank(double gate)
+{
+    static GPS_KALMAN_Real_t x[BENCH_BANK_TRACKS][GPS_KALMAN_FILTER_LEN];
+    static GPS_KALMAN_Real_t P[BENCH_BANK_TRACKS][GPS_KALMAN_FILTER_SYM_LEN];
+    static GPS_KALMAN_Real_t z[BENCH_BANK_TRACKS][GPS_KALMAN_FILTER_LEN];
+    static GPS_KALMAN_Real_t r[BENCH_BANK_TRACKS][GPS_KALMAN_FILTER_LEN];
+    static int valid[BENCH_BANK_TRACKS];
+    GPS_KALMAN_Real_t F[GPS_KALMAN_FILTER_MAT_LEN];
+    GPS_KALMAN_Real_t Q[GPS_KALMAN_FILTER_SYM_LEN];
+    GPS_KALMAN_Real_t S[GPS_KALMAN_FILTER_SYM_LEN];
+    GPS_KALMAN_Real_t K[GPS_KALMAN_FILTER_MAT_LEN];
+    GPS_KALMAN_Real_t bx[GPS_KALMAN_FILTER_LEN];
+    GPS_KALMAN_Real_t bP[GPS_KALMAN_FILTER_SYM_LEN];
+    long   diffs = 0;
+    long   updates = 0;
+    long   gated = 0;
+    double d2;
+    int    status;
+    int    s;
+    int    t;
+    int    j;
+
+    /* Each track starts where its fixes do */
+    GPS_KALMAN_Bank_Init(&g_Bank, BENCH_BANK_TRACKS, 100.0);
+    for (t = 0; t < BENCH_BANK_TRACKS; t++)
+    {
+        GPS_KALMAN_Bank_GetTrack(&g_Bank, (unsigned int) t, x[t], P[t]);
+        x[t][GPS_KALMAN_STATE_N]  = GPS_KALMAN_D2R(10.0 * (double) t);
+        x[t][GPS_KALMAN_STATE_E]  = GPS_KALMAN_D2R(-10.0 * (double) t);
+        x[t][GPS_KALMAN_STATE_VN] = GPS_KALMAN_D2R(15.0);
+        x[t][GPS_KALMAN_STATE_VE] = GPS_KALMAN_D2R(-15.0);
+        GPS_KALMAN_Bank_SetTrack(&g_Bank, (unsigned int) t, x[t], P[t]);
+    }
+    GPS_KALMAN_Filter_CVModel(0.1, GPS_KALMAN_ACCEL_PSD, F, Q);
+
+    for (s = 0; s < BENCH_BANK_STEPS; s++)
+    {
+        /* Tracks of three noise levels, with a few missing fixes and outliers */
+        for (t = 0; t < BENCH_BANK_TRACKS; t++)
+        {
+            double scale = 1.0 + (double) (t % 3);
+            double pos   = 10.0 * (double) t + 1.5 * (double) s;
+            double jump  = ((s + t) % 53 == 0) ? BENCH_OUTLIER_M : 0.0;
+
+            z[t][GPS_KALMAN_STATE_N]  = GPS_KALMAN_D2R(pos + jump + scale * 3.0 * bench_gauss());
+            z[t][GPS_KALMAN_STATE_E]  = GPS_KALMAN_D2R(-pos + scale * 3.0 * bench_gauss());
+            z[t][GPS_KALMAN_STATE_VN] = GPS_KALMAN_D2R(15.0 + scale * 0.3 * bench_gauss());
+            z[t][GPS_KALMAN_STATE_VE] = GPS_KALMAN_D2R(-15.0 + scale * 0.3 * bench_gauss());
+            r[t][GPS_KALMAN_STATE_N]  = GPS_KALMAN_D2R(scale * scale * 9.0);
+            r[t][GPS_KALMAN_STATE_E]  = r[t][GPS_KALMAN_STATE_N];
+            r[t][GPS_KALMAN_STATE_VN] = GPS_KALMAN_D2R(scale * scale * 0.09);
+            r[t][GPS_KALMAN_STATE_VE] = r[t][GPS_KALMAN_STATE_VN];
+            valid[t] = ((s + t) % 7 != 0);
+
+            for (j = 0; j < GPS_KALMAN_FILTER_LEN; j++)
+            {
+                g_Bank.z[j][t] = z[t][j];
+                g_Bank.r[j][t] = r[t][j];
+            }
+            g_Bank.valid[t] = valid[t];
+        }
+
+        GPS_KALMAN_Bank_Predict(&g_Bank, F, Q);
+        GPS_KALMAN_Bank_Update(&g_Bank, gate);
+
+        for (t = 0; t < BENCH_BANK_TRACKS; t++)
+        {
+            GPS_KALMAN_Filter_Predict(F, Q, x[t], P[t]);
+            if (valid[t])
+            {
+                status = GPS_KALMAN_Filter_Update(z[t], r[t], x[t], P[t], S, K, gate, &d2);
+                updates++;
+                gated += (status == GPS_KALMAN_FILTER_ERR_GATED);
+
+                diffs += (status != g_Bank.status[t]) ||
+                         (d2 != GPS_KALMAN_R2D(g_Bank.d2[t]));
+                for (j = 0; j < GPS_KALMAN_FILTER_SYM_LEN; j++)
+                {
+                    diffs += (memcmp(&S[j], &g_Bank.S[j][t], sizeof(S[j])) != 0);
+                }
+                for (j = 0; j < GPS_KALMAN_FILTER_MAT_LEN; j++)
+                {
+                    diffs += (memcmp(&K[j], &g_Bank.K[j][t], sizeof(K[j])) != 0);
+                }
+            }
+
+            GPS_KALMAN_Bank_GetTrack(&g_Bank, (unsigned int) t, bx, bP);
+            diffs += (memcmp(bx, x[t], sizeof(bx)) != 0) + (memcmp(bP, P[t], sizeof(bP)) != 0);
+        }
+    }
+
+    printf("bank           %d tracks x %d steps, %ld updates, %ld gated, %s\n",
+           BENCH_BANK_TRACKS, BENCH_BANK_STEPS, updates, gated,
+           (diffs == 0) ? "identical to scalar" : "DIFFERENT");
+    if (diffs != 0)
+    {
+        fprintf(stderr, "bank: %ld differences from the scalar filter\n", diffs);
+        return 1;
+    }
+    return 0;
+}
+
+/*
+** Decimal minutes conversion
+*/
+static int bench_decimal_minutes(const GPS_KALMAN_Fix_t *fix, long n)
+{
+    size_t  m = 2 * (size_t) n;   /* lat/lon pairs */
+    double *dm  = (double *) malloc(m * sizeof(double));
+    double *deg = (double *) malloc(m * sizeof(double));
+    double *vec = (double *) malloc(m * sizeof(double));
+    long    reps = (BENCH_DM_VALUES + (long) m - 1) / (long) m;
+    double  err = 0.0;
+    unsigned long long t0;
+    unsigned long long t1;
+    unsigned long long t2;
+    long    r;
+    size_t  j;
+    int     status = 0;
+
+    if ((dm == NULL) || (deg == NULL) || (vec == NULL))
+    {
+        fprintf(stderr, "out of memory\n");
+        status = 1;
+        goto bench_decimal_minutes_exit;
+    }
+
+    /* The fixes back to DDDMM.mmmmm, as the receiver reports them */
+    for (j = 0; j < m; j++)
+    {
+        double d = (j & 1) ? fix[j / 2].lon : fix[j / 2].lat;
+        double whole = floor(fabs(d));
+
+        dm[j] = copysign(whole * 100.0 + (fabs(d) - whole) * 60.0, d);
+    }
+
+    t0 = GPS_KALMAN_Stats_NowNs();
+    for (r = 0; r < reps; r++)
+    {
+        for (j = 0; j < m; j++)
+        {
+            deg[j] = decimal_minutes2decimal_decimal(dm[j]);
+        }
+    }
+    t1 = GPS_KALMAN_Stats_NowNs();
+    for (r = 0; r < reps; r++)
+    {
+        decimal_minutes2decimal_decimal_n(dm, vec, m);
+    }
+    t2 = GPS_KALMAN_Stats_NowNs();
+
+    for (j = 0; j < m; j++)
+    {
+        double d = (j & 1) ? fix[j / 2].lon : fix[j / 2].lat;
+
+        err = (fabs(deg[j] - d) > err) ? fabs(deg[j] - d) : err;
+    }
+    if (memcmp(deg, vec, m * sizeof(double)) != 0)
+    {
+        fprintf(stderr, "decimal minutes: array and scalar conversions differ\n");
+        status = 1;
+    }
+
+    printf("dm2deg scalar  %.2f ns/value\n",
+           (double) (t1 - t0) / ((double) reps * (double) m));
+    printf("dm2deg array   %.2f ns/value, %.1fx%s\n",
+           (double) (t2 - t1) / ((double) reps * (double) m),
+           (double) (t1 - t0) / (double) (t2 - t1), (status == 0) ? "" : ", DIFFERENT");
+    printf("dm2deg error   %.3g deg max\n", err);
+
+bench_decimal_minutes_exit:
+    free(vec);
+    free(deg);
+    free(dm);
+    return status;
+}
+
+/*
+** Heading held while stopped: a vehicle turns, stops with headings of noise and moves
+** off again. While it is stopped the heading must stay put with the yaw rate back at
+** 0 and yawRateSigma0, and the heading variance must grow by yawAccelPsd * dt^3/3 a
+** fix; once it moves off the heading must follow it again.
+*/
+static int bench_held(const GPS_KALMAN_Params_t *params)
+{
+    GPS_KALMAN_Core_t core;
+    GPS_KALMAN_EnuAnchor_t centre;
+    GPS_KALMAN_Fix_t fix;
+    double rate0 = params->yawRateSigma0 * params->yawRateSigma0;
+    double north = 0.0;
+    double east  = 0.0;
+    double hdg   = 0.0;
+    double held  = 0.0;
+    double p00   = 0.0;
+    double pstop = 0.0;
+    double err   = 0.0;
+    int    bad   = 0;
+    int    k;
+
+    GPS_KALMAN_Core_Init(&core);
+    GPS_KALMAN_Core_SetParams(&core, params);
+    enu_anchor_set(&centre, BENCH_LAT0, BENCH_LON0);
+
+    for (k = 0; k < 3 * BENCH_HELD_FIXES; k++)
+    {
+        int stopped = (k >= BENCH_HELD_FIXES) && (k < 2 * BENCH_HELD_FIXES);
+        double speed = BENCH_HELD_SPEED;
+        double expect = 0.0;
+
+        /* Slowing down and speeding up over BENCH_HELD_RAMP fixes, not at once */
+        if (k < BENCH_HELD_FIXES)
+        {
+            speed *= fmin(1.0, (double) (BENCH_HELD_FIXES - k) / BENCH_HELD_RAMP);
+        }
+        else if (!stopped)
+        {
+            speed *= fmin(1.0, (double) (k - 2 * BENCH_HELD_FIXES + 1) / BENCH_HELD_RAMP);
+        }
+        if (!stopped)
+        {
+            hdg = fmod(hdg + BENCH_HELD_TURN, 360.0);
+            north += speed / 3.6 * cos(hdg * BENCH_PI / 180.0);
+            east  += speed / 3.6 * sin(hdg * BENCH_PI / 180.0);
+        }
+        fix.time   = (double) k;
+        fix.source = 0;
+        fix.dop    = BENCH_HDOP;
+        fix.vel    = stopped ? BENCH_HELD_CREEP : speed;
+        fix.hdg    = stopped ? 360.0 * bench_uniform() : hdg;
+        enu2geodetic_fast(&centre, east, north, &fix.lat, &fix.lon);
+
+        if (stopped)
+        {
+            expect = p00 + params->yawAccelPsd / 3.0; /* dt = 1 s */
+        }
+        (void) GPS_KALMAN_Core_Step(&core, &fix);
+
+        if (k == BENCH_HELD_FIXES - 1)
+        {
+            held  = core.hdg[GPS_KALMAN_HDG];
+            p00   = core.hdgP[0];
+            pstop = p00;
+        }
+        else if (stopped)
+        {
+            /* Bit for bit: held means nothing but the random walk touched it */
+            bad |= (core.hdgState != GPS_KALMAN_HDG_TRACKING) ||
+                   (core.hdg[GPS_KALMAN_HDG] != held) ||
+                   (core.hdg[GPS_KALMAN_HDG_RATE] != 0.0) ||
+                   (core.hdgP[1] != 0.0) || (core.hdgP[2] != rate0) ||
+                   (core.hdgP[0] != expect);
+            p00 = core.hdgP[0];
+        }
+        else if (k >= 2 * BENCH_HELD_FIXES + BENCH_HELD_SETTLE)
+        {
+            double d = sqrt(bench_hdg_sq(core.hdg[GPS_KALMAN_HDG], hdg));
+
+            err = (d > err) ? d : err;
+        }
+    }
+    bad |= (err > BENCH_HELD_MAX_DEG);
+
+    printf("held heading   %.2f deg over %d s stopped, variance %.1f to %.1f deg^2, "
+           "%.2f deg max error moving off, %s\n", held, BENCH_HELD_FIXES, pstop, p00,
+           err, bad ? "WRONG" : "as modelled");
+    return bad;
+}
+
+/*
+** Coasting, from the state after the last fix
+*/
+static void bench_coast(const GPS_KALMAN_Core_t *core)
+{
+    GPS_KALMAN_Real_t F[GPS_KALMAN_FILTER_MAT_LEN];
+    GPS_KALMAN_Real_t Q[GPS_KALMAN_FILTER_SYM_LEN];
+    GPS_KALMAN_Real_t x[GPS_KALMAN_FILTER_LEN];
+    GPS_KALMAN_Real_t P[GPS_KALMAN_FILTER_SYM_LEN];
+    double span = 2.0 * core->params.coastMaxSec;
+    double lat;
+    double lon;
+    double sigma_n;
+    double sigma_e;
+    double full_n;
+    double sum = 0.0;
+    long   stale = 0;
+    long   k;
+    unsigned long long t0;
+    unsigned long long t1;
+
+    t0 = GPS_KALMAN_Stats_NowNs();
+    for (k = 0; k < BENCH_COAST_STEPS; k++)
+    {
+        stale += (GPS_KALMAN_Core_Coast(core,
+                      core->lastFixTime + span * (double) k / BENCH_COAST_STEPS,
+                      &lat, &lon, &sigma_n, &sigma_e) == GPS_KALMAN_QUALITY_STALE);
+        sum += sigma_n;
+    }
+    t1 = GPS_KALMAN_Stats_NowNs();
+
+    /* The same error by F * P * F' + Q */
+    GPS_KALMAN_Core_Coast(core, core->lastFixTime + core->params.coastMaxSec,
+                          &lat, &lon, &sigma_n, &sigma_e);
+    memcpy(x, core->data.XHatData, sizeof(x));
+    memcpy(P, core->data.PMatrixData, sizeof(P));
+    GPS_KALMAN_Filter_CVModel(core->params.coastMaxSec, core->params.accelPsd, F, Q);
+    GPS_KALMAN_Filter_Predict(F, Q, x, P);
+    full_n = sqrt(GPS_KALMAN_R2D(P[GPS_KALMAN_SYM_IDX(GPS_KALMAN_STATE_N,
+                                                      GPS_KALMAN_STATE_N)]));
+
+    printf("ns/coast       %.1f (%ld of %d stale, mean sigma %.3f m)\n",
+           (double) (t1 - t0) / BENCH_COAST_STEPS, stale, BENCH_COAST_STEPS,
+           sum / BENCH_COAST_STEPS);
+    printf("coast sigma    %.4f m north at %g s, %.4f m by full prediction\n",
+           sigma_n, core->params.coastMaxSec, full_n);
+}
+
+int main(int argc, char *argv[])
+{
+    GPS_KALMAN_Core_t core;
+    GPS_KALMAN_Params_t params;
+    GPS_KALMAN_Fix_t *fix;
+    BenchTruth_t     *truth = NULL;
+    BenchOut_t       *out;
+    const char *path = NULL;
+    const char *wpath = NULL;
+    const char *cpath = NULL;
+    long   n = 1000000;
+    double rate = 10.0;
+    double outliers = 0.0;
+    double gate = -1.0;
+    double tol = -1.0;
+    double limit[3] = {-1.0, -1.0, -1.0}; /* -t, in bench_compare order */
+    int    sources = 1;
+    int    dops = 1;
+    long   lag = GPS_KALMAN_SMOOTH_LAG;
+    long   k;
+    long   counts[5] = {0, 0, 0, 0, 0}; /* restarts, skips, rejected, gated, steady */
+    double sq_filt = 0.0;
+    double sq_meas = 0.0;
+    double sq_hdg_filt = 0.0;
+    double sq_hdg_meas = 0.0;
+    long   n_err = 0;
+    unsigned long long t0;
+    unsigned long long t1;
+    int    i;
+    int    status = 0;
+
+    for (i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-n") == 0) && (i + 1 < argc))
+        {
+            n = atol(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-r") == 0) && (i + 1 < argc))
+        {
+            rate = atof(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-o") == 0) && (i + 1 < argc))
+        {
+            outliers = atof(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-g") == 0) && (i + 1 < argc))
+        {
+            gate = atof(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-s") == 0) && (i + 1 < argc))
+        {
+            sources = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-k") == 0) && (i + 1 < argc))
+        {
+            tol = atof(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-d") == 0) && (i + 1 < argc))
+        {
+            dops = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-l") == 0) && (i + 1 < argc))
+        {
+            lag = atol(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-f") == 0) && (i + 1 < argc))
+        {
+            path = argv[++i];
+        }
+        else if ((strcmp(argv[i], "-w") == 0) && (i + 1 < argc))
+        {
+            wpath = argv[++i];
+        }
+        else if ((strcmp(argv[i], "-c") == 0) && (i + 1 < argc))
+        {
+            cpath = argv[++i];
+        }
+        else if ((strcmp(argv[i], "-t") == 0) && (i + 1 < argc))
+        {
+            if (sscanf(argv[++i], "%lf,%lf,%lf", &limit[0], &limit[1], &limit[2]) < 1)
+            {
+                fprintf(stderr, "-t takes m[,kph[,deg]]\n");
+                return 2;
+            }
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-n fixes] [-r rate_hz] [-o outliers] [-g gate] "
+                    "[-s sources] [-l lag] [-k tol] [-d dops] [-f fixes.csv] [-w out.csv] "
+                    "[-c ref.csv [-t m[,kph[,deg]]]]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (path != NULL)
+    {
+        fix = bench_load(path, &n);
+    }
+    else
+    {
+        if ((n <= 0) || (rate <= 0.0))
+        {
+            fprintf(stderr, "fixes and rate must be positive\n");
+            return 2;
+        }
+        if ((sources < 1) || (sources > GPS_KALMAN_SOURCE_MAX))
+        {
+            fprintf(stderr, "sources must be 1 to %d\n", GPS_KALMAN_SOURCE_MAX);
+            return 2;
+        }
+        if (dops < 1)
+        {
+            fprintf(stderr, "dops must be positive\n");
+            return 2;
+        }
+        fix   = (GPS_KALMAN_Fix_t *) malloc((size_t) n * sizeof(*fix));
+        truth = (BenchTruth_t *) malloc((size_t) n * sizeof(*truth));
+        if ((fix != NULL) && (truth != NULL))
+        {
+            bench_synthetic(fix, truth, n, rate, outliers, sources, dops);
+        }
+    }
+    if ((fix == NULL) || (n == 0))
+    {
+        fprintf(stderr, "no fixes\n");
+        return 1;
+    }
+    out = (BenchOut_t *) malloc((size_t) n * sizeof(*out));
+    if (out == NULL)
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    GPS_KALMAN_Core_Init(&core);
+    GPS_KALMAN_Core_DefaultParams(&params);
+    if (gate >= 0.0)
+    {
+        params.gateChi2 = gate;
+    }
+    if (tol >= 0.0)
+    {
+        params.steadyGainTol = tol;
+    }
+    for (i = 1; i < sources; i++)
+    {
+        params.source[i].uereM       = params.source[0].uereM * (1.0 + (double) i);
+        params.source[i].velSigmaMps = params.source[0].velSigmaMps * (1.0 + (double) i);
+        params.source[i].latencySec  = (double) i * BENCH_LATENCY_S;
+    }
+    if (GPS_KALMAN_Core_CheckParams(&params) != NULL)
+    {
+        fprintf(stderr, "gate, steady gain or receiver parameters out of range\n");
+        return 2;
+    }
+    GPS_KALMAN_Core_SetParams(&core, &params);
+
+    g_CountAllocs = 1;
+    t0 = GPS_KALMAN_Stats_NowNs();
+    for (k = 0; k < n; k++)
+    {
+        int step = GPS_KALMAN_Core_Step(&core, &fix[k]);
+
+        counts[0] += (step == GPS_KALMAN_CORE_RESTART);
+        counts[1] += (step == GPS_KALMAN_CORE_SKIP);
+        counts[2] += (step == GPS_KALMAN_FILTER_ERR_NOT_PD);
+        counts[3] += (step == GPS_KALMAN_FILTER_ERR_GATED);
+        counts[4] += (step == GPS_KALMAN_FILTER_SUCCESS) && core.steadyStep;
+        GPS_KALMAN_Core_Estimate(&core, &out[k].lat, &out[k].lon,
+                                 &out[k].vel, &out[k].hdg);
+    }
+    t1 = GPS_KALMAN_Stats_NowNs();
+    g_CountAllocs = 0;
+
+#if (GPS_KALMAN_PRECISION == GPS_KALMAN_PRECISION_DOUBLE)
+    printf("precision      double\n");
+#elif (GPS_KALMAN_PRECISION == GPS_KALMAN_PRECISION_FLOAT)
+    printf("precision      float\n");
+#else
+    printf("precision      fixed Q%d.%d\n",
+           31 - GPS_KALMAN_FIXED_FRAC_BITS, GPS_KALMAN_FIXED_FRAC_BITS);
+#endif
+#if (GPS_KALMAN_UPDATE_FORM == GPS_KALMAN_UPDATE_FORM_JOINT)
+    printf("update         joint\n");
+#else
+    printf("update         sequential\n");
+#endif
+    printf("fixes          %ld%s\n", n, (path != NULL) ? "" : " (synthetic)");
+    printf("restarts       %ld\n", counts[0]);
+    printf("skipped        %ld\n", counts[1]);
+    printf("rejected       %ld\n", counts[2]);
+    printf("gated          %ld (gate %g)\n", counts[3], params.gateChi2);
+    printf("steady gain    %ld (tol %g)\n", counts[4], params.steadyGainTol);
+    printf("gain cache     %lu hits, %lu misses\n", (unsigned long) core.gainHits,
+           (unsigned long) core.gainMisses);
+    printf("total          %.3f ms\n", (double) (t1 - t0) * 1e-6);
+    printf("ns/update      %.1f\n", (double) (t1 - t0) / (double) n);
+    printf("updates/sec    %.0f\n", (double) n * 1e9 / (double) (t1 - t0));
+    if (BENCH_HAVE_ALLOC_COUNT)
+    {
+        printf("allocations    %lu\n", g_Allocs);
+    }
+    else
+    {
+        printf("allocations    n/a\n");
+    }
+
+    if (truth != NULL)
+    {
+        GPS_KALMAN_EnuAnchor_t centre;
+
+        /* Filtered and raw positions against the truth, after 100 fixes to converge */
+        enu_anchor_set(&centre, BENCH_LAT0, BENCH_LON0);
+        for (k = 100; k < n; k++)
+        {
+            double e;
+            double nn;
+
+            geodetic2enu_fast(&centre, out[k].lat, out[k].lon, &e, &nn);
+            sq_filt += (e - truth[k].east) * (e - truth[k].east) +
+                       (nn - truth[k].north) * (nn - truth[k].north);
+            geodetic2enu_fast(&centre, fix[k].lat, fix[k].lon, &e, &nn);
+            sq_meas += (e - truth[k].east) * (e - truth[k].east) +
+                       (nn - truth[k].north) * (nn - truth[k].north);
+            sq_hdg_filt += bench_hdg_sq(out[k].hdg, truth[k].hdg);
+            sq_hdg_meas += bench_hdg_sq(fix[k].hdg, truth[k].hdg);
+            n_err++;
+        }
+        if (n_err > 0)
+        {
+            printf("rms pos error  %.3f m filtered, %.3f m measured\n",
+                   sqrt(sq_filt / n_err), sqrt(sq_meas / n_err));
+            printf("rms hdg error  %.3f deg filtered, %.3f deg measured\n",
+                   sqrt(sq_hdg_filt / n_err), sqrt(sq_hdg_meas / n_err));
+        }
+    }
+
+    bench_coast(&core);
+
+    if ((lag != 0) &&
+        (bench_smooth(fix, truth, n, (path != NULL) ? 0.0 : rate, &params,
+                      (lag < 0) ? 0u : (unsigned int) lag) != 0))
+    {
+        status = 1;
+    }
+
+    for (k = 0; k < n; k++)
+    {
+        out[k].time = fix[k].time;
+    }
+    if ((wpath != NULL) && (bench_write(wpath, out, n) != 0))
+    {
+        status = 1;
+    }
+    if ((cpath != NULL) && (bench_compare(cpath, out, n, limit) != 0))
+    {
+        status = 1;
+    }
+    if (bench_decimal_minutes(fix, n) != 0)
+    {
+        status = 1;
+    }
+    if (bench_bank(params.gateChi2) != 0)
+    {
+        status = 1;
+    }
+    if (bench_held(&params) != 0)
+    {
+        status = 1;
+    }
+
+    free(out);
+    free(truth);
+    free(fix);
+    return status;
+}
+
+/*=======================================================================================
+** End of file gps_kalman_bench.c
+**=====================================================================================*/
@@ -0,0 +1,957 @@
+/*=======================================================================================
+** File Name:  gps_kalman_replay.c
+**
+** Title:  Offline log replay for the GPS_KALMAN filter
+**
+** $Author:    GPS_KALMAN Team
+** $Revision: 1.1 $
+** $Date:      2026-10-17
+**
+** Purpose:  This file reprocesses recorded receiver logs through the filter as fast
+**           as the host allows, with no scheduler pacing, and writes the filter output
+**           the app would have published for each fix. Several logs are treated as
+**           independent vehicles, each with its own filter, and spread over a pool of
+**           threads.
+**
+** Usage:
+**    gps_kalman_replay [-j threads] [-m mid] [-p params] [-c] [-o out] log...
+**
+**    log  either NMEA 0183 text, or the GpsInfoMsg_t software bus messages exactly as
+**         recorded, back to back. Text is assumed if the file starts with '$'.
+**    -j   worker threads for several logs (default one per online CPU)
+**    -m   with a message log, replay only messages with this stream ID (e.g. 0x0820);
+**         by default every message long enough to be a GpsInfoMsg_t is replayed
+**    -p   filter tuning instead of the platform defaults: a GPS_KALMAN_ParamTbl_t
+**         image, or key=value lines naming GPS_KALMAN_Params_t fields (accelPsd=0.5,
+**         source1.uereM=8, ...), the rest left at their defaults; '#' starts a comment
+**    -c   write CSV (time,lat,lon,kph,hdg) instead of GPS_KALMAN_OutData_t records
+**    -o   output file (default stdout)
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. Each fix goes through GPS_KALMAN_DecodeInfo, as in GPS_KALMAN_ProcessGpsInfo,
+**       then GPS_KALMAN_Core_Step and GPS_KALMAN_Core_Estimate, as in
+**       GPS_KALMAN_RunFilter. The cFE wrapper itself (events, perf IDs, diagnostic
+**       telemetry) is not run.
+**    2. A message's time stamp is its CCSDS secondary header time; an unstamped message
+**       falls back to the receiver UTC time instead of the time of receipt. NMEA text
+**       is stamped with the receiver UTC time.
+**    3. NMEA sentences are grouped into one fix per epoch: a GGA or RMC sentence with a
+**       new time field closes the previous epoch
+**    4. A message log must come from a host with the same byte order and structure
+**       layout, and a mission with a GPS_KALMAN_REPLAY_TLM_HDR_SIZE byte telemetry
+**       header. OutData records are written the same way, with a big endian CCSDS
+**       header stamped with the fix time.
+**    5. One record is written per good fix the filter accepts; repeated time stamps
+**       and bad fixes write nothing
+**    6. With several logs, the output is each log's records in command line order,
+**       byte for byte the same whatever the thread count or scheduling. Each log is
+**       one task, and workers take the tasks in command line order as they come free.
+**       A log's output goes to an anonymous temporary file until all earlier logs
+**       have been written, so memory use does not grow with the number or size of the
+**       logs. At most REPLAY_PENDING_PER_THREAD logs a thread are started ahead of
+**       the merge, and in all no more than REPLAY_MAX_PENDING or what the open file
+**       limit leaves, but never fewer than one a thread. A worker that would go
+**       further waits for the merge, so the open files stay bounded however many
+**       logs there are. A log whose output cannot be kept is reported by name and
+**       fails the run; the others are still written.
+**    7. -p tuning is range checked with GPS_KALMAN_Core_CheckParams, as the app checks
+**       its parameter table, and a log is not replayed with tuning the app would
+**       refuse. A file of exactly sizeof(GPS_KALMAN_ParamTbl_t) bytes with any byte
+**       that is not text is taken as a table image, from a host with the same layout.
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**   2026-10-17 | GPS_KALMAN Team | Build #: Code Started
+**   2026-10-17 | GPS_KALMAN Team | Count fixes outside the innovation gate
+**   2026-10-17 | GPS_KALMAN Team | Yaw rate in the output records
+**   2026-10-17 | GPS_KALMAN Team | Quality and position error in the output records
+**   2026-10-17 | GPS_KALMAN Team | Bounded logs ahead of the merge, in log order
+**   2026-10-17 | GPS_KALMAN Team | Tuning from a parameter file
+**
+**=====================================================================================*/
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "nmea/nmea.h"
+
+#include "gps_kalman_msgids.h"
+#include "gps_kalman_core.h"
+#include "gps_kalman_tbldefs.h"
+#include "gps_kalman_decode.h"
+#include "gps_kalman_stats.h"
+
+/* CFE_SB_TLM_HDR_SIZE of the mission the log was recorded on */
+#ifndef GPS_KALMAN_REPLAY_TLM_HDR_SIZE
+#define GPS_KALMAN_REPLAY_TLM_HDR_SIZE  (12)
+#endif
+
+#define REPLAY_CCSDS_PRI_SIZE   (6)
+#define REPLAY_NMEA_MAX         (128)     /* longest sentence kept, with CR LF */
+#define REPLAY_OUT_BUF          (1 << 20)
+#define REPLAY_MAX_THREADS      (256)
+#define REPLAY_PENDING_PER_THREAD (4)     /* logs started ahead of the merge, a thread */
+#define REPLAY_MAX_PENDING      (256)     /* and in all, but never fewer than threads */
+#define REPLAY_FD_RESERVE       (16)      /* descriptors left for stdio and the output */
+#define REPLAY_PARAM_LINE       (256)
+
+/* Same layout as GpsInfoMsg_t */
+typedef struct
+{
+    uint8_t  TlmHeader[GPS_KALMAN_REPLAY_TLM_HDR_SIZE];
+    nmeaINFO gpsInfo;
+} ReplayInfoMsg_t;
+
+/* Same layout as GPS_KALMAN_OutData_t */
+typedef struct
+{
+    uint8_t  ucTlmHeader[GPS_KALMAN_REPLAY_TLM_HDR_SIZE];
+    uint32_t uiCounter;
+    uint8_t  ucQuality;
+    uint8_t  ucSpare[3];
+    double   filterLat;
+    double   filterLon;
+    double   filterVel;
+    double   filterHdg;
+    double   filterYawRate;
+    double   filterSigmaN;
+    double   filterSigmaE;
+} ReplayOutData_t;
+
+/* Breaks the build if GPS_KALMAN_OutData_t has changed and this has not */
+typedef char ReplayOutDataLen_t[((sizeof(ReplayOutData_t) - GPS_KALMAN_REPLAY_TLM_HDR_SIZE >=
+                                  GPS_KALMAN_OUT_DATA_LEN) &&
+                                 (sizeof(ReplayOutData_t) - GPS_KALMAN_REPLAY_TLM_HDR_SIZE <
+                                  GPS_KALMAN_OUT_DATA_LEN + 8)) ? 1 : -1];
+
+/* A GPS_KALMAN_Params_t field that -p can set */
+typedef struct
+{
+    const char *name;
+    size_t      offset;
+    int         isCount;   /* uint32_t, else double */
+} ReplayParam_t;
+
+#define REPLAY_PARAM(type, field, isCount)  { #field, offsetof(type, field), isCount }
+
+static const ReplayParam_t g_ReplaySourceParams[] =
+{
+    REPLAY_PARAM(GPS_KALMAN_SourceParams_t, uereM,       0),
+    REPLAY_PARAM(GPS_KALMAN_SourceParams_t, velSigmaMps, 0),
+    REPLAY_PARAM(GPS_KALMAN_SourceParams_t, latencySec,  0),
+    { NULL, 0, 0 }
+};
+
+static const ReplayParam_t g_ReplayParams[] =
+{
+    REPLAY_PARAM(GPS_KALMAN_Params_t, accelPsd,          0),
+    REPLAY_PARAM(GPS_KALMAN_Params_t, initVarScale,      0),
+    REPLAY_PARAM(GPS_KALMAN_Params_t, dtQuantumSec,      0),
+    REPLAY_PARAM(GPS_KALMAN_Params_t, maxDtSec,          0),
+    REPLAY_PARAM(GPS_KALMAN_Params_t, enuMaxRangeM,      0),
+    REPLAY_PARAM(GPS_KALMAN_Params_t, gateChi2,          0),
+    REPLAY_PARAM(GPS_KALMAN_Params_t, gateMaxRejects,    1),
+    REPLAY_PARAM(GPS_KALMAN_Params_t, hdgMinSpeedKph,    0),
+    REPLAY_PARAM(GPS_KALMAN_Params_t, yawAccelPsd,       0),
+    REPLAY_PARAM(GPS_KALMAN_Params_t, yawRateSigma0,     0),
+    REPLAY_PARAM(GPS_KALMAN_Params_t, steadyGainTol,     0),
+    REPLAY_PARAM(GPS_KALMAN_Params_t, steadySettleFixes, 1),
+    REPLAY_PARAM(GPS_KALMAN_Params_t, coastMaxSec,       0),
+    REPLAY_PARAM(GPS_KALMAN_Params_t, resumeMaxSec,      0),
+    { NULL, 0, 0 }
+};
+
+typedef struct
+{
+    unsigned long   inputs;    /* messages, or NMEA sentences */
+    unsigned long   fixes;     /* epochs decoded */
+    unsigned long   bad;       /* fixes not good enough to filter */
+    unsigned long   restarts;
+    unsigned long   skipped;
+    unsigned long   rejected;
+    unsigned long   gated;     /* outside the innovation gate; the prediction is written */
+    unsigned long   written;
+} ReplayCounts_t;
+
+/* One log through one filter */
+typedef struct
+{
+    GPS_KALMAN_Core_t core;
+    const GPS_KALMAN_Params_t *params;
+    const char     *path;
+    FILE           *out;
+    int             csv;
+    ReplayOutData_t rec;
+    ReplayCounts_t  n;
+} Replay_t;
+
+/* A log's result, handed from its worker to the merge */
+typedef struct
+{
+    FILE           *out;       /* temporary file, rewound */
+    ReplayCounts_t  n;
+    int             status;
+    int             done;
+} ReplayTask_t;
+
+typedef struct
+{
+    char          **paths;
+    long            nPaths;
+    long            mid;
+    int             csv;
+    int             nWorkers;
+    GPS_KALMAN_Params_t params;
+    ReplayTask_t   *task;
+    long            next;      /* next task to take */
+    long            merged;    /* tasks the merge has written */
+    long            pending;   /* most tasks taken ahead of the merge */
+    pthread_mutex_t doneLock;  /* guards the above and task[].done */
+    pthread_cond_t  doneCond;  /* a task is done */
+    pthread_cond_t  mergeCond; /* the merge has moved on */
+} ReplayPool_t;
+
+typedef struct
+{
+    ReplayPool_t   *pool;
+    int             id;
+} ReplayWorker_t;
+
+/*
+** Helpers
+*/
+static unsigned replay_be16(const uint8_t *p)
+{
+    return ((unsigned) p[0] << 8) | (unsigned) p[1];
+}
+
+static void replay_put_be16(uint8_t *p, unsigned v)
+{
+    p[0] = (uint8_t) (v >> 8);
+    p[1] = (uint8_t) v;
+}
+
+/* CCSDS secondary header time, cFE layout: 32 bit seconds, 16 bit subseconds */
+static double replay_msg_time(const uint8_t *msg)
+{
+    const uint8_t *t = msg + REPLAY_CCSDS_PRI_SIZE;
+    uint32_t sec = ((uint32_t) replay_be16(t) << 16) | replay_be16(t + 2);
+
+    return (double) sec + (double) replay_be16(t + 4) * (1.0 / 65536.0);
+}
+
+static void replay_init_out(Replay_t *rp)
+{
+    memset((void*) &rp->rec, 0x00, sizeof(rp->rec));
+    replay_put_be16(rp->rec.ucTlmHeader, GPS_KALMAN_OUT_DATA_MID);
+    replay_put_be16(rp->rec.ucTlmHeader + 4,
+                    (unsigned) (sizeof(rp->rec) - REPLAY_CCSDS_PRI_SIZE - 1));
+}
+
+/* Write the current estimate for a fix at time t */
+static void replay_write(Replay_t *rp, double t)
+{
+    ReplayOutData_t *rec = &rp->rec;
+    uint8_t *hdr = rec->ucTlmHeader;
+    uint32_t sec = (uint32_t) t;
+
+    GPS_KALMAN_Core_Estimate(&rp->core, &rec->filterLat, &rec->filterLon,
+                             &rec->filterVel, &rec->filterHdg);
+    if (!GPS_KALMAN_Core_Heading(&rp->core, &rec->filterHdg, &rec->filterYawRate))
+    {
+        rec->filterYawRate = 0.0;
+    }
+    rec->ucQuality = (uint8_t) GPS_KALMAN_Core_Coast(&rp->core, rp->core.lastFixTime,
+            &rec->filterLat, &rec->filterLon, &rec->filterSigmaN, &rec->filterSigmaE);
+    rec->uiCounter++;
+    rp->n.written++;
+
+    if (rp->csv)
+    {
+        fprintf(rp->out, "%.2f,%.9f,%.9f,%.3f,%.3f\n", t, rec->filterLat,
+                rec->filterLon, rec->filterVel, rec->filterHdg);
+        return;
+    }
+
+    replay_put_be16(hdr + 2, 0xC000 | (rec->uiCounter & 0x3FFF));
+    replay_put_be16(hdr + 6, sec >> 16);
+    replay_put_be16(hdr + 8, sec & 0xFFFF);
+    replay_put_be16(hdr + 10, (unsigned) ((t - (double) sec) * 65536.0));
+    fwrite(rec, sizeof(*rec), 1, rp->out);
+}
+
+/* One decoded epoch through the filter */
+static void replay_fix(Replay_t *rp, const nmeaINFO *info, double t)
+{
+    GPS_KALMAN_Fix_t fix;
+    int status;
+
+    rp->n.fixes++;
+    if (!GPS_KALMAN_DecodeInfo(info, &fix))
+    {
+        rp->n.bad++;
+        return;
+    }
+    fix.time   = t;
+    fix.source = 0; /* one receiver per replay */
+
+    status = GPS_KALMAN_Core_Step(&rp->core, &fix);
+    if (status == GPS_KALMAN_CORE_SKIP)
+    {
+        rp->n.skipped++;
+        return;
+    }
+    rp->n.restarts += (status == GPS_KALMAN_CORE_RESTART);
+    rp->n.rejected += (status == GPS_KALMAN_FILTER_ERR_NOT_PD);
+    rp->n.gated    += (status == GPS_KALMAN_FILTER_ERR_GATED);
+    replay_write(rp, t);
+}
+
+/*
+** Software bus message log
+*/
+static int replay_messages(Replay_t *rp, const uint8_t *buf, size_t size, long mid)
+{
+    size_t need = offsetof(ReplayInfoMsg_t, gpsInfo) + sizeof(nmeaINFO);
+    size_t off = 0;
+    nmeaINFO info;
+
+    while (off + REPLAY_CCSDS_PRI_SIZE <= size)
+    {
+        const uint8_t *msg = buf + off;
+        size_t len = (size_t) replay_be16(msg + 4) + REPLAY_CCSDS_PRI_SIZE + 1;
+
+        if (off + len > size)
+        {
+            fprintf(stderr, "%s: truncated message at offset %lu\n", rp->path,
+                    (unsigned long) off);
+            return 1;
+        }
+        off += len;
+
+        if ((len < need) || ((mid >= 0) && ((long) replay_be16(msg) != mid)))
+        {
+            continue;
+        }
+        rp->n.inputs++;
+
+        /* messages are packed back to back, so copy out to align */
+        memcpy((void*) &info, msg + offsetof(ReplayInfoMsg_t, gpsInfo), sizeof(info));
+        {
+            double t = replay_msg_time(msg);
+
+            replay_fix(rp, &info, (t != 0.0) ? t : GPS_KALMAN_DecodeUtc(&info));
+        }
+    }
+    return 0;
+}
+
+/*
+** NMEA text log
+*/
+
+/* Time field of a GGA or RMC sentence, or NULL for other sentences */
+static const char *replay_epoch_field(const char *s, size_t len, size_t *flen)
+{
+    const char *end;
+
+    if ((len < 8) || (s[6] != ',') ||
+        ((memcmp(s + 3, "GGA", 3) != 0) && (memcmp(s + 3, "RMC", 3) != 0)))
+    {
+        return NULL;
+    }
+    end = (const char *) memchr(s + 7, ',', len - 7);
+    *flen = (end != NULL) ? (size_t) (end - (s + 7)) : 0;
+    return s + 7;
+}
+
+static int replay_nmea(Replay_t *rp, const char *buf, size_t size)
+{
+    nmeaPARSER parser;
+    nmeaINFO info;
+    char line[REPLAY_NMEA_MAX];
+    char epoch[16];
+    size_t epochLen = 0;
+    int pending = 0;
+    size_t off = 0;
+
+    nmea_zero_INFO(&info);
+    if (!nmea_parser_init(&parser))
+    {
+        fprintf(stderr, "%s: NMEA parser init failed\n", rp->path);
+        return 1;
+    }
+
+    while (off < size)
+    {
+        const char *s = buf + off;
+        const char *nl = (const char *) memchr(s, '\n', size - off);
+        size_t len = (nl != NULL) ? (size_t) (nl - s) : size - off;
+        const char *tf;
+        size_t tlen = 0;
+
+        off += len + 1;
+        if ((len > 0) && (s[len - 1] == '\r'))
+        {
+            len--;
+        }
+        if ((len == 0) || (s[0] != '$') || (len + 2 > sizeof(line)))
+        {
+            continue;
+        }
+
+        /* A new time closes the epoch the receiver state holds */
+        tf = replay_epoch_field(s, len, &tlen);
+        if ((tf != NULL) && (tlen > 0) && (tlen <= sizeof(epoch)) &&
+            ((tlen != epochLen) || (memcmp(tf, epoch, tlen) != 0)))
+        {
+            if (pending)
+            {
+                replay_fix(rp, &info, GPS_KALMAN_DecodeUtc(&info));
+            }
+            memcpy(epoch, tf, tlen);
+            epochLen = tlen;
+            pending = 1;
+        }
+
+        /* libnmea wants the CR LF terminator */
+        memcpy(line, s, len);
+        line[len]     = '\r';
+        line[len + 1] = '\n';
+        rp->n.inputs += (unsigned long) nmea_parse(&parser, line, (int) (len + 2), &info);
+    }
+    if (pending)
+    {
+        replay_fix(rp, &info, GPS_KALMAN_DecodeUtc(&info));
+    }
+
+    nmea_parser_destroy(&parser);
+    return 0;
+}
+
+/* Replay one log to rp->out with a fresh filter */
+static int replay_file(Replay_t *rp, const char *path, long mid)
+{
+    struct stat st;
+    void  *map;
+    int    fd;
+    int    iStatus;
+
+    GPS_KALMAN_Core_Init(&rp->core);
+    GPS_KALMAN_Core_SetParams(&rp->core, rp->params);
+    replay_init_out(rp);
+    memset((void*) &rp->n, 0x00, sizeof(rp->n));
+    rp->path = path;
+
+    fd = open(path, O_RDONLY);
+    if ((fd < 0) || (fstat(fd, &st) != 0))
+    {
+        perror(path);
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        return 1;
+    }
+    if (st.st_size == 0)
+    {
+        close(fd);
+        return 0;
+    }
+    map = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        perror(path);
+        return 1;
+    }
+    posix_madvise(map, (size_t) st.st_size, POSIX_MADV_SEQUENTIAL);
+
+    if (((const char *) map)[0] == '$')
+    {
+        iStatus = replay_nmea(rp, (const char *) map, (size_t) st.st_size);
+    }
+    else
+    {
+        iStatus = replay_messages(rp, (const uint8_t *) map, (size_t) st.st_size, mid);
+    }
+
+    munmap(map, (size_t) st.st_size);
+    return iStatus;
+}
+
+/*
+** Tuning
+*/
+
+/* Strip leading and trailing white space in place */
+static char *replay_trim(char *s)
+{
+    char *e;
+
+    while (isspace((unsigned char) *s))
+    {
+        s++;
+    }
+    e = s + strlen(s);
+    while ((e > s) && isspace((unsigned char) e[-1]))
+    {
+        *--e = '\0';
+    }
+    return s;
+}
+
+/* Set the field key names to value; 0 if there is no such field or value does not fit */
+static int replay_set_param(GPS_KALMAN_Params_t *params, const char *key, const char *value)
+{
+    const ReplayParam_t *field = g_ReplayParams;
+    char  *base = (char *) params;
+    char  *end;
+    double v;
+
+    if (strncmp(key, "source", 6) == 0)
+    {
+        unsigned long i = strtoul(key + 6, &end, 10);
+
+        if ((end == key + 6) || (*end != '.') || (i >= GPS_KALMAN_SOURCE_MAX))
+        {
+            return 0;
+        }
+        base += offsetof(GPS_KALMAN_Params_t, source) + i * sizeof(params->source[0]);
+        field = g_ReplaySourceParams;
+        key = end + 1;
+    }
+    while ((field->name != NULL) && (strcmp(field->name, key) != 0))
+    {
+        field++;
+    }
+
+    v = strtod(value, &end);
+    if ((field->name == NULL) || (end == value) || (*end != '\0'))
+    {
+        return 0;
+    }
+    if (field->isCount)
+    {
+        if (!((v >= 0.0) && (v <= 4294967295.0) && (v == (double) (uint32_t) v)))
+        {
+            return 0;
+        }
+        *(uint32_t *) (void *) (base + field->offset) = (uint32_t) v;
+    }
+    else
+    {
+        *(double *) (void *) (base + field->offset) = v;
+    }
+    return 1;
+}
+
+/* Read a -p file over params: a table image, or key=value lines */
+static int replay_load_params(GPS_KALMAN_Params_t *params, const char *path)
+{
+    GPS_KALMAN_ParamTbl_t image;
+    char   line[REPLAY_PARAM_LINE];
+    FILE  *fp;
+    size_t n;
+    size_t i;
+    long   lineNo = 0;
+    int    iStatus = 0;
+
+    fp = fopen(path, "rb");
+    if (fp == NULL)
+    {
+        perror(path);
+        return 1;
+    }
+
+    n = fread((void*) &image, 1, sizeof(image), fp);
+    if ((n == sizeof(image)) && (fgetc(fp) == EOF))
+    {
+        const unsigned char *b = (const unsigned char *) &image;
+
+        for (i = 0; (i < n) && (isprint(b[i]) || isspace(b[i])); i++)
+        {
+        }
+        if (i < n)
+        {
+            memcpy((void*) params, (const void*) &image, sizeof(*params));
+            fclose(fp);
+            return 0;
+        }
+    }
+    rewind(fp);
+
+    while ((iStatus == 0) && (fgets(line, sizeof(line), fp) != NULL))
+    {
+        char *key;
+        char *eq;
+
+        lineNo++;
+        if ((strchr(line, '\n') == NULL) && !feof(fp))
+        {
+            fprintf(stderr, "%s:%ld: line too long\n", path, lineNo);
+            iStatus = 1;
+            break;
+        }
+        if ((eq = strchr(line, '#')) != NULL)
+        {
+            *eq = '\0';
+        }
+        key = replay_trim(line);
+        if (*key == '\0')
+        {
+            continue;
+        }
+        eq = strchr(key, '=');
+        if (eq != NULL)
+        {
+            *eq = '\0';
+        }
+        if ((eq == NULL) ||
+            !replay_set_param(params, replay_trim(key), replay_trim(eq + 1)))
+        {
+            fprintf(stderr, "%s:%ld: not a parameter=value: %s\n", path, lineNo, key);
+            iStatus = 1;
+        }
+    }
+    if (ferror(fp))
+    {
+        perror(path);
+        iStatus = 1;
+    }
+    fclose(fp);
+    return iStatus;
+}
+
+/*
+** Batch of logs
+*/
+
+/* Next task in log order, waiting while it is too far ahead of the merge */
+static long replay_take(ReplayPool_t *pool)
+{
+    long task = -1;
+
+    pthread_mutex_lock(&pool->doneLock);
+    while ((pool->next < pool->nPaths) && (pool->next >= pool->merged + pool->pending))
+    {
+        pthread_cond_wait(&pool->mergeCond, &pool->doneLock);
+    }
+    if (pool->next < pool->nPaths)
+    {
+        task = pool->next++;
+    }
+    pthread_mutex_unlock(&pool->doneLock);
+
+    return task;
+}
+
+static void *replay_worker(void *arg)
+{
+    ReplayWorker_t *self = (ReplayWorker_t *) arg;
+    ReplayPool_t *pool = self->pool;
+    Replay_t *rp = (Replay_t *) calloc(1, sizeof(*rp));
+    long k;
+
+    while ((k = replay_take(pool)) >= 0)
+    {
+        ReplayTask_t *task = &pool->task[k];
+
+        task->out = (rp != NULL) ? tmpfile() : NULL;
+        if (task->out == NULL)
+        {
+            fprintf(stderr, "%s: not replayed, no room for its output: %s\n",
+                    pool->paths[k], strerror(errno));
+            task->status = 1;
+        }
+        else
+        {
+            setvbuf(task->out, NULL, _IOFBF, REPLAY_OUT_BUF);
+            rp->out = task->out;
+            rp->csv = pool->csv;
+            rp->params = &pool->params;
+            task->status = replay_file(rp, pool->paths[k], pool->mid);
+            task->n = rp->n;
+            if ((fflush(task->out) != 0) || ferror(task->out))
+            {
+                perror(pool->paths[k]);
+                task->status = 1;
+            }
+            rewind(task->out);
+        }
+
+        pthread_mutex_lock(&pool->doneLock);
+        task->done = 1;
+        pthread_cond_signal(&pool->doneCond);
+        pthread_mutex_unlock(&pool->doneLock);
+    }
+
+    free(rp);
+    return NULL;
+}
+
+/* Replay every log on nWorkers threads, appending the outputs to out in order */
+static int replay_batch(ReplayPool_t *pool, FILE *out, ReplayCounts_t *total)
+{
+    static ReplayWorker_t worker[REPLAY_MAX_THREADS];
+    pthread_t thread[REPLAY_MAX_THREADS];
+    int   created[REPLAY_MAX_THREADS];
+    char *copyBuf = (char *) malloc(REPLAY_OUT_BUF);
+    struct rlimit lim;
+    int   started = 0;
+    int   iStatus = 0;
+    long  failed = 0;
+    long  k;
+    int   w;
+
+    pool->task = (ReplayTask_t *) calloc((size_t) pool->nPaths, sizeof(*pool->task));
+    if ((pool->task == NULL) || (copyBuf == NULL))
+    {
+        fprintf(stderr, "out of memory\n");
+        free(copyBuf);
+        return 1;
+    }
+    pthread_mutex_init(&pool->doneLock, NULL);
+    pthread_cond_init(&pool->doneCond, NULL);
+    pthread_cond_init(&pool->mergeCond, NULL);
+
+    /* Tasks are taken in log order, so the one the merge waits for has always been
+    ** taken while at least one worker per task is let ahead of it */
+    pool->next    = 0;
+    pool->merged  = 0;
+    pool->pending = (long) pool->nWorkers * REPLAY_PENDING_PER_THREAD;
+    pool->pending = (pool->pending > REPLAY_MAX_PENDING) ? REPLAY_MAX_PENDING : pool->pending;
+    if ((getrlimit(RLIMIT_NOFILE, &lim) == 0) && (lim.rlim_cur != RLIM_INFINITY) &&
+        ((rlim_t) (pool->pending + pool->nWorkers + REPLAY_FD_RESERVE) > lim.rlim_cur))
+    {
+        pool->pending = (long) lim.rlim_cur - pool->nWorkers - REPLAY_FD_RESERVE;
+    }
+    pool->pending = (pool->pending < pool->nWorkers) ? pool->nWorkers : pool->pending;
+
+    for (w = 0; w < pool->nWorkers; w++)
+    {
+        worker[w].pool = pool;
+        worker[w].id = w;
+        created[w] = (pthread_create(&thread[w], NULL, replay_worker, &worker[w]) == 0);
+        started += created[w];
+    }
+    if (started == 0)
+    {
+        /* no threads to be had: do it all here, with nothing held back for the merge */
+        pool->pending = pool->nPaths;
+        replay_worker(&worker[0]);
+    }
+
+    /* Merge in log order as each log completes */
+    for (k = 0; k < pool->nPaths; k++)
+    {
+        ReplayTask_t *task = &pool->task[k];
+        size_t len;
+
+        pthread_mutex_lock(&pool->doneLock);
+        while (!task->done)
+        {
+            pthread_cond_wait(&pool->doneCond, &pool->doneLock);
+        }
+        pthread_mutex_unlock(&pool->doneLock);
+
+        if (task->out != NULL)
+        {
+            while ((len = fread(copyBuf, 1, REPLAY_OUT_BUF, task->out)) > 0)
+            {
+                fwrite(copyBuf, 1, len, out);
+            }
+            fclose(task->out);
+            task->out = NULL;
+        }
+
+        pthread_mutex_lock(&pool->doneLock);
+        pool->merged = k + 1;
+        pthread_cond_broadcast(&pool->mergeCond);
+        pthread_mutex_unlock(&pool->doneLock);
+
+        failed  += (task->status != 0);
+        iStatus |= task->status;
+        total->inputs   += task->n.inputs;
+        total->fixes    += task->n.fixes;
+        total->bad      += task->n.bad;
+        total->restarts += task->n.restarts;
+        total->skipped  += task->n.skipped;
+        total->rejected += task->n.rejected;
+        total->gated    += task->n.gated;
+        total->written  += task->n.written;
+    }
+
+    for (w = 0; w < pool->nWorkers; w++)
+    {
+        if (created[w])
+        {
+            pthread_join(thread[w], NULL);
+        }
+    }
+    if (failed > 0)
+    {
+        fprintf(stderr, "%ld of %ld logs failed\n", failed, pool->nPaths);
+    }
+    pthread_cond_destroy(&pool->mergeCond);
+    pthread_cond_destroy(&pool->doneCond);
+    pthread_mutex_destroy(&pool->doneLock);
+    free(pool->task);
+    free(copyBuf);
+    return iStatus;
+}
+
+int main(int argc, char *argv[])
+{
+    static Replay_t rp;
+    static ReplayPool_t pool;
+    ReplayCounts_t total;
+    const char *outPath = NULL;
+    const char *paramPath = NULL;
+    const char *bad;
+    FILE  *out;
+    long   threads = 0;
+    int    i;
+    int    iStatus;
+    unsigned long long t0;
+    unsigned long long t1;
+    double sec;
+
+    pool.mid = -1;
+    GPS_KALMAN_Core_DefaultParams(&pool.params);
+    for (i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-m") == 0) && (i + 1 < argc))
+        {
+            pool.mid = strtol(argv[++i], NULL, 0);
+        }
+        else if ((strcmp(argv[i], "-j") == 0) && (i + 1 < argc))
+        {
+            threads = atol(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-p") == 0) && (i + 1 < argc))
+        {
+            paramPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "-c") == 0)
+        {
+            pool.csv = 1;
+        }
+        else if ((strcmp(argv[i], "-o") == 0) && (i + 1 < argc))
+        {
+            outPath = argv[++i];
+        }
+        else if (argv[i][0] != '-')
+        {
+            break;
+        }
+        else
+        {
+            argc = i;
+            break;
+        }
+    }
+    pool.paths  = &argv[i];
+    pool.nPaths = argc - i;
+    if (pool.nPaths <= 0)
+    {
+        fprintf(stderr, "usage: %s [-j threads] [-m mid] [-p params] [-c] [-o out] log...\n",
+                argv[0]);
+        return 2;
+    }
+
+    if (paramPath != NULL)
+    {
+        if (replay_load_params(&pool.params, paramPath) != 0)
+        {
+            return 2;
+        }
+        bad = GPS_KALMAN_Core_CheckParams(&pool.params);
+        if (bad != NULL)
+        {
+            fprintf(stderr, "%s: %s out of range\n", paramPath, bad);
+            return 2;
+        }
+    }
+
+    out = (outPath != NULL) ? fopen(outPath, pool.csv ? "w" : "wb") : stdout;
+    if (out == NULL)
+    {
+        perror(outPath);
+        return 1;
+    }
+    setvbuf(out, NULL, _IOFBF, REPLAY_OUT_BUF);
+
+    if (threads <= 0)
+    {
+        threads = sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    threads = (threads > pool.nPaths) ? pool.nPaths : threads;
+    threads = (threads > REPLAY_MAX_THREADS) ? REPLAY_MAX_THREADS : threads;
+    threads = (threads < 1) ? 1 : threads;
+    pool.nWorkers = (int) threads;
+    memset((void*) &total, 0x00, sizeof(total));
+
+    t0 = GPS_KALMAN_Stats_NowNs();
+    if (pool.nPaths == 1)
+    {
+        /* one log streams straight to the output */
+        rp.out = out;
+        rp.csv = pool.csv;
+        rp.params = &pool.params;
+        iStatus = replay_file(&rp, pool.paths[0], pool.mid);
+        total = rp.n;
+    }
+    else
+    {
+        iStatus = replay_batch(&pool, out, &total);
+    }
+    if ((fflush(out) != 0) || ferror(out))
+    {
+        perror((outPath != NULL) ? outPath : "stdout");
+        iStatus = 1;
+    }
+    t1 = GPS_KALMAN_Stats_NowNs();
+
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+
+    sec = (double) (t1 - t0) * 1e-9;
+    fprintf(stderr, "logs           %ld on %d thread%s\n", pool.nPaths, pool.nWorkers,
+            (pool.nWorkers == 1) ? "" : "s");
+    fprintf(stderr, "inputs         %lu\n", total.inputs);
+    fprintf(stderr, "fixes          %lu (%lu bad)\n", total.fixes, total.bad);
+    fprintf(stderr, "restarts       %lu\n", total.restarts);
+    fprintf(stderr, "skipped        %lu\n", total.skipped);
+    fprintf(stderr, "rejected       %lu\n", total.rejected);
+    fprintf(stderr, "gated          %lu\n", total.gated);
+    fprintf(stderr, "written        %lu\n", total.written);
+    fprintf(stderr, "elapsed        %.3f s\n", sec);
+    if (sec > 0.0)
+    {
+        fprintf(stderr, "fixes/min      %.0f\n", (double) total.fixes * 60.0 / sec);
+    }
+    return iStatus;
+}
+
+/*=======================================================================================
+** End of file gps_kalman_replay.c
+**=====================================================================================*/
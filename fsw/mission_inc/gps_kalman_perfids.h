@@ -21,6 +21,12 @@
 #define _GPS_KALMAN_PERFIDS_H_
 
 #define GPS_KALMAN_MAIN_TASK_PERF_ID            50
+#define GPS_KALMAN_RUN_FILTER_PERF_ID           51
+#define GPS_KALMAN_PROCESS_CMDS_PERF_ID         52
+#define GPS_KALMAN_PROCESS_DATA_PERF_ID         53
+#define GPS_KALMAN_PREDICT_PERF_ID              54
+#define GPS_KALMAN_UPDATE_PERF_ID               55
+#define GPS_KALMAN_SEND_OUT_PERF_ID             56
 
     
 
@@ -15,6 +15,8 @@
 **   ---------------------------
 **   2019-06-28 | Jacob Killelea | Build #: Code Started
 **   2019-06-28 | Jacob Killelea | Msg ids made (hopefully) unique
+**   2026-10-17 | GPS_KALMAN Team | Smoothed output data
+**   2026-10-17 | GPS_KALMAN Team | Output data length for tools without cFE
 **
 **=====================================================================================*/
     
@@ -26,8 +28,15 @@
 #define GPS_KALMAN_SEND_HK_MID        	0x18E1
 #define GPS_KALMAN_WAKEUP_MID        	0x18F0
 #define GPS_KALMAN_OUT_DATA_MID        	0x18F1
+#define GPS_KALMAN_SMOOTH_DATA_MID     	0x18F2
 
 #define GPS_KALMAN_HK_TLM_MID		0x08CC
+#define GPS_KALMAN_DIAG_TLM_MID		0x08CD
+
+/* Bytes of GPS_KALMAN_OutData_t after its telemetry header, alignment padding aside:
+** the counter, quality and spares, then 7 doubles. Ground tools that cannot include
+** cFE declare the same record, and they and the app check their layout against this. */
+#define GPS_KALMAN_OUT_DATA_LEN         (4 + 4 + 7 * 8)
 
     
 
@@ -14,6 +14,15 @@
 **   Date | Author | Description
 **   ---------------------------
 **   2019-06-28 | Jacob Killelea | Build #: Code Started
+**   2026-10-17 | GPS_KALMAN Team | Filter tuning moved to the parameter table
+**   2026-10-17 | GPS_KALMAN Team | Filter state checkpoint in the CDS
+**   2026-10-17 | GPS_KALMAN Team | Innovation gate
+**   2026-10-17 | GPS_KALMAN Team | Several receivers fused into the one filter
+**   2026-10-17 | GPS_KALMAN Team | Fixed-lag smoother
+**   2026-10-17 | GPS_KALMAN Team | Heading and yaw rate filter
+**   2026-10-17 | GPS_KALMAN Team | Steady-state gain
+**   2026-10-17 | GPS_KALMAN Team | Steady-state gain cache
+**   2026-10-17 | GPS_KALMAN Team | Coast time limit
 **
 **=====================================================================================*/
     
@@ -27,6 +36,146 @@
 #define GPS_KALMAN_CMD_PIPE_DEPTH  10
 #define GPS_KALMAN_TLM_PIPE_DEPTH  20
 
+/*
+** Filter parameter table. It is loaded from GPS_KALMAN_PARAM_TBL_FILENAME at startup,
+** and a new load is applied at the next wakeup without resetting the filter.
+*/
+#define GPS_KALMAN_PARAM_TBL_NAME      "ParamTbl"
+#define GPS_KALMAN_PARAM_TBL_FILENAME  "/cf/gps_kalman_prm.tbl"
+
+/*
+** Filter state checkpoint in the Critical Data Store. A changed state is written at
+** most once every GPS_KALMAN_CDS_SAVE_PERIOD wakeups, and when the app exits. After
+** a processor reset or app restart the filter resumes from it, provided the first fix
+** is within the parameter table's resumeMaxSec of the checkpoint. A reset usually
+** takes longer than maxDtSec, so the state and covariance are carried over the
+** outage by the motion model instead of restarting. GPS_KALMAN_RESUME_MAX_SEC is the
+** parameter table default, and at least GPS_KALMAN_MAX_DT_SEC.
+*/
+#define GPS_KALMAN_CDS_NAME         "FilterState"
+#define GPS_KALMAN_CDS_SAVE_PERIOD  10
+#define GPS_KALMAN_RESUME_MAX_SEC   300.0
+
+/*
+** Receivers. Each message ID of GPS_KALMAN_SOURCE_MIDS carries a GpsInfoMsg_t from one
+** receiver, and every fix of every receiver updates the one filter in time order. The
+** parameter table has a noise model and latency per receiver, in the order of this
+** list, for up to GPS_KALMAN_SOURCE_MAX receivers; housekeeping counts fixes per
+** receiver the same way.
+*/
+#define GPS_KALMAN_SOURCE_MAX      3
+#define GPS_KALMAN_SOURCE_MIDS     { GPS_READER_GPS_INFO_MSG }
+
+/*
+** Fixed-lag smoother. After every fix the estimate of the fix GPS_KALMAN_SMOOTH_LAG
+** fixes back, smoothed with every fix since, is published as GPS_KALMAN_SmoothData_t.
+** The ring buffer holds GPS_KALMAN_SMOOTH_LAG + 1 fixes, about 360 bytes each, and
+** the smoothing pass costs about GPS_KALMAN_SMOOTH_LAG 4x4 matrix products per fix.
+** 0 builds the app without it.
+*/
+#define GPS_KALMAN_SMOOTH_LAG      20
+
+/*
+** Filter tuning, in the filter's local east/north frame. These are the contents of the
+** default parameter table, and are used if it cannot be loaded. The receiver noise
+** and latency are the defaults of every receiver.
+*/
+#define GPS_KALMAN_UERE_M          5.0    /* 1-sigma range error, position sigma = HDOP * UERE */
+#define GPS_KALMAN_VEL_SIGMA_MPS   0.5    /* 1-sigma velocity measurement noise, m/s */
+#define GPS_KALMAN_LATENCY_SEC     0.0    /* fix age at its message time stamp, s */
+#define GPS_KALMAN_ACCEL_PSD       0.5    /* white acceleration noise density, m^2/s^3 */
+#define GPS_KALMAN_INIT_VAR_SCALE  1.0    /* initial state variance / first fix's variance */
+
+/*
+** Heading filter, parameter table defaults. Heading and yaw rate are filtered from
+** the receiver's heading with a constant yaw rate model, in degrees. A fix slower
+** than GPS_KALMAN_HDG_MIN_SPEED_KPH, whose heading is mostly noise, does not update
+** it, and the heading is held until the vehicle moves again.
+*/
+#define GPS_KALMAN_HDG_MIN_SPEED_KPH  5.0    /* slowest fix that updates the heading, kph */
+#define GPS_KALMAN_YAW_ACCEL_PSD      10.0   /* white yaw acceleration density, deg^2/s^3 */
+#define GPS_KALMAN_YAW_RATE_SIGMA0    10.0   /* 1-sigma yaw rate at the start, deg/s */
+
+/*
+** Innovation gate, parameter table defaults. An update whose squared Mahalanobis
+** distance d2 = y' * S^-1 * y is over GPS_KALMAN_GATE_CHI2 is rejected and the state
+** coasts on the prediction. d2 is chi-square with 4 degrees of freedom, so 18.47 turns
+** away 0.1% of consistent fixes; 0 turns the gate off. After
+** GPS_KALMAN_GATE_MAX_REJECTS rejections in a row it is the filter, not the fixes,
+** that is wrong, and it restarts from the next fix.
+*/
+#define GPS_KALMAN_GATE_CHI2         18.47
+#define GPS_KALMAN_GATE_MAX_REJECTS  10
+
+/*
+** Steady-state gain, parameter table defaults. At a fixed fix rate and noise model the
+** gain converges; once no element of it has moved by more than
+** GPS_KALMAN_STEADY_GAIN_TOL for GPS_KALMAN_STEADY_SETTLE_FIXES updates in a row it is
+** frozen, and each fix costs a state-only predict and update. A fix with another dt
+** or noise (a DOP or rate change), or one that is gated, goes back to the full
+** filter until the gain settles again. 0 runs the full filter on every fix. The gain
+** approaches steady state slowly, so a tolerance much over 1e-6 freezes it early
+** and gives away accuracy.
+*/
+#define GPS_KALMAN_STEADY_GAIN_TOL      0.0
+#define GPS_KALMAN_STEADY_SETTLE_FIXES  10
+
+/*
+** Steady-state gain cache. Frozen gains are kept by measurement noise, in effect by
+** the reported HDOP, which has few distinct values. While the gain is frozen a DOP
+** change takes the cached gain for the new DOP. On a miss the full filter runs until
+** the gain settles again, and the new gain replaces the least recently used, so a
+** miss costs no more per fix than a filter with no steady-state gain. Each entry is
+** about 70 filter elements.
+*/
+#define GPS_KALMAN_GAIN_CACHE_LEN       8
+
+/*
+** Filter timing. dt between fixes is rounded to GPS_KALMAN_DT_QUANTUM_SEC so that a
+** steady input rate reuses the cached F and Q. A gap longer than GPS_KALMAN_MAX_DT_SEC
+** restarts the filter from the next fix. Both are parameter table defaults too.
+*/
+#define GPS_KALMAN_DT_QUANTUM_SEC  0.001
+#define GPS_KALMAN_MAX_DT_SEC      10.0
+
+/*
+** Coasting. With no fix, the published estimate is extrapolated from the last one and
+** flagged GPS_KALMAN_QUALITY_COAST, for at most GPS_KALMAN_COAST_MAX_SEC; after that
+** it is held and flagged GPS_KALMAN_QUALITY_STALE, not to be used. At most
+** GPS_KALMAN_MAX_DT_SEC. Parameter table default.
+*/
+#define GPS_KALMAN_COAST_MAX_SEC   3.0
+
+/*
+** 1: every fix queued on the TLM pipe during a wakeup is its own time stamped update,
+**    with a prediction to its time stamp, so the filter runs at the receiver rate.
+** 0: only the newest fix of each wakeup is used (one update per wakeup).
+*/
+#define GPS_KALMAN_UPDATE_EVERY_FIX 1
+
+/*
+** 1: event driven. GPS_READER_GPS_INFO_MSG is routed to the schedule pipe, and each
+**    fix is filtered and published as soon as it arrives. The wakeup still processes
+**    commands and, when no fix has arrived since the last one, publishes a coasted
+**    (prediction only) estimate.
+** 0: the filter runs from the scheduler wakeup
+*/
+#define GPS_KALMAN_EVENT_DRIVEN     0
+
+/*
+** The local frame is moved to a fix further than this from its anchor, which keeps
+** the distortion of the first order tangent plane below about 0.1%. Parameter table
+** default.
+*/
+#define GPS_KALMAN_ENU_MAX_RANGE_M 5000.0
+
+/*
+** Diagnostics at startup (GPS_KALMAN_DIAG_* flags), changed with GPS_KALMAN_SET_DIAG_CC.
+** Off by default: the periodic path then does no event or printf formatting.
+*/
+#define GPS_KALMAN_DIAG_MODE_DEFAULT       0x00
+#define GPS_KALMAN_DIAG_SUMMARY_PERIOD     600    /* cycles between summary events */
+
 
 /* TODO:  Add more platform configuration parameter definitions here, if necessary. */
 
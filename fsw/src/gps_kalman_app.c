@@ -45,22 +45,43 @@
 #include "gps_kalman_msg.h"
 #include "gps_reader_msgids.h"
 #include "gps_reader_msgs.h"
-
-#include <gsl/gsl_blas.h>
-#include <gsl/gsl_linalg.h>
-#include <gsl/gsl_matrix.h>
-#include <gsl/gsl_vector.h>
+#include "gps_kalman_decode.h"
+#include "gps_kalman_filter.h"
 
 /*
 ** Local Defines
 */
-#define GPS_KALMAN_FILTER_LEN (3)
+
+/* Receivers flown, see GPS_KALMAN_SOURCE_MIDS */
+#define GPS_KALMAN_SOURCE_CNT \
+    (sizeof(g_GPS_KALMAN_SourceMids) / sizeof(g_GPS_KALMAN_SourceMids[0]))
 
 /*
 ** Global Variables
 */
 GPS_KALMAN_AppData_t  g_GPS_KALMAN_AppData;
 
+/* Message ID of each receiver's GpsInfoMsg_t; the index is the receiver */
+static const CFE_SB_MsgId_t g_GPS_KALMAN_SourceMids[] = GPS_KALMAN_SOURCE_MIDS;
+
+CompileTimeAssert(GPS_KALMAN_SOURCE_CNT <= GPS_KALMAN_SOURCE_MAX, GPS_KALMAN_TooManySources);
+
+/* Tools without cFE (gps_kalman_replay) mirror GPS_KALMAN_OutData_t; a field added or
+** removed here must change GPS_KALMAN_OUT_DATA_LEN, and so them, too */
+CompileTimeAssert((sizeof(GPS_KALMAN_OutData_t) - CFE_SB_TLM_HDR_SIZE >= GPS_KALMAN_OUT_DATA_LEN) &&
+                  (sizeof(GPS_KALMAN_OutData_t) - CFE_SB_TLM_HDR_SIZE < GPS_KALMAN_OUT_DATA_LEN + 8),
+                  GPS_KALMAN_OutDataLen);
+
+/* ES perf ID of each GPS_KALMAN_STAGE_* */
+static const uint32 g_GPS_KALMAN_StagePerfIds[GPS_KALMAN_STAGE_CNT] =
+{
+    GPS_KALMAN_PROCESS_CMDS_PERF_ID,
+    GPS_KALMAN_PROCESS_DATA_PERF_ID,
+    GPS_KALMAN_PREDICT_PERF_ID,
+    GPS_KALMAN_UPDATE_PERF_ID,
+    GPS_KALMAN_SEND_OUT_PERF_ID
+};
+
 /*
 ** Local Variables
 */
@@ -189,9 +210,14 @@ int32 GPS_KALMAN_InitEvent()
 int32 GPS_KALMAN_InitPipe()
 {
     int32  iStatus=CFE_SUCCESS;
+    uint32 i;
 
-    /* Init schedule pipe */
+    /* Init schedule pipe. In event driven mode fixes arrive on it too. */
+#if GPS_KALMAN_EVENT_DRIVEN
+    g_GPS_KALMAN_AppData.usSchPipeDepth = GPS_KALMAN_SCH_PIPE_DEPTH + GPS_KALMAN_TLM_PIPE_DEPTH;
+#else
     g_GPS_KALMAN_AppData.usSchPipeDepth = GPS_KALMAN_SCH_PIPE_DEPTH;
+#endif
     memset((void*) g_GPS_KALMAN_AppData.cSchPipeName, '\0', sizeof(g_GPS_KALMAN_AppData.cSchPipeName));
     strncpy(g_GPS_KALMAN_AppData.cSchPipeName, "GPS_KALMAN_SCH_PIPE", OS_MAX_API_NAME-1);
 
@@ -209,6 +235,20 @@ int32 GPS_KALMAN_InitPipe()
             goto GPS_KALMAN_InitPipe_Exit_Tag;
         }
 
+#if GPS_KALMAN_EVENT_DRIVEN
+        for (i = 0; i < GPS_KALMAN_SOURCE_CNT; i++)
+        {
+            iStatus = CFE_SB_SubscribeEx(g_GPS_KALMAN_SourceMids[i], g_GPS_KALMAN_AppData.SchPipeId,
+                                         CFE_SB_Default_Qos, GPS_KALMAN_TLM_PIPE_DEPTH);
+
+            if (iStatus != CFE_SUCCESS)
+            {
+                CFE_ES_WriteToSysLog("GPS_KALMAN - Sch Pipe failed to subscribe to receiver %u msgId 0x%04X. (0x%08X)\n",
+                                     (unsigned int) i, (unsigned int) g_GPS_KALMAN_SourceMids[i], iStatus);
+                goto GPS_KALMAN_InitPipe_Exit_Tag;
+            }
+        }
+#endif
     }
     else
     {
@@ -268,8 +308,20 @@ int32 GPS_KALMAN_InitPipe()
         **     CFE_SB_Subscribe(GNCEXEC_OUT_DATA_MID, g_GPS_KALMAN_AppData.TlmPipeId);
         */
 
-        /* GPS Reader messages */
-        CFE_SB_Subscribe(GPS_READER_GPS_INFO_MSG,  g_GPS_KALMAN_AppData.TlmPipeId);
+        /* GPS Reader messages, one GPS_READER_GPS_INFO_MSG like message per receiver */
+#if !GPS_KALMAN_EVENT_DRIVEN
+        for (i = 0; i < GPS_KALMAN_SOURCE_CNT; i++)
+        {
+            iStatus = CFE_SB_Subscribe(g_GPS_KALMAN_SourceMids[i], g_GPS_KALMAN_AppData.TlmPipeId);
+
+            if (iStatus != CFE_SUCCESS)
+            {
+                CFE_ES_WriteToSysLog("GPS_KALMAN - TLM Pipe failed to subscribe to receiver %u msgId 0x%04X. (0x%08X)\n",
+                                     (unsigned int) i, (unsigned int) g_GPS_KALMAN_SourceMids[i], iStatus);
+                goto GPS_KALMAN_InitPipe_Exit_Tag;
+            }
+        }
+#endif
         /* CFE_SB_Subscribe(GPS_READER_GPS_GPGGA_MSG, g_GPS_KALMAN_AppData.TlmPipeId); */
         /* CFE_SB_Subscribe(GPS_READER_GPS_GPGSA_MSG, g_GPS_KALMAN_AppData.TlmPipeId); */
         /* CFE_SB_Subscribe(GPS_READER_GPS_GPGSV_MSG, g_GPS_KALMAN_AppData.TlmPipeId); */
@@ -309,7 +361,10 @@ GPS_KALMAN_InitPipe_Exit_Tag:
 **
 ** Global Outputs/Writes:
 **    g_GPS_KALMAN_AppData.InData
-**    g_GPS_KALMAN_AppData.OutData
+**    g_GPS_KALMAN_AppData.uiOutCnt
+**    g_GPS_KALMAN_AppData.bOutBufFailed
+**    g_GPS_KALMAN_AppData.uiSmoothCnt
+**    g_GPS_KALMAN_AppData.bSmoothBufFailed
 **    g_GPS_KALMAN_AppData.HkTlm
 **
 ** Limitations, Assumptions, External Events, and Notes:
@@ -330,18 +385,17 @@ GPS_KALMAN_InitPipe_Exit_Tag:
 int32 GPS_KALMAN_InitData()
 {
     int32  iStatus = CFE_SUCCESS;
+    int    i;
 
     /* Init input data */
     memset((void*) &g_GPS_KALMAN_AppData.InData, 0x00,
             sizeof(g_GPS_KALMAN_AppData.InData));
 
-    /* Init output data */
-    memset((void*) &g_GPS_KALMAN_AppData.OutData, 0x00,
-            sizeof(g_GPS_KALMAN_AppData.OutData));
-    CFE_SB_InitMsg(&g_GPS_KALMAN_AppData.OutData,
-            GPS_KALMAN_OUT_DATA_MID,
-            sizeof(g_GPS_KALMAN_AppData.OutData),
-            TRUE);
+    /* Init output data; each message is built in its own SB buffer */
+    g_GPS_KALMAN_AppData.uiOutCnt      = 0;
+    g_GPS_KALMAN_AppData.bOutBufFailed = FALSE;
+    g_GPS_KALMAN_AppData.uiSmoothCnt      = 0;
+    g_GPS_KALMAN_AppData.bSmoothBufFailed = FALSE;
 
     /* Init housekeeping packet */
     memset((void*)&g_GPS_KALMAN_AppData.HkTlm, 0x00,
@@ -350,23 +404,226 @@ int32 GPS_KALMAN_InitData()
             GPS_KALMAN_HK_TLM_MID,
             sizeof(g_GPS_KALMAN_AppData.HkTlm), TRUE);
 
-    /* initalize all the kalman filter elements */
-    GPS_KALMAN_Init_Matrix_Data();
-    gsl_matrix_set_identity(FMatrix);
-    gsl_matrix_set_zero(TmpMatrix);
-    gsl_matrix_set_zero(TmpMatrix2);
-    gsl_matrix_set_identity(PMatrix);
-    gsl_matrix_scale(PMatrix, 999999.0);
-    gsl_matrix_set_identity(QMatrix);
-    gsl_matrix_scale(QMatrix, 0.1);
-    gsl_matrix_set_identity(HMatrix);
-    gsl_matrix_set_identity(SigmaExpectMatrix);
-    gsl_matrix_set_identity(SigmaActualMatrix);
-    gsl_matrix_set_zero(KMatrix);
+    /* Init diagnostics */
+    memset((void*)&g_GPS_KALMAN_AppData.DiagTlm, 0x00,
+            sizeof(g_GPS_KALMAN_AppData.DiagTlm));
+    CFE_SB_InitMsg(&g_GPS_KALMAN_AppData.DiagTlm,
+            GPS_KALMAN_DIAG_TLM_MID,
+            sizeof(g_GPS_KALMAN_AppData.DiagTlm), TRUE);
+    g_GPS_KALMAN_AppData.ucDiagMode        = GPS_KALMAN_DIAG_MODE_DEFAULT;
+    g_GPS_KALMAN_AppData.usSummaryPeriod   = GPS_KALMAN_DIAG_SUMMARY_PERIOD;
+    g_GPS_KALMAN_AppData.uiSummaryCycles   = 0;
+    g_GPS_KALMAN_AppData.uiSummaryFixes    = 0;
+    g_GPS_KALMAN_AppData.uiSummaryBadFixes = 0;
+    g_GPS_KALMAN_AppData.uiSummaryRejects  = 0;
+
+    /* Init stage timing */
+    for (i = 0; i < GPS_KALMAN_STAGE_CNT; i++)
+    {
+        GPS_KALMAN_Stats_Reset(&g_GPS_KALMAN_AppData.StageStats[i]);
+    }
+
+    /* initalize all the kalman filter elements; no fix yet */
+    GPS_KALMAN_Core_Init(&g_GPS_KALMAN_AppData.Core);
+    g_GPS_KALMAN_AppData.bFixSinceWakeup = FALSE;
+#if GPS_KALMAN_SMOOTH_LAG
+    GPS_KALMAN_Smooth_Init(&g_GPS_KALMAN_AppData.Smooth, GPS_KALMAN_SMOOTH_LAG);
+#endif
+
+    return (iStatus);
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_InitTable
+**
+** Purpose: To register and load the filter parameter table
+**
+** Arguments:
+**    None
+**
+** Returns:
+**    int32 iStatus - Status of initialization
+**
+** Routines Called:
+**    CFE_TBL_Register
+**    CFE_TBL_Load
+**    CFE_ES_WriteToSysLog
+**    CFE_EVS_SendEvent
+**    GPS_KALMAN_Core_DefaultParams
+**    GPS_KALMAN_ManageTable
+**
+** Called By:
+**    GPS_KALMAN_InitApp
+**
+** Global Inputs/Reads:
+**    None
+**
+** Global Outputs/Writes:
+**    g_GPS_KALMAN_AppData.ParamTblHdl
+**    g_GPS_KALMAN_AppData.Core
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. If GPS_KALMAN_PARAM_TBL_FILENAME cannot be loaded, or fails validation, the
+**       built-in defaults are loaded instead, so the app still runs and a good table
+**       can be loaded later
+**    2. Must follow GPS_KALMAN_InitData, which resets the core to the defaults
+**
+** Algorithm:
+**    None
+**
+** Author(s):  GPS_KALMAN Team
+**
+** History:  Date Written  2026-10-17
+**           Unit Tested   yyyy-mm-dd
+**=====================================================================================*/
+int32 GPS_KALMAN_InitTable()
+{
+    int32  iStatus = CFE_SUCCESS;
+    GPS_KALMAN_ParamTbl_t  DefaultTbl;
+
+    iStatus = CFE_TBL_Register(&g_GPS_KALMAN_AppData.ParamTblHdl,
+                               GPS_KALMAN_PARAM_TBL_NAME,
+                               sizeof(GPS_KALMAN_ParamTbl_t),
+                               CFE_TBL_OPT_DEFAULT,
+                               GPS_KALMAN_ValidateParamTbl);
+    if (iStatus != CFE_SUCCESS)
+    {
+        CFE_ES_WriteToSysLog("GPS_KALMAN - Failed to register the parameter table (0x%08X)\n",
+                             iStatus);
+        goto GPS_KALMAN_InitTable_Exit_Tag;
+    }
+
+    iStatus = CFE_TBL_Load(g_GPS_KALMAN_AppData.ParamTblHdl, CFE_TBL_SRC_FILE,
+                           GPS_KALMAN_PARAM_TBL_FILENAME);
+    if (iStatus != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(GPS_KALMAN_ILOAD_ERR_EID, CFE_EVS_ERROR,
+                "GPS_KALMAN - Failed to load %s (0x%08X), using the default parameters",
+                GPS_KALMAN_PARAM_TBL_FILENAME, iStatus);
+
+        GPS_KALMAN_Core_DefaultParams(&DefaultTbl);
+        iStatus = CFE_TBL_Load(g_GPS_KALMAN_AppData.ParamTblHdl, CFE_TBL_SRC_ADDRESS,
+                               &DefaultTbl);
+        if (iStatus != CFE_SUCCESS)
+        {
+            CFE_ES_WriteToSysLog("GPS_KALMAN - Failed to load the default parameters (0x%08X)\n",
+                                 iStatus);
+            goto GPS_KALMAN_InitTable_Exit_Tag;
+        }
+    }
+
+    GPS_KALMAN_ManageTable(TRUE);
 
+GPS_KALMAN_InitTable_Exit_Tag:
     return (iStatus);
 }
 
+/*=====================================================================================
+** Name: GPS_KALMAN_InitCds
+**
+** Purpose: To register the filter state checkpoint in the Critical Data Store, and
+**          resume the filter from it if one survived the restart
+**
+** Arguments:
+**    None
+**
+** Returns:
+**    None
+**
+** Routines Called:
+**    CFE_ES_RegisterCDS
+**    CFE_ES_RestoreFromCDS
+**    CFE_EVS_SendEvent
+**    GPS_KALMAN_Core_Restore
+**
+** Called By:
+**    GPS_KALMAN_InitApp
+**
+** Global Inputs/Reads:
+**    None
+**
+** Global Outputs/Writes:
+**    g_GPS_KALMAN_AppData.CdsHdl
+**    g_GPS_KALMAN_AppData.bCdsEnabled
+**    g_GPS_KALMAN_AppData.bCdsDirty
+**    g_GPS_KALMAN_AppData.bCdsSaveFailed
+**    g_GPS_KALMAN_AppData.usCdsCycles
+**    g_GPS_KALMAN_AppData.Checkpoint
+**    g_GPS_KALMAN_AppData.Core
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. Not fatal: without a CDS the app runs as before, from a cold start
+**    2. Must follow GPS_KALMAN_InitTable, so the checkpoint is checked against the
+**       loaded parameters
+**    3. A new block, or a checkpoint that cannot be used, is overwritten at the first
+**       save
+**
+** Algorithm:
+**    None
+**
+** Author(s):  GPS_KALMAN Team
+**
+** History:  Date Written  2026-10-17
+**           Unit Tested   yyyy-mm-dd
+**=====================================================================================*/
+void GPS_KALMAN_InitCds(void)
+{
+    int32  iStatus;
+    int    status;
+
+    g_GPS_KALMAN_AppData.bCdsEnabled    = FALSE;
+    g_GPS_KALMAN_AppData.bCdsDirty      = TRUE;
+    g_GPS_KALMAN_AppData.bCdsSaveFailed = FALSE;
+    g_GPS_KALMAN_AppData.usCdsCycles    = 0;
+
+    iStatus = CFE_ES_RegisterCDS(&g_GPS_KALMAN_AppData.CdsHdl,
+                                 sizeof(g_GPS_KALMAN_AppData.Checkpoint),
+                                 GPS_KALMAN_CDS_NAME);
+    if (iStatus == CFE_SUCCESS)
+    {
+        /* A new block: nothing to resume from */
+        g_GPS_KALMAN_AppData.bCdsEnabled = TRUE;
+        goto GPS_KALMAN_InitCds_Exit_Tag;
+    }
+    else if (iStatus != CFE_ES_CDS_ALREADY_EXISTS)
+    {
+        CFE_EVS_SendEvent(GPS_KALMAN_CDS_ERR_EID, CFE_EVS_ERROR,
+                "GPS_KALMAN - Failed to register the CDS (0x%08X), no warm restart", iStatus);
+        goto GPS_KALMAN_InitCds_Exit_Tag;
+    }
+    g_GPS_KALMAN_AppData.bCdsEnabled = TRUE;
+
+    iStatus = CFE_ES_RestoreFromCDS(&g_GPS_KALMAN_AppData.Checkpoint,
+                                    g_GPS_KALMAN_AppData.CdsHdl);
+    if (iStatus != CFE_SUCCESS)
+    {
+        CFE_EVS_SendEvent(GPS_KALMAN_CDS_ERR_EID, CFE_EVS_ERROR,
+                "GPS_KALMAN - Failed to restore from the CDS (0x%08X), starting cold", iStatus);
+        goto GPS_KALMAN_InitCds_Exit_Tag;
+    }
+
+    status = GPS_KALMAN_Core_Restore(&g_GPS_KALMAN_AppData.Core,
+                                     &g_GPS_KALMAN_AppData.Checkpoint);
+    if (status == GPS_KALMAN_FILTER_SUCCESS)
+    {
+        /* The checkpoint already holds this state */
+        g_GPS_KALMAN_AppData.bCdsDirty = FALSE;
+        CFE_EVS_SendEvent(GPS_KALMAN_CDS_INF_EID, CFE_EVS_INFORMATION,
+                "GPS_KALMAN - Resumed from the CDS checkpoint, last fix at %.2f s",
+                g_GPS_KALMAN_AppData.Checkpoint.lastFixTime);
+    }
+    else if (status == GPS_KALMAN_CORE_ERR_CHECKPOINT)
+    {
+        CFE_EVS_SendEvent(GPS_KALMAN_CDS_ERR_EID, CFE_EVS_ERROR,
+                "GPS_KALMAN - CDS checkpoint rejected (magic 0x%08X), starting cold",
+                (unsigned int) g_GPS_KALMAN_AppData.Checkpoint.magic);
+    }
+    /* Otherwise the checkpoint was saved with no state, and there is nothing to resume */
+
+GPS_KALMAN_InitCds_Exit_Tag:
+    return;
+}
+
 /*=====================================================================================
 ** Name: GPS_KALMAN_InitApp
 **
@@ -386,6 +643,8 @@ int32 GPS_KALMAN_InitData()
 **    GPS_KALMAN_InitEvent
 **    GPS_KALMAN_InitPipe
 **    GPS_KALMAN_InitData
+**    GPS_KALMAN_InitTable
+**    GPS_KALMAN_InitCds
 **
 ** Called By:
 **    GPS_KALMAN_AppMain
@@ -429,12 +688,15 @@ int32 GPS_KALMAN_InitApp()
 
     if ((GPS_KALMAN_InitEvent() != CFE_SUCCESS) ||
         (GPS_KALMAN_InitPipe() != CFE_SUCCESS) ||
-        (GPS_KALMAN_InitData() != CFE_SUCCESS))
+        (GPS_KALMAN_InitData() != CFE_SUCCESS) ||
+        (GPS_KALMAN_InitTable() != CFE_SUCCESS))
     {
         iStatus = -1;
         goto GPS_KALMAN_InitApp_Exit_Tag;
     }
 
+    GPS_KALMAN_InitCds();
+
     /* Install the cleanup callback */
     OS_TaskInstallDeleteHandler(GPS_KALMAN_CleanupCallback);
 
@@ -516,8 +778,15 @@ void GPS_KALMAN_CleanupCallback()
 **    CFE_ES_PerfLogEntry
 **    CFE_ES_PerfLogExit
 **    GPS_KALMAN_ProcessNewCmds
+**    GPS_KALMAN_ManageTable
 **    GPS_KALMAN_ProcessNewData
+**    GPS_KALMAN_SourceOf
+**    GPS_KALMAN_ProcessGpsInfo
+**    GPS_KALMAN_RunFilter
+**    GPS_KALMAN_RunNewest
 **    GPS_KALMAN_SendOutData
+**    GPS_KALMAN_SendDiag
+**    GPS_KALMAN_SaveCds
 **
 ** Called By:
 **    GPS_KALMAN_Main
@@ -529,11 +798,13 @@ void GPS_KALMAN_CleanupCallback()
 **    g_GPS_KALMAN_AppData.uiRunStatus
 **
 ** Limitations, Assumptions, External Events, and Notes:
-**    1. List assumptions that are made that apply to this function.
-**    2. List the external source(s) and event(s) that can cause this function to execute.
-**    3. List known limitations that apply to this function.
-**    4. If there are no assumptions, external events, or notes then enter NONE.
-**       Do not omit the section.
+**    1. With GPS_KALMAN_EVENT_DRIVEN set, the schedule pipe also carries every
+**       receiver's GpsInfoMsg_t, and each fix that moves the filter is filtered and
+**       published on arrival. The wakeup then only processes commands and coasts
+**       when fixes stop.
+**    2. Otherwise a wakeup with no fix filtered publishes the estimate coasted to
+**       now, flagged GPS_KALMAN_QUALITY_COAST, or _STALE after the parameter
+**       table's coastMaxSec.
 **
 ** Algorithm:
 **    Psuedo-code or description of basic algorithm
@@ -548,6 +819,10 @@ int32 GPS_KALMAN_RcvMsg(int32 iBlocking)
     int32           iStatus = CFE_SUCCESS;
     CFE_SB_Msg_t*   MsgPtr = NULL;
     CFE_SB_MsgId_t  MsgId;
+#if GPS_KALMAN_EVENT_DRIVEN
+    uint32          uiSource;
+    int32           iFilterStatus;
+#endif
 
     /* Stop Performance Log entry */
     CFE_ES_PerfLogExit(GPS_KALMAN_MAIN_TASK_PERF_ID);
@@ -564,18 +839,67 @@ int32 GPS_KALMAN_RcvMsg(int32 iBlocking)
         switch (MsgId)
         {
         case GPS_KALMAN_WAKEUP_MID:
+            GPS_KALMAN_StageEntry(GPS_KALMAN_STAGE_CMDS);
             GPS_KALMAN_ProcessNewCmds();
+            GPS_KALMAN_ManageTable(FALSE);
+            GPS_KALMAN_StageExit(GPS_KALMAN_STAGE_CMDS);
+
+            GPS_KALMAN_StageEntry(GPS_KALMAN_STAGE_DATA);
             GPS_KALMAN_ProcessNewData();
+            GPS_KALMAN_StageExit(GPS_KALMAN_STAGE_DATA);
 
             /* TODO:  Add more code here to handle other things when app wakes up */
-            GPS_KALMAN_RunFilter();
+#if GPS_KALMAN_EVENT_DRIVEN
+            /* Fixes were filtered and published on arrival; only coast through a gap */
+            if (!g_GPS_KALMAN_AppData.bFixSinceWakeup)
+            {
+                GPS_KALMAN_StageEntry(GPS_KALMAN_STAGE_SEND_OUT);
+                GPS_KALMAN_SendOutData(TRUE);
+                GPS_KALMAN_StageExit(GPS_KALMAN_STAGE_SEND_OUT);
+            }
+#else
+#if !GPS_KALMAN_UPDATE_EVERY_FIX
+            /* Otherwise ProcessNewData has already run the filter once per fix */
+            CFE_ES_PerfLogEntry(GPS_KALMAN_RUN_FILTER_PERF_ID);
+            GPS_KALMAN_RunNewest();
+            CFE_ES_PerfLogExit(GPS_KALMAN_RUN_FILTER_PERF_ID);
+#endif
 
             /* The last thing to do at the end of this Wakeup cycle should be to
-               automatically publish new output. */
-            GPS_KALMAN_SendOutData();
+               automatically publish new output, coasted if no fix was filtered. */
+            GPS_KALMAN_StageEntry(GPS_KALMAN_STAGE_SEND_OUT);
+            GPS_KALMAN_SendOutData(!g_GPS_KALMAN_AppData.bFixSinceWakeup);
+            GPS_KALMAN_StageExit(GPS_KALMAN_STAGE_SEND_OUT);
+#endif
+            g_GPS_KALMAN_AppData.bFixSinceWakeup = FALSE;
+            GPS_KALMAN_SendDiag();
+            GPS_KALMAN_SaveCds(FALSE);
             break;
 
         default:
+#if GPS_KALMAN_EVENT_DRIVEN
+            uiSource = GPS_KALMAN_SourceOf(MsgId);
+            if (uiSource < GPS_KALMAN_SOURCE_CNT)
+            {
+                /* Output latency is bounded by the fix's arrival, not the schedule */
+                GPS_KALMAN_StageEntry(GPS_KALMAN_STAGE_DATA);
+                GPS_KALMAN_ProcessGpsInfo(MsgPtr, uiSource);
+                CFE_ES_PerfLogEntry(GPS_KALMAN_RUN_FILTER_PERF_ID);
+                iFilterStatus = GPS_KALMAN_RunFilter(uiSource);
+                CFE_ES_PerfLogExit(GPS_KALMAN_RUN_FILTER_PERF_ID);
+                GPS_KALMAN_StageExit(GPS_KALMAN_STAGE_DATA);
+
+                /* Only an estimate the fix moved is news; a repeated time stamp or a
+                ** bad fix publishes nothing, and the wakeup coasts through a gap */
+                if (iFilterStatus != GPS_KALMAN_CORE_SKIP)
+                {
+                    GPS_KALMAN_StageEntry(GPS_KALMAN_STAGE_SEND_OUT);
+                    GPS_KALMAN_SendOutData(FALSE);
+                    GPS_KALMAN_StageExit(GPS_KALMAN_STAGE_SEND_OUT);
+                }
+                break;
+            }
+#endif
             CFE_EVS_SendEvent(GPS_KALMAN_MSGID_ERR_EID,
                     CFE_EVS_ERROR,
                     "GPS_KALMAN - Recvd invalid SCH msgId (0x%08X)", MsgId);
@@ -614,6 +938,9 @@ int32 GPS_KALMAN_RcvMsg(int32 iBlocking)
 **    CFE_SB_RcvMsg
 **    CFE_SB_GetMsgId
 **    CFE_EVS_SendEvent
+**    GPS_KALMAN_SourceOf
+**    GPS_KALMAN_ProcessGpsInfo
+**    GPS_KALMAN_RunFilter
 **
 ** Called By:
 **    GPS_KALMAN_RcvMsg
@@ -622,14 +949,14 @@ int32 GPS_KALMAN_RcvMsg(int32 iBlocking)
 **    None
 **
 ** Global Outputs/Writes:
-**    None
+**    g_GPS_KALMAN_AppData.InData
 **
 ** Limitations, Assumptions, External Events, and Notes:
-**    1. List assumptions that are made that apply to this function.
-**    2. List the external source(s) and event(s) that can cause this function to execute.
-**    3. List known limitations that apply to this function.
-**    4. If there are no assumptions, external events, or notes then enter NONE.
-**       Do not omit the section.
+**    1. With GPS_KALMAN_UPDATE_EVERY_FIX set, GPS_KALMAN_RunFilter is called for each
+**       fix as it is taken off the pipe, so every queued fix is used in arrival
+**       order; otherwise InData keeps only the newest fix of each receiver.
+**    2. Fixes queued beyond GPS_KALMAN_TLM_PIPE_DEPTH are dropped by the SB. The
+**       receivers share the pipe, so its depth must cover all of them.
 **
 ** Algorithm:
 **    Psuedo-code or description of basic algorithm
@@ -644,7 +971,7 @@ void GPS_KALMAN_ProcessNewData()
     int iStatus = CFE_SUCCESS;
     CFE_SB_Msg_t*   TlmMsgPtr = NULL;
     CFE_SB_MsgId_t  TlmMsgId;
-    boolean newFilterDataRecieved = FALSE;
+    uint32          uiSource;
 
     /* Process telemetry messages till the pipe is empty */
     while (1)
@@ -653,40 +980,23 @@ void GPS_KALMAN_ProcessNewData()
         if (iStatus == CFE_SUCCESS)
         {
             TlmMsgId = CFE_SB_GetMsgId(TlmMsgPtr);
-            switch (TlmMsgId)
+            uiSource = GPS_KALMAN_SourceOf(TlmMsgId);
+            if (uiSource < GPS_KALMAN_SOURCE_CNT)
+            {
+                GPS_KALMAN_ProcessGpsInfo(TlmMsgPtr, uiSource);
+
+#if GPS_KALMAN_UPDATE_EVERY_FIX
+                /* Predict to this fix's time stamp and update with it before the next
+                ** one overwrites InData */
+                CFE_ES_PerfLogEntry(GPS_KALMAN_RUN_FILTER_PERF_ID);
+                GPS_KALMAN_RunFilter(uiSource);
+                CFE_ES_PerfLogExit(GPS_KALMAN_RUN_FILTER_PERF_ID);
+#endif
+            }
+            else
             {
-            case GPS_READER_GPS_INFO_MSG:
-                /* CFE_EVS_SendEvent(GPS_KALMAN_CMD_INF_EID, CFE_EVS_INFORMATION, "GPS_INFO messgage"); */
-                newFilterDataRecieved = TRUE;
-                GpsInfoMsg_t *infoMsg = (GpsInfoMsg_t *) TlmMsgPtr;
-
-                /* Lat and Lon are +/- in decimal format */
-                g_GPS_KALMAN_AppData.InData.gpsLat  = decimal_minutes2decimal_decimal(infoMsg->gpsInfo.lat);
-                g_GPS_KALMAN_AppData.InData.gpsLon  = decimal_minutes2decimal_decimal(infoMsg->gpsInfo.lon);
-                /* kph */
-                g_GPS_KALMAN_AppData.InData.gpsVel  = infoMsg->gpsInfo.speed;
-                /* degrees true */
-                g_GPS_KALMAN_AppData.InData.gpsHdg = infoMsg->gpsInfo.direction;
-                g_GPS_KALMAN_AppData.InData.gpsDOP = infoMsg->gpsInfo.HDOP; /* Horizontal Dilution Of Precision */
-
-                /* Determine whether GPS fix is good based on reported signals and PDOP */
-                g_GPS_KALMAN_AppData.InData.gpsFixOk =
-                /* fix = Operating mode, used for navigation (1 = Fix not available; 2 = 2D; 3 = 3D) */
-                    (infoMsg->gpsInfo.fix >= 2)
-                /* sig = GPS quality indicator (0 = Invalid; 1 = Fix; 2 = Differential, 3 = Sensitive) */
-                && (infoMsg->gpsInfo.sig >= 1)
-                /* 99.99 is used for undetermined/null */
-                && (g_GPS_KALMAN_AppData.InData.gpsDOP < 99.99);
-
-
-                /* TODO: replace with actual filtering */
-                g_GPS_KALMAN_AppData.OutData.filterHdg = infoMsg->gpsInfo.direction;
-                break;
-
-            default:
                 CFE_EVS_SendEvent(GPS_KALMAN_MSGID_ERR_EID, CFE_EVS_ERROR,
                                   "GPS_KALMAN - Recvd invalid TLM msgId (0x%08X)", TlmMsgId);
-                break;
             }
         }
         else if (iStatus == CFE_SB_NO_MESSAGE)
@@ -696,30 +1006,150 @@ void GPS_KALMAN_ProcessNewData()
         else
         {
             CFE_EVS_SendEvent(GPS_KALMAN_PIPE_ERR_EID, CFE_EVS_ERROR,
-                  "GPS_KALMAN: CMD pipe read error (0x%08X)", iStatus);
+                  "GPS_KALMAN: TLM pipe read error (0x%08X)", iStatus);
             g_GPS_KALMAN_AppData.uiRunStatus = CFE_ES_APP_ERROR;
             break;
         }
     }
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_SourceOf
+**
+** Purpose: To find the receiver a message comes from
+**
+** Arguments:
+**    CFE_SB_MsgId_t MsgId - message ID
+**
+** Returns:
+**    uint32 - index of MsgId in GPS_KALMAN_SOURCE_MIDS, or GPS_KALMAN_SOURCE_CNT if it
+**             is not a receiver's
+**
+** Routines Called:
+**    None
+**
+** Called By:
+**    GPS_KALMAN_ProcessNewData
+**    GPS_KALMAN_RcvMsg (GPS_KALMAN_EVENT_DRIVEN)
+**
+** Global Inputs/Reads:
+**    g_GPS_KALMAN_SourceMids
+**
+** Global Outputs/Writes:
+**    None
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. A linear search; there are only a few receivers
+**
+** Algorithm:
+**    None
+**
+** Author(s):  GPS_KALMAN Team
+**
+** History:  Date Written  2026-10-17
+**           Unit Tested   yyyy-mm-dd
+**=====================================================================================*/
+uint32 GPS_KALMAN_SourceOf(CFE_SB_MsgId_t MsgId)
+{
+    uint32 i;
 
-    if (newFilterDataRecieved)
+    for (i = 0; i < GPS_KALMAN_SOURCE_CNT; i++)
     {
-        if (!g_GPS_KALMAN_AppData.InData.gpsFixOk)
+        if (g_GPS_KALMAN_SourceMids[i] == MsgId)
         {
-            CFE_EVS_SendEvent(GPS_KALMAN_ERR_EID, CFE_EVS_ERROR, "GPS data not good");
+            break;
         }
-        else
+    }
+
+    return i;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_ProcessGpsInfo
+**
+** Purpose: To decode one receiver's GpsInfoMsg_t into its InData
+**
+** Arguments:
+**    CFE_SB_Msg_t* TlmMsgPtr - received GpsInfoMsg_t
+**    uint32 uiSource         - receiver, see GPS_KALMAN_SourceOf
+**
+** Returns:
+**    None
+**
+** Routines Called:
+**    CFE_SB_GetMsgTime
+**    CFE_TIME_GetTime
+**    CFE_EVS_SendEvent
+**    GPS_KALMAN_TimeToSec
+**    GPS_KALMAN_DecodeInfo
+**
+** Called By:
+**    GPS_KALMAN_ProcessNewData
+**    GPS_KALMAN_RcvMsg (GPS_KALMAN_EVENT_DRIVEN)
+**
+** Global Inputs/Reads:
+**    None
+**
+** Global Outputs/Writes:
+**    g_GPS_KALMAN_AppData.InData
+**    g_GPS_KALMAN_AppData.HkTlm, the receiver's fix counters
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. Only a change of a receiver's fix quality is reported as an event
+**    2. The receiver state is read in place in the SB buffer, and decoded once,
+**       straight into the GPS_KALMAN_Fix_t that GPS_KALMAN_Core_Prepare reads. The
+**       decoded fix has to outlive the buffer, since the next receive on the pipe
+**       releases it and GPS_KALMAN_UPDATE_EVERY_FIX 0 filters only the newest fix.
+**
+** Algorithm:
+**    None
+**
+** Author(s):  Jacob Killelea
+**
+** History:  Date Written  2019-06-28
+**           Unit Tested   yyyy-mm-dd
+**=====================================================================================*/
+void GPS_KALMAN_ProcessGpsInfo(CFE_SB_Msg_t* TlmMsgPtr, uint32 uiSource)
+{
+    GPS_KALMAN_InData_t *InPtr = &g_GPS_KALMAN_AppData.InData[uiSource];
+    boolean prevFixOk = InPtr->gpsFixOk;
+    const GpsInfoMsg_t *infoMsg = (const GpsInfoMsg_t *) TlmMsgPtr;
+    GPS_KALMAN_Fix_t   *fix = &InPtr->gpsFix;
+    CFE_TIME_SysTime_t  msgTime;
+
+    /* dt between fixes comes from the message time stamps. An unstamped
+    ** message falls back to the time of receipt. */
+    InPtr->gpsNew = TRUE;
+    msgTime = CFE_SB_GetMsgTime(TlmMsgPtr);
+    if ((msgTime.Seconds == 0) && (msgTime.Subseconds == 0))
+    {
+        msgTime = CFE_TIME_GetTime();
+    }
+    fix->time   = GPS_KALMAN_TimeToSec(msgTime);
+    fix->source = uiSource;
+
+    /* Same decode as the host replay tool */
+    InPtr->gpsFixOk = GPS_KALMAN_DecodeInfo(&infoMsg->gpsInfo, fix) ? TRUE : FALSE;
+
+    /* Report changes of fix quality only; individual inputs go to the
+    ** diagnostic packet, so nothing is formatted per fix */
+    if (!InPtr->gpsFixOk)
+    {
+        g_GPS_KALMAN_AppData.HkTlm.uiSourceBadCnt[uiSource]++;
+        g_GPS_KALMAN_AppData.uiSummaryBadFixes++;
+        if (prevFixOk)
+        {
+            CFE_EVS_SendEvent(GPS_KALMAN_ERR_EID, CFE_EVS_ERROR,
+                    "GPS %u data not good", (unsigned int) uiSource);
+        }
+    }
+    else
+    {
+        g_GPS_KALMAN_AppData.HkTlm.uiSourceFixCnt[uiSource]++;
+        if (!prevFixOk)
         {
-            OS_printf("[GPS_KALMAN] Input Lat  %11.7f\n",
-                    g_GPS_KALMAN_AppData.InData.gpsLat);
-            OS_printf("[GPS_KALMAN] Input Lon  %11.7f\n",
-                    g_GPS_KALMAN_AppData.InData.gpsLon);
-            OS_printf("[GPS_KALMAN] Input Spd  %11.7f\n",
-                    g_GPS_KALMAN_AppData.InData.gpsVel);
-            OS_printf("[GPS_KALMAN] Input Hdg  %11.7f\n",
-                    g_GPS_KALMAN_AppData.InData.gpsHdg);
-            OS_printf("[GPS_KALMAN] Input PDOP %11.7f\n",
-                    g_GPS_KALMAN_AppData.InData.gpsDOP);
+            CFE_EVS_SendEvent(GPS_KALMAN_INF_EID, CFE_EVS_INFORMATION,
+                    "GPS %u data good", (unsigned int) uiSource);
         }
     }
 }
@@ -861,6 +1291,7 @@ void GPS_KALMAN_ProcessNewCmds()
 void GPS_KALMAN_ProcessNewAppCmds(CFE_SB_Msg_t* MsgPtr)
 {
     uint32 cmdCode = 0;
+    uint32 i;
 
     if (MsgPtr != NULL)
     {
@@ -874,11 +1305,44 @@ void GPS_KALMAN_ProcessNewAppCmds(CFE_SB_Msg_t* MsgPtr)
 
         case GPS_KALMAN_RESET_CC:
             GPS_KALMAN_InitData(); // zero all the filters and the input and output structs
+            GPS_KALMAN_ManageTable(TRUE); // and go back to the loaded parameters
+            g_GPS_KALMAN_AppData.bCdsDirty = TRUE; // so the checkpoint is cleared too
             g_GPS_KALMAN_AppData.HkTlm.usCmdCnt = 0;
             g_GPS_KALMAN_AppData.HkTlm.usCmdErrCnt = 0;
             CFE_EVS_SendEvent(GPS_KALMAN_CMD_INF_EID, CFE_EVS_INFORMATION, "GPS_KALMAN - Recvd RESET cmd (%d)", cmdCode);
             break;
 
+        case GPS_KALMAN_RESET_STATS_CC:
+            if (GPS_KALMAN_VerifyCmdLength(MsgPtr, sizeof(GPS_KALMAN_NoArgCmd_t)))
+            {
+                for (i = 0; i < GPS_KALMAN_STAGE_CNT; i++)
+                {
+                    GPS_KALMAN_Stats_Reset(&g_GPS_KALMAN_AppData.StageStats[i]);
+                }
+                g_GPS_KALMAN_AppData.HkTlm.usCmdCnt++;
+                CFE_EVS_SendEvent(GPS_KALMAN_CMD_INF_EID, CFE_EVS_INFORMATION, "GPS_KALMAN - Recvd RESET_STATS cmd (%d)", cmdCode);
+            }
+            break;
+
+        case GPS_KALMAN_SET_DIAG_CC:
+            if (GPS_KALMAN_VerifyCmdLength(MsgPtr, sizeof(GPS_KALMAN_SetDiagCmd_t)))
+            {
+                GPS_KALMAN_SetDiagCmd_t *DiagCmdPtr = (GPS_KALMAN_SetDiagCmd_t *) MsgPtr;
+
+                g_GPS_KALMAN_AppData.ucDiagMode = DiagCmdPtr->ucDiagMode &
+                        (GPS_KALMAN_DIAG_TLM | GPS_KALMAN_DIAG_SUMMARY);
+                if (DiagCmdPtr->usSummaryPeriod != 0)
+                {
+                    g_GPS_KALMAN_AppData.usSummaryPeriod = DiagCmdPtr->usSummaryPeriod;
+                }
+                g_GPS_KALMAN_AppData.HkTlm.usCmdCnt++;
+                CFE_EVS_SendEvent(GPS_KALMAN_CMD_INF_EID, CFE_EVS_INFORMATION,
+                        "GPS_KALMAN - Recvd SET_DIAG cmd (%d), mode 0x%02X, summary every %u cycles",
+                        cmdCode, g_GPS_KALMAN_AppData.ucDiagMode,
+                        g_GPS_KALMAN_AppData.usSummaryPeriod);
+            }
+            break;
+
         /* TODO:  Add code to process the rest of the GPS_KALMAN commands here */
 
         default:
@@ -890,161 +1354,159 @@ void GPS_KALMAN_ProcessNewAppCmds(CFE_SB_Msg_t* MsgPtr)
 }
 
 /*=====================================================================================
-** Name: GPS_KALMAN_RunFilter
+** Name: GPS_KALMAN_ValidateParamTbl
 **
-** Purpose: Run the Kalman Filter
+** Purpose: To range check a filter parameter table before table services accept it
 **
 ** Arguments:
-**    None
+**    void* TblPtr - table to check, a GPS_KALMAN_ParamTbl_t
 **
 ** Returns:
-**    None
+**    int32 iStatus - CFE_SUCCESS, or GPS_KALMAN_PARAM_TBL_INVALID
 **
 ** Routines Called:
-**    - GSL vector and matrix math
+**    GPS_KALMAN_Core_CheckParams
+**    CFE_EVS_SendEvent
 **
 ** Called By:
-**    GPS_KALMAN_ProcessNewData
+**    Table services, on CFE_TBL_Load and on validate commands
 **
 ** Global Inputs/Reads:
-**    - The kalman related vectors and matrices
+**    None
 **
 ** Global Outputs/Writes:
-**    - The kalman related vectors and matrices
+**    None
 **
 ** Limitations, Assumptions, External Events, and Notes:
-**    1. List assumptions that are made that apply to this function.
-**    2. List the external source(s) and event(s) that can cause this function to execute.
-**    3. List known limitations that apply to this function.
-**    4. If there are no assumptions, external events, or notes then enter NONE.
-**       Do not omit the section.
+**    1. A rejected table never reaches the filter; the one in use stays
 **
 ** Algorithm:
-**    Runs a kalman filter on latitude, longitude, and velocity
+**    None
 **
-** Author(s):  Jacob Killelea
+** Author(s):  GPS_KALMAN Team
 **
-** History:  Date Written  2019-07-11
+** History:  Date Written  2026-10-17
 **           Unit Tested   yyyy-mm-dd
 **=====================================================================================*/
-int32 GPS_KALMAN_RunFilter(void) {
-    int32 status = CFE_SUCCESS;
-    int signum;
-    double measured_lat = g_GPS_KALMAN_AppData.InData.gpsLat;
-    double measured_lon = g_GPS_KALMAN_AppData.InData.gpsLon;
-    double measured_vel = g_GPS_KALMAN_AppData.InData.gpsVel;
-    double measured_dop = g_GPS_KALMAN_AppData.InData.gpsDOP;
-
-    /* TODO: calculate delta t, initalize all matrices */
-
-    /* Initialize state vector with last filter results */
-    gsl_vector_set(XHat, 0, g_GPS_KALMAN_AppData.OutData.filterLat);
-    gsl_vector_set(XHat, 1, g_GPS_KALMAN_AppData.OutData.filterLon);
-    gsl_vector_set(XHat, 2, g_GPS_KALMAN_AppData.OutData.filterVel);
-
-    /* Predict the next state */
-    /* DGEMV: y = alpha*op(A)*x + Beta*y */
-    /* With CblasNoTrans, op(A) = A */
-    /* x_k+1 = F_k * x_k */
-    gsl_blas_dgemv(CblasNoTrans, 1.0, FMatrix, XHat, 0.0, XHatNext);
-
-    /* Next covariance: P = F * P * F' + Q */
-    /* DGEMM: C = alpha*opa(A)*opb(B) + beta*C */
-    /* P = 1:(F * P) * F' + Q <- TODO: check matrix order of operations. Should (P * F') be first?*/
-    gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, FMatrix, PMatrix, 0.0, TmpMatrix);
-    /* P = 2:(1:(tmp) * F') + Q */
-    gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, TmpMatrix, FMatrix, 0.0, PMatrix);
-    /* P = 3:(2:(1:(tmp) * F') + Q) */
-    gsl_matrix_add(PMatrix, QMatrix);
-
-    /* If GPS data is available, run the update section of the kalman algorithm */
-    if (g_GPS_KALMAN_AppData.InData.gpsFixOk)
+int32 GPS_KALMAN_ValidateParamTbl(void* TblPtr)
+{
+    int32  iStatus = CFE_SUCCESS;
+    const char *bad = GPS_KALMAN_Core_CheckParams((const GPS_KALMAN_ParamTbl_t *) TblPtr);
+
+    if (bad != NULL)
     {
-        /* MuExpected = H * XHatNext */
-        gsl_blas_dgemv(CblasNoTrans, 1.0, HMatrix, XHatNext, 0.0, MuExpected);
-        /* SigmaExpectMatrix = H * P * H' */
-        /* SigmaExpectMatrix = 1:(H * P) * H' */
-        gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, HMatrix, PMatrix,
-                0.0, TmpMatrix);
-        /* SigmaExpectMatrix = 2:(1:(tmp) * H') */
-        gsl_blas_dgemm(CblasNoTrans, CblasTrans,   1.0, TmpMatrix, HMatrix,
-                0.0, SigmaExpectMatrix);
-
-        /* MuActual = Actual measurement */
-        gsl_vector_set(MuActual, 0, measured_lat);
-        gsl_vector_set(MuActual, 1, measured_lon);
-        gsl_vector_set(MuActual, 2, measured_vel);
-
-        /* SigmaActualMatrix has DOP for lat and lon currently, 0.1 for speed */
-        gsl_matrix_set_identity(SigmaActualMatrix);
-        gsl_matrix_scale(SigmaActualMatrix, abs(measured_dop));
-        gsl_matrix_set(SigmaActualMatrix, 2, 2, 0.1);
-
-        /* K = SigmaExpectMatrix * (SigmaExpectMatrix + SigmaActualMatrix)^-1 */
-        /* (1) K = SigmaExpectMatrix * (1:(SigmaExpectMatrix + SigmaActualMatrix))^-1 */
-        gsl_matrix_memcpy(TmpMatrix, SigmaExpectMatrix); /* tmp <-  sigma0 */
-        gsl_matrix_add(SigmaExpectMatrix, SigmaActualMatrix); /* sigma0 <- sigma0 + sigma1 */
-        gsl_matrix_swap(TmpMatrix, SigmaExpectMatrix); /* sigma0 <-> tmp */
-
-        /*  TmpMatrix = $1 = SigmaExpectMatrix + SigmaActualMatrix */
-        /* (2) K = SigmaExpectMatrix * 2:($1^-1) */
-        gsl_linalg_LU_decomp(TmpMatrix, GSLPermutation, &signum);
-        gsl_linalg_LU_invert(TmpMatrix, GSLPermutation, TmpMatrix2);
-
-        /* TmpMatrix2 = $2 */
-        /* (3) K = 3:(SigmaExpectMatrix * $2) */
-        gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, SigmaExpectMatrix, TmpMatrix2,
-                0.0, KMatrix);
-
-        /* state_next = state_next + K * (mu1 - mu0) */
-        /* (1) state_next = state_next + K * 1:(mu1 - mu0) */
-        gsl_vector_sub(MuActual, MuExpected);
-        /* mu1 = $1 */
-        /* (2) state_next = 2:(K * 1:(mu1 - mu0) + state_next) */
-        gsl_blas_dgemv(CblasNoTrans, 1.0, KMatrix, MuActual, 1.0, XHatNext);
-
-        /* P = K * H * P - P */
-        /* (1) P = K * 1:(H * P) - P */
-        gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, HMatrix, PMatrix,
-                0.0, TmpMatrix);
-        /* TmpMatrix = $1 */
-        /* (2) P = 2:(K * 1:(H * P) - P) */
-        gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, -1.0, KMatrix, TmpMatrix,
-                1.0, PMatrix);
+        CFE_EVS_SendEvent(GPS_KALMAN_ILOAD_ERR_EID, CFE_EVS_ERROR,
+                "GPS_KALMAN - Parameter table rejected, %s out of range", bad);
+        iStatus = GPS_KALMAN_PARAM_TBL_INVALID;
     }
 
-    /* state <- state_next */
-    gsl_vector_memcpy(XHat, XHatNext);
-
-    g_GPS_KALMAN_AppData.OutData.filterLat = gsl_vector_get(XHatNext, 0);
-    g_GPS_KALMAN_AppData.OutData.filterLon = gsl_vector_get(XHatNext, 1);
-    g_GPS_KALMAN_AppData.OutData.filterVel = gsl_vector_get(XHatNext, 2);
-
-    return status;
+    return (iStatus);
 }
 
 /*=====================================================================================
-** Name: GPS_KALMAN_ReportHousekeeping
+** Name: GPS_KALMAN_ManageTable
 **
-** Purpose: To send housekeeping message
+** Purpose: To give table services a chance to update the parameter table, and pass a
+**          new one to the filter
 **
 ** Arguments:
-**    None
+**    boolean bForce - pass the table to the filter even if it has not changed
 **
 ** Returns:
 **    None
 **
 ** Routines Called:
-**    TBD
+**    CFE_TBL_Manage
+**    CFE_TBL_GetAddress
+**    CFE_TBL_ReleaseAddress
+**    CFE_EVS_SendEvent
+**    GPS_KALMAN_Core_SetParams
 **
 ** Called By:
-**    GPS_KALMAN_ProcessNewCmds
-**
+**    GPS_KALMAN_RcvMsg
+**    GPS_KALMAN_InitTable
+**    GPS_KALMAN_ProcessNewAppCmds
+**
 ** Global Inputs/Reads:
+**    g_GPS_KALMAN_AppData.ParamTblHdl
+**
+** Global Outputs/Writes:
+**    g_GPS_KALMAN_AppData.Core
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. Runs once per wakeup, so a load takes effect on the next cycle. The filter
+**       state is kept; only the tuning changes.
+**    2. The table address is held only while it is copied, so table services can
+**       update it at any other time. Nothing is recomputed unless it changed.
+**
+** Algorithm:
 **    None
 **
+** Author(s):  GPS_KALMAN Team
+**
+** History:  Date Written  2026-10-17
+**           Unit Tested   yyyy-mm-dd
+**=====================================================================================*/
+void GPS_KALMAN_ManageTable(boolean bForce)
+{
+    int32  iStatus;
+    GPS_KALMAN_ParamTbl_t *TblPtr = NULL;
+
+    CFE_TBL_Manage(g_GPS_KALMAN_AppData.ParamTblHdl);
+
+    iStatus = CFE_TBL_GetAddress((void**) &TblPtr, g_GPS_KALMAN_AppData.ParamTblHdl);
+    if ((iStatus == CFE_TBL_INFO_UPDATED) || (bForce && (iStatus == CFE_SUCCESS)))
+    {
+        GPS_KALMAN_Core_SetParams(&g_GPS_KALMAN_AppData.Core, TblPtr);
+        if (iStatus == CFE_TBL_INFO_UPDATED)
+        {
+            CFE_EVS_SendEvent(GPS_KALMAN_ILOAD_INF_EID, CFE_EVS_INFORMATION,
+                    "GPS_KALMAN - Parameter table applied: GPS 0 UERE %.2f m, vel sigma "
+                    "%.3f m/s, accel PSD %.3f m^2/s^3",
+                    TblPtr->source[0].uereM, TblPtr->source[0].velSigmaMps,
+                    TblPtr->accelPsd);
+        }
+    }
+    /* Otherwise there is no table yet, and the filter keeps the parameters it has */
+
+    CFE_TBL_ReleaseAddress(g_GPS_KALMAN_AppData.ParamTblHdl);
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_RunFilter
+**
+** Purpose: Run the Kalman Filter
+**
+** Arguments:
+**    uint32 uiSource - receiver whose fix to filter
+**
+** Returns:
+**    int32 - GPS_KALMAN_CORE_SKIP if the filter did not move: no new good fix, or
+**            one GPS_KALMAN_Core_Prepare skipped. Otherwise CFE_SUCCESS, or the
+**            GPS_KALMAN_FILTER_ERR_* of an update that was not used, after which
+**            the state is the prediction to the fix.
+**
+** Routines Called:
+**    - GPS_KALMAN_Core_Prepare
+**    - GPS_KALMAN_Core_Predict
+**    - GPS_KALMAN_Core_Update
+**    - GPS_KALMAN_Smooth_Predicted
+**    - GPS_KALMAN_Smooth_Filtered
+**    - GPS_KALMAN_SendSmoothData
+**
+** Called By:
+**    GPS_KALMAN_ProcessNewData (GPS_KALMAN_UPDATE_EVERY_FIX), GPS_KALMAN_RunNewest
+**    otherwise, or GPS_KALMAN_RcvMsg (GPS_KALMAN_EVENT_DRIVEN)
+**
+** Global Inputs/Reads:
+**    - g_GPS_KALMAN_AppData.Core, the filter instance
+**
 ** Global Outputs/Writes:
-**    TBD
+**    - g_GPS_KALMAN_AppData.Core, the filter instance
+**    - g_GPS_KALMAN_AppData.Smooth, the fixed-lag smoother
+**    - g_GPS_KALMAN_AppData.HkTlm, the innovation gate, steady-state gain and
+**      receiver counters
+**    - g_GPS_KALMAN_AppData.bFixSinceWakeup, so the wakeup's output is not coasted
 **
 ** Limitations, Assumptions, External Events, and Notes:
 **    1. List assumptions that are made that apply to this function.
@@ -1054,43 +1516,510 @@ int32 GPS_KALMAN_RunFilter(void) {
 **       Do not omit the section.
 **
 ** Algorithm:
-**    Psuedo-code or description of basic algorithm
+**    Runs a constant velocity kalman filter on north/east position and velocity in
+**    a local tangent plane anchored at the first good fix, in metres and m/s. It
+**    runs once per new good fix: predict over the time since the previous fix, then
+**    update. F and Q are rebuilt only when that time step changes. The first fix, or
+**    the first one after a gap of more than the parameter table's maxDtSec,
+**    initialises the state and the anchor; a fix more than its enuMaxRangeM from the
+**    anchor moves it. Latitude and longitude are only formed for the published
+**    output, by GPS_KALMAN_SendOutData.
+**
+**    A fix whose innovation is outside the table's gateChi2 is not used; the state
+**    carries on from the prediction, and gateMaxRejects of them in a row restart it.
+**
+**    Every receiver's fixes go through the one filter, each an update of its own,
+**    weighted by that receiver's noise model in the table and dated by its time
+**    stamp less the receiver's latency. Fusing them one at a time needs no joint
+**    measurement of all receivers, and no larger matrix to invert.
+**
+**    With the table's steadyGainTol set, a gain that has settled at a fixed rate and
+**    noise model is frozen and the fixes take state-only steps, until one arrives
+**    with another time step or is gated. A DOP change switches to the frozen gain
+**    for the new DOP if one is cached, else the full filter resumes until it settles.
+**
+**    Each prediction and update is also handed to the fixed-lag smoother, which
+**    publishes a smoothed estimate GPS_KALMAN_SMOOTH_LAG fixes back once it has one.
+**
+**    The filter itself is the cFE-free core in gps_kalman_core.c; this function
+**    feeds it the fix decoded in InData and fills the diagnostics and stage timing.
 **
-** Author(s):  GSFC, Jacob Killelea
+** Author(s):  Jacob Killelea
 **
-** History:  Date Written  2019-06-28
+** History:  Date Written  2019-07-11
 **           Unit Tested   yyyy-mm-dd
 **=====================================================================================*/
-void GPS_KALMAN_ReportHousekeeping()
+int32 GPS_KALMAN_RunFilter(uint32 uiSource) {
+    const GPS_KALMAN_Data_t *data = &g_GPS_KALMAN_AppData.Core.data;
+    GPS_KALMAN_InData_t *InPtr = &g_GPS_KALMAN_AppData.InData[uiSource];
+    int32 status = GPS_KALMAN_CORE_SKIP;
+    int   i;
+    boolean restart;
+
+    /* Only a new, good fix moves the filter; it runs at the fix time stamps */
+    if (!InPtr->gpsNew || !InPtr->gpsFixOk)
+    {
+        goto GPS_KALMAN_RunFilter_Exit_Tag;
+    }
+    InPtr->gpsNew = FALSE;
+    g_GPS_KALMAN_AppData.uiSummaryFixes++;
+
+    status = GPS_KALMAN_Core_Prepare(&g_GPS_KALMAN_AppData.Core, &InPtr->gpsFix);
+    if (status == GPS_KALMAN_CORE_SKIP)
+    {
+        goto GPS_KALMAN_RunFilter_Exit_Tag;
+    }
+    g_GPS_KALMAN_AppData.bCdsDirty = TRUE;
+    g_GPS_KALMAN_AppData.bFixSinceWakeup = TRUE;
+
+    restart = (status == GPS_KALMAN_CORE_RESTART);
+    if (restart)
+    {
+        g_GPS_KALMAN_AppData.HkTlm.uiSourceUsedCnt[uiSource]++;
+        status = CFE_SUCCESS;
+        memset((void*) g_GPS_KALMAN_AppData.DiagTlm.innovation, 0x00,
+                sizeof(g_GPS_KALMAN_AppData.DiagTlm.innovation));
+        goto GPS_KALMAN_RunFilter_Publish_Tag;
+    }
+
+    GPS_KALMAN_StageEntry(GPS_KALMAN_STAGE_PREDICT);
+    GPS_KALMAN_Core_Predict(&g_GPS_KALMAN_AppData.Core);
+    GPS_KALMAN_StageExit(GPS_KALMAN_STAGE_PREDICT);
+#if GPS_KALMAN_SMOOTH_LAG
+    GPS_KALMAN_Smooth_Predicted(&g_GPS_KALMAN_AppData.Smooth, &g_GPS_KALMAN_AppData.Core);
+#endif
+
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        g_GPS_KALMAN_AppData.DiagTlm.innovation[i] =
+                GPS_KALMAN_R2D(data->MuActualData[i]) - GPS_KALMAN_R2D(data->XHatData[i]);
+    }
+
+    GPS_KALMAN_StageEntry(GPS_KALMAN_STAGE_UPDATE);
+    status = GPS_KALMAN_Core_Update(&g_GPS_KALMAN_AppData.Core);
+    GPS_KALMAN_StageExit(GPS_KALMAN_STAGE_UPDATE);
+    if (status == GPS_KALMAN_FILTER_SUCCESS)
+    {
+        g_GPS_KALMAN_AppData.HkTlm.uiSourceUsedCnt[uiSource]++;
+        if (g_GPS_KALMAN_AppData.Core.steadyStep)
+        {
+            g_GPS_KALMAN_AppData.HkTlm.uiSteadyCnt++;
+        }
+    }
+    else if (status == GPS_KALMAN_FILTER_ERR_GATED)
+    {
+        /* An outlier: the state carries on from the prediction. Outliers come in
+        ** bursts, so only giving up on the state raises an event. */
+        g_GPS_KALMAN_AppData.HkTlm.uiGateRejectCnt++;
+        g_GPS_KALMAN_AppData.uiSummaryRejects++;
+        if (g_GPS_KALMAN_AppData.Core.rejects >= g_GPS_KALMAN_AppData.Core.params.gateMaxRejects)
+        {
+            g_GPS_KALMAN_AppData.HkTlm.uiGateRestartCnt++;
+            CFE_EVS_SendEvent(GPS_KALMAN_ERR_EID, CFE_EVS_ERROR,
+                    "GPS_KALMAN - %u fixes in a row outside the innovation gate, "
+                    "restarting at the next fix",
+                    g_GPS_KALMAN_AppData.Core.rejects);
+        }
+    }
+    else if (status != GPS_KALMAN_FILTER_SUCCESS)
+    {
+        CFE_EVS_SendEvent(GPS_KALMAN_ERR_EID, CFE_EVS_ERROR,
+                "GPS_KALMAN - Innovation covariance not positive definite, update skipped");
+        g_GPS_KALMAN_AppData.uiSummaryRejects++;
+    }
+
+GPS_KALMAN_RunFilter_Publish_Tag:
+#if GPS_KALMAN_SMOOTH_LAG
+    /* A restart starts the smoother over too */
+    if (GPS_KALMAN_Smooth_Filtered(&g_GPS_KALMAN_AppData.Smooth, &g_GPS_KALMAN_AppData.Core))
+    {
+        GPS_KALMAN_SendSmoothData();
+    }
+#endif
+
+    /* Binary diagnostics are cheap copies; SendDiag decides whether they go out */
+    g_GPS_KALMAN_AppData.DiagTlm.ucFixOk      = (uint8) InPtr->gpsFixOk;
+    g_GPS_KALMAN_AppData.DiagTlm.ucFilterInit = (uint8) restart;
+    g_GPS_KALMAN_AppData.DiagTlm.sFilterStatus = (int16) status;
+    g_GPS_KALMAN_AppData.DiagTlm.ucSource     = (uint8) uiSource;
+    g_GPS_KALMAN_AppData.DiagTlm.dt    = g_GPS_KALMAN_AppData.Core.dt;
+    g_GPS_KALMAN_AppData.DiagTlm.innovationD2 = restart ? 0.0 : g_GPS_KALMAN_AppData.Core.d2;
+    g_GPS_KALMAN_AppData.DiagTlm.inLat = InPtr->gpsFix.lat;
+    g_GPS_KALMAN_AppData.DiagTlm.inLon = InPtr->gpsFix.lon;
+    g_GPS_KALMAN_AppData.DiagTlm.inVel = InPtr->gpsFix.vel;
+    g_GPS_KALMAN_AppData.DiagTlm.inHdg = InPtr->gpsFix.hdg;
+    g_GPS_KALMAN_AppData.DiagTlm.inDOP = InPtr->gpsFix.dop;
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        g_GPS_KALMAN_AppData.DiagTlm.innovationVar[i] = restart ? 0.0 :
+                GPS_KALMAN_R2D(data->SigmaExpectMatrixData[GPS_KALMAN_SYM_IDX(i, i)]);
+        g_GPS_KALMAN_AppData.DiagTlm.stateVar[i] =
+                GPS_KALMAN_R2D(data->PMatrixData[GPS_KALMAN_SYM_IDX(i, i)]);
+    }
+
+GPS_KALMAN_RunFilter_Exit_Tag:
+    return status;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_RunNewest
+**
+** Purpose: To run the filter on the newest fix of each receiver
+**
+** Arguments:
+**    None
+**
+** Returns:
+**    None
+**
+** Routines Called:
+**    GPS_KALMAN_RunFilter
+**
+** Called By:
+**    GPS_KALMAN_RcvMsg (GPS_KALMAN_UPDATE_EVERY_FIX 0)
+**
+** Global Inputs/Reads:
+**    g_GPS_KALMAN_AppData.InData
+**    g_GPS_KALMAN_AppData.Core.params, the receiver latencies
+**
+** Global Outputs/Writes:
+**    None
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. The fixes go in the order they were taken, as the filter skips a fix older
+**       than its state
+**
+** Algorithm:
+**    Repeatedly filter the oldest new good fix, by time stamp less the receiver's
+**    latency, until none is left
+**
+** Author(s):  GPS_KALMAN Team
+**
+** History:  Date Written  2026-10-17
+**           Unit Tested   yyyy-mm-dd
+**=====================================================================================*/
+void GPS_KALMAN_RunNewest(void)
 {
-    /* TODO:  Add code to update housekeeping data, if needed, here.  */
+    const GPS_KALMAN_InData_t *InData = g_GPS_KALMAN_AppData.InData;
+    const GPS_KALMAN_SourceParams_t *src = g_GPS_KALMAN_AppData.Core.params.source;
+    uint32 uiOldest;
+    uint32 i;
 
-    CFE_SB_TimeStampMsg((CFE_SB_Msg_t*) &g_GPS_KALMAN_AppData.HkTlm);
-    CFE_SB_SendMsg((CFE_SB_Msg_t*) &g_GPS_KALMAN_AppData.HkTlm);
+    do
+    {
+        uiOldest = GPS_KALMAN_SOURCE_CNT;
+        for (i = 0; i < GPS_KALMAN_SOURCE_CNT; i++)
+        {
+            if (InData[i].gpsNew && InData[i].gpsFixOk &&
+                ((uiOldest == GPS_KALMAN_SOURCE_CNT) ||
+                 (InData[i].gpsFix.time - src[i].latencySec <
+                  InData[uiOldest].gpsFix.time - src[uiOldest].latencySec)))
+            {
+                uiOldest = i;
+            }
+        }
+        if (uiOldest < GPS_KALMAN_SOURCE_CNT)
+        {
+            GPS_KALMAN_RunFilter(uiOldest);
+        }
+    } while (uiOldest < GPS_KALMAN_SOURCE_CNT);
 }
 
 /*=====================================================================================
-** Name: GPS_KALMAN_SendOutData
+** Name: GPS_KALMAN_TimeToSec
 **
-** Purpose: To publish 1-Wakeup cycle output data
+** Purpose: To express a cFE time stamp in seconds for the filter core
 **
 ** Arguments:
+**    CFE_TIME_SysTime_t t     - time stamp
+**
+** Returns:
+**    double - seconds from the cFE epoch
+**
+** Routines Called:
 **    None
 **
+** Called By:
+**    GPS_KALMAN_ProcessGpsInfo
+**    GPS_KALMAN_Coast
+**
+** Global Inputs/Reads:
+**    None
+**
+** Global Outputs/Writes:
+**    None
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. A double resolves about 0.25 us at today's cFE seconds count, far below
+**       the dtQuantumSec a parameter table may set
+**
+** Algorithm:
+**    seconds + subseconds * 2^-32
+**
+** Author(s):  GPS_KALMAN Team
+**
+** History:  Date Written  2026-10-17
+**           Unit Tested   yyyy-mm-dd
+**=====================================================================================*/
+double GPS_KALMAN_TimeToSec(CFE_TIME_SysTime_t t)
+{
+    return ((double) t.Seconds) + ((double) t.Subseconds) * (1.0 / 4294967296.0);
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Coast
+**
+** Purpose: To set the published position, its error and its quality, extrapolated
+**          to the current time when no fix has arrived
+**
+** Arguments:
+**    GPS_KALMAN_OutData_t *OutPtr - output message, holding the estimate at the last fix
+**    boolean bCoast               - extrapolate to now, else give the last fix's
+**
 ** Returns:
 **    None
 **
 ** Routines Called:
-**    TBD
+**    CFE_TIME_GetTime
+**    GPS_KALMAN_TimeToSec
+**    GPS_KALMAN_Core_Coast
+**
+** Called By:
+**    GPS_KALMAN_SendOutData
+**
+** Global Inputs/Reads:
+**    g_GPS_KALMAN_AppData.Core
+**
+** Global Outputs/Writes:
+**    None
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. The filter state is not changed: the next fix still predicts from the time
+**       of the last one, so a fix that is older than the coast time is not lost
+**    2. Nothing is extrapolated past the parameter table's coastMaxSec. The output
+**       is then held and flagged GPS_KALMAN_QUALITY_STALE, so a consumer can drop
+**       it on the quality alone.
+**
+** Algorithm:
+**    position = position + velocity * (now - last fix), speed and heading held, and
+**    the position error grown in closed form by GPS_KALMAN_Core_Coast
+**
+** Author(s):  GPS_KALMAN Team
+**
+** History:  Date Written  2026-10-17
+**           Unit Tested   yyyy-mm-dd
+**=====================================================================================*/
+void GPS_KALMAN_Coast(GPS_KALMAN_OutData_t *OutPtr, boolean bCoast)
+{
+    double dTime = g_GPS_KALMAN_AppData.Core.lastFixTime;
+
+    if (bCoast)
+    {
+        dTime = GPS_KALMAN_TimeToSec(CFE_TIME_GetTime());
+    }
+    OutPtr->ucQuality = (uint8) GPS_KALMAN_Core_Coast(&g_GPS_KALMAN_AppData.Core, dTime,
+            &OutPtr->filterLat, &OutPtr->filterLon,
+            &OutPtr->filterSigmaN, &OutPtr->filterSigmaE);
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_StageEntry
+**
+** Purpose: To mark the start of a timed stage
+**
+** Arguments:
+**    uint32 stage - GPS_KALMAN_STAGE_*
+**
+** Returns:
+**    None
+**
+** Routines Called:
+**    CFE_ES_PerfLogEntry
+**    GPS_KALMAN_Stats_NowNs
 **
 ** Called By:
 **    GPS_KALMAN_RcvMsg
+**    GPS_KALMAN_RunFilter
 **
 ** Global Inputs/Reads:
 **    None
 **
 ** Global Outputs/Writes:
-**    TBD
+**    g_GPS_KALMAN_AppData.StageStartNs
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. Each stage has its own ES perf ID, so the same spans also show up in the
+**       ES performance log
+**    2. A stage must not be entered again before it exits
+**
+** Algorithm:
+**    None
+**
+** Author(s):  GPS_KALMAN Team
+**
+** History:  Date Written  2026-10-17
+**           Unit Tested   yyyy-mm-dd
+**=====================================================================================*/
+void GPS_KALMAN_StageEntry(uint32 stage)
+{
+    CFE_ES_PerfLogEntry(g_GPS_KALMAN_StagePerfIds[stage]);
+    g_GPS_KALMAN_AppData.StageStartNs[stage] = GPS_KALMAN_Stats_NowNs();
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_StageExit
+**
+** Purpose: To mark the end of a timed stage and add its time to the statistics
+**
+** Arguments:
+**    uint32 stage - GPS_KALMAN_STAGE_*
+**
+** Returns:
+**    None
+**
+** Routines Called:
+**    CFE_ES_PerfLogExit
+**    GPS_KALMAN_Stats_NowNs
+**    GPS_KALMAN_Stats_Add
+**
+** Called By:
+**    GPS_KALMAN_RcvMsg
+**    GPS_KALMAN_RunFilter
+**
+** Global Inputs/Reads:
+**    g_GPS_KALMAN_AppData.StageStartNs
+**
+** Global Outputs/Writes:
+**    g_GPS_KALMAN_AppData.StageStats
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    None
+**
+** Algorithm:
+**    None
+**
+** Author(s):  GPS_KALMAN Team
+**
+** History:  Date Written  2026-10-17
+**           Unit Tested   yyyy-mm-dd
+**=====================================================================================*/
+void GPS_KALMAN_StageExit(uint32 stage)
+{
+    GPS_KALMAN_Stats_Add(&g_GPS_KALMAN_AppData.StageStats[stage],
+            GPS_KALMAN_Stats_NowNs() - g_GPS_KALMAN_AppData.StageStartNs[stage]);
+    CFE_ES_PerfLogExit(g_GPS_KALMAN_StagePerfIds[stage]);
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_SaveCds
+**
+** Purpose: To write the filter state checkpoint to the Critical Data Store
+**
+** Arguments:
+**    boolean bForce - write now if the state changed, regardless of the period
+**
+** Returns:
+**    None
+**
+** Routines Called:
+**    CFE_ES_CopyToCDS
+**    CFE_EVS_SendEvent
+**    GPS_KALMAN_Core_Save
+**
+** Called By:
+**    GPS_KALMAN_RcvMsg
+**    GPS_KALMAN_AppMain
+**
+** Global Inputs/Reads:
+**    g_GPS_KALMAN_AppData.Core
+**    g_GPS_KALMAN_AppData.CdsHdl
+**
+** Global Outputs/Writes:
+**    g_GPS_KALMAN_AppData.bCdsDirty
+**    g_GPS_KALMAN_AppData.bCdsSaveFailed
+**    g_GPS_KALMAN_AppData.usCdsCycles
+**    g_GPS_KALMAN_AppData.Checkpoint
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. Runs once per wakeup. The CDS copy and its CRC cost far more than a filter
+**       step, so the state is written only when it has changed, and then at most
+**       once every GPS_KALMAN_CDS_SAVE_PERIOD wakeups. A restart loses at most that
+**       many wakeups of filtering.
+**    2. A failed write is retried at the next period; only the first failure after a
+**       good write raises an event
+**
+** Algorithm:
+**    None
+**
+** Author(s):  GPS_KALMAN Team
+**
+** History:  Date Written  2026-10-17
+**           Unit Tested   yyyy-mm-dd
+**=====================================================================================*/
+void GPS_KALMAN_SaveCds(boolean bForce)
+{
+    int32  iStatus;
+
+    if (!g_GPS_KALMAN_AppData.bCdsEnabled)
+    {
+        goto GPS_KALMAN_SaveCds_Exit_Tag;
+    }
+
+    if (g_GPS_KALMAN_AppData.usCdsCycles < GPS_KALMAN_CDS_SAVE_PERIOD)
+    {
+        g_GPS_KALMAN_AppData.usCdsCycles++;
+    }
+    if (!g_GPS_KALMAN_AppData.bCdsDirty ||
+        (!bForce && (g_GPS_KALMAN_AppData.usCdsCycles < GPS_KALMAN_CDS_SAVE_PERIOD)))
+    {
+        goto GPS_KALMAN_SaveCds_Exit_Tag;
+    }
+
+    GPS_KALMAN_Core_Save(&g_GPS_KALMAN_AppData.Core, &g_GPS_KALMAN_AppData.Checkpoint);
+    iStatus = CFE_ES_CopyToCDS(g_GPS_KALMAN_AppData.CdsHdl, &g_GPS_KALMAN_AppData.Checkpoint);
+    g_GPS_KALMAN_AppData.usCdsCycles = 0;
+    if (iStatus == CFE_SUCCESS)
+    {
+        g_GPS_KALMAN_AppData.bCdsDirty      = FALSE;
+        g_GPS_KALMAN_AppData.bCdsSaveFailed = FALSE;
+    }
+    else if (!g_GPS_KALMAN_AppData.bCdsSaveFailed)
+    {
+        g_GPS_KALMAN_AppData.bCdsSaveFailed = TRUE;
+        CFE_EVS_SendEvent(GPS_KALMAN_CDS_ERR_EID, CFE_EVS_ERROR,
+                "GPS_KALMAN - Failed to save the filter state to the CDS (0x%08X)", iStatus);
+    }
+
+GPS_KALMAN_SaveCds_Exit_Tag:
+    return;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_ReportHousekeeping
+**
+** Purpose: To send housekeeping message
+**
+** Arguments:
+**    None
+**
+** Returns:
+**    None
+**
+** Routines Called:
+**    GPS_KALMAN_Stats_MeanNs
+**    GPS_KALMAN_Stats_PercentileNs
+**    CFE_SB_TimeStampMsg
+**    CFE_SB_SendMsg
+**
+** Called By:
+**    GPS_KALMAN_ProcessNewCmds
+**
+** Global Inputs/Reads:
+**    g_GPS_KALMAN_AppData.StageStats, and the gain cache counts of
+**    g_GPS_KALMAN_AppData.Core
+**
+** Global Outputs/Writes:
+**    g_GPS_KALMAN_AppData.HkTlm
 **
 ** Limitations, Assumptions, External Events, and Notes:
 **    1. List assumptions that are made that apply to this function.
@@ -1102,26 +2031,313 @@ void GPS_KALMAN_ReportHousekeeping()
 ** Algorithm:
 **    Psuedo-code or description of basic algorithm
 **
+** Author(s):  GSFC, Jacob Killelea
+**
+** History:  Date Written  2019-06-28
+**           Unit Tested   yyyy-mm-dd
+**=====================================================================================*/
+void GPS_KALMAN_ReportHousekeeping()
+{
+    uint32 i;
+
+    for (i = 0; i < GPS_KALMAN_STAGE_CNT; i++)
+    {
+        const GPS_KALMAN_Stats_t *stats = &g_GPS_KALMAN_AppData.StageStats[i];
+        GPS_KALMAN_StageTlm_t *tlm = &g_GPS_KALMAN_AppData.HkTlm.Stage[i];
+
+        tlm->uiCount  = stats->count;
+        tlm->uiMinNs  = (stats->count == 0) ? 0 : stats->minNs;
+        tlm->uiMaxNs  = stats->maxNs;
+        tlm->uiMeanNs = GPS_KALMAN_Stats_MeanNs(stats);
+        tlm->uiP99Ns  = GPS_KALMAN_Stats_PercentileNs(stats, 99);
+    }
+
+    g_GPS_KALMAN_AppData.HkTlm.uiGainCacheHitCnt  = g_GPS_KALMAN_AppData.Core.gainHits;
+    g_GPS_KALMAN_AppData.HkTlm.uiGainCacheMissCnt = g_GPS_KALMAN_AppData.Core.gainMisses;
+
+    CFE_SB_TimeStampMsg((CFE_SB_Msg_t*) &g_GPS_KALMAN_AppData.HkTlm);
+    CFE_SB_SendMsg((CFE_SB_Msg_t*) &g_GPS_KALMAN_AppData.HkTlm);
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_SendOutData
+**
+** Purpose: To publish 1-Wakeup cycle output data
+**
+** Arguments:
+**    boolean bCoast - extrapolate the position to now, when no fix has arrived
+**
+** Returns:
+**    None
+**
+** Routines Called:
+**    CFE_SB_ZeroCopyGetPtr
+**    CFE_SB_InitMsg
+**    CFE_SB_TimeStampMsg
+**    CFE_SB_ZeroCopySend
+**    CFE_SB_ZeroCopyReleasePtr
+**    CFE_EVS_SendEvent
+**    GPS_KALMAN_Core_Estimate
+**    GPS_KALMAN_Core_Heading
+**    GPS_KALMAN_Coast
+**
+** Called By:
+**    GPS_KALMAN_RcvMsg
+**
+** Global Inputs/Reads:
+**    g_GPS_KALMAN_AppData.Core
+**
+** Global Outputs/Writes:
+**    g_GPS_KALMAN_AppData.uiOutCnt
+**    g_GPS_KALMAN_AppData.bOutBufFailed
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. The message is built in place in an SB buffer and handed to SB without a
+**       copy; once sent, the buffer belongs to SB and is not touched again
+**    2. With no SB buffer free the output is dropped for this cycle; only the first
+**       failure after a good send raises an event
+**
+** Algorithm:
+**    Get a zero copy buffer, write the estimate at the last fix straight into it,
+**    coasted to now if asked and with its quality, then time stamp and send it.
+**
 ** Author(s):  Jacob Killelea
 **
 ** History:  Date Written  2019-06-28
 **           Unit Tested   yyyy-mm-dd
 **=====================================================================================*/
-void GPS_KALMAN_SendOutData()
+void GPS_KALMAN_SendOutData(boolean bCoast)
+{
+    CFE_SB_ZeroCopyHandle_t BufHdl;
+    GPS_KALMAN_OutData_t   *OutPtr;
+    int32                   iStatus;
+
+    OutPtr = (GPS_KALMAN_OutData_t *)
+        CFE_SB_ZeroCopyGetPtr(sizeof(GPS_KALMAN_OutData_t), &BufHdl);
+    if (OutPtr == NULL)
+    {
+        if (!g_GPS_KALMAN_AppData.bOutBufFailed)
+        {
+            g_GPS_KALMAN_AppData.bOutBufFailed = TRUE;
+            CFE_EVS_SendEvent(GPS_KALMAN_ERR_EID, CFE_EVS_ERROR,
+                    "GPS_KALMAN - No SB buffer for the output data, not sent");
+        }
+        goto GPS_KALMAN_SendOutData_Exit_Tag;
+    }
+
+    /* Every field is written below, so the buffer need not be cleared first */
+    CFE_SB_InitMsg(OutPtr, GPS_KALMAN_OUT_DATA_MID, sizeof(GPS_KALMAN_OutData_t), FALSE);
+    OutPtr->uiCounter = ++g_GPS_KALMAN_AppData.uiOutCnt;
+
+    if (g_GPS_KALMAN_AppData.Core.init)
+    {
+        /* Back to latitude and longitude only for the published output */
+        GPS_KALMAN_Core_Estimate(&g_GPS_KALMAN_AppData.Core,
+                &OutPtr->filterLat, &OutPtr->filterLon,
+                &OutPtr->filterVel, &OutPtr->filterHdg);
+        if (!GPS_KALMAN_Core_Heading(&g_GPS_KALMAN_AppData.Core,
+                &OutPtr->filterHdg, &OutPtr->filterYawRate))
+        {
+            OutPtr->filterYawRate = 0.0;
+        }
+        GPS_KALMAN_Coast(OutPtr, bCoast);
+    }
+    else
+    {
+        OutPtr->ucQuality = GPS_KALMAN_QUALITY_NONE;
+        OutPtr->filterLat = 0.0;
+        OutPtr->filterLon = 0.0;
+        OutPtr->filterVel = 0.0;
+        OutPtr->filterHdg = 0.0;
+        OutPtr->filterYawRate = 0.0;
+        OutPtr->filterSigmaN = 0.0;
+        OutPtr->filterSigmaE = 0.0;
+    }
+    memset((void*) OutPtr->ucSpare, 0x00, sizeof(OutPtr->ucSpare));
+
+    CFE_SB_TimeStampMsg((CFE_SB_Msg_t*) OutPtr);
+    iStatus = CFE_SB_ZeroCopySend((CFE_SB_Msg_t*) OutPtr, BufHdl);
+    if (iStatus == CFE_SUCCESS)
+    {
+        g_GPS_KALMAN_AppData.bOutBufFailed = FALSE;
+    }
+    else
+    {
+        /* SB did not take the buffer, so it is still ours to give back */
+        CFE_SB_ZeroCopyReleasePtr((CFE_SB_Msg_t*) OutPtr, BufHdl);
+    }
+
+GPS_KALMAN_SendOutData_Exit_Tag:
+    return;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_SendSmoothData
+**
+** Purpose: To publish the smoother's latest estimate
+**
+** Arguments:
+**    None
+**
+** Returns:
+**    None
+**
+** Routines Called:
+**    CFE_SB_ZeroCopyGetPtr
+**    CFE_SB_InitMsg
+**    GPS_KALMAN_Smooth_Estimate
+**    CFE_SB_TimeStampMsg
+**    CFE_SB_ZeroCopySend
+**    CFE_SB_ZeroCopyReleasePtr
+**    CFE_EVS_SendEvent
+**
+** Called By:
+**    GPS_KALMAN_RunFilter
+**
+** Global Inputs/Reads:
+**    g_GPS_KALMAN_AppData.Smooth
+**
+** Global Outputs/Writes:
+**    g_GPS_KALMAN_AppData.uiSmoothCnt
+**    g_GPS_KALMAN_AppData.bSmoothBufFailed
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. Only called when GPS_KALMAN_Smooth_Filtered has a new estimate, so once per
+**       fix after the first GPS_KALMAN_SMOOTH_LAG since the filter (re)started
+**    2. The header time stamp is the time of sending; smoothTime is the time of the
+**       fix the estimate is for
+**    3. Built in an SB buffer like GPS_KALMAN_SendOutData, and a missing buffer is
+**       reported the same way
+**
+** Algorithm:
+**    None
+**
+** Author(s):  GPS_KALMAN Team
+**
+** History:  Date Written  2026-10-17
+**           Unit Tested   yyyy-mm-dd
+**=====================================================================================*/
+void GPS_KALMAN_SendSmoothData(void)
 {
-    /* TODO:  Add code to update output data, if needed, here.  */
-
-    CFE_EVS_SendEvent(GPS_KALMAN_CMD_INF_EID, CFE_EVS_INFORMATION,
-        "%10.7f %10.7f %10.7f +/- %10.7f %10.7f %10.7f",
-        g_GPS_KALMAN_AppData.OutData.filterLat,
-        g_GPS_KALMAN_AppData.OutData.filterLon,
-        g_GPS_KALMAN_AppData.OutData.filterVel,
-        gsl_matrix_get(PMatrix, 0, 0),
-        gsl_matrix_get(PMatrix, 1, 1),
-        gsl_matrix_get(PMatrix, 2, 2));
-
-    CFE_SB_TimeStampMsg((CFE_SB_Msg_t*) &g_GPS_KALMAN_AppData.OutData);
-    CFE_SB_SendMsg((CFE_SB_Msg_t*) &g_GPS_KALMAN_AppData.OutData);
+#if GPS_KALMAN_SMOOTH_LAG
+    const GPS_KALMAN_Smooth_t *sm = &g_GPS_KALMAN_AppData.Smooth;
+    CFE_SB_ZeroCopyHandle_t  BufHdl;
+    GPS_KALMAN_SmoothData_t *SmoothPtr;
+    int32                    iStatus;
+
+    SmoothPtr = (GPS_KALMAN_SmoothData_t *)
+        CFE_SB_ZeroCopyGetPtr(sizeof(GPS_KALMAN_SmoothData_t), &BufHdl);
+    if (SmoothPtr == NULL)
+    {
+        if (!g_GPS_KALMAN_AppData.bSmoothBufFailed)
+        {
+            g_GPS_KALMAN_AppData.bSmoothBufFailed = TRUE;
+            CFE_EVS_SendEvent(GPS_KALMAN_ERR_EID, CFE_EVS_ERROR,
+                    "GPS_KALMAN - No SB buffer for the smoothed data, not sent");
+        }
+        goto GPS_KALMAN_SendSmoothData_Exit_Tag;
+    }
+
+    CFE_SB_InitMsg(SmoothPtr, GPS_KALMAN_SMOOTH_DATA_MID, sizeof(GPS_KALMAN_SmoothData_t),
+                   TRUE);
+    SmoothPtr->uiCounter  = ++g_GPS_KALMAN_AppData.uiSmoothCnt;
+    SmoothPtr->smoothTime = sm->outTime;
+    GPS_KALMAN_Smooth_Estimate(sm, &SmoothPtr->smoothLat, &SmoothPtr->smoothLon,
+            &SmoothPtr->smoothVel, &SmoothPtr->smoothHdg);
+    SmoothPtr->smoothSigmaN =
+            sqrt(fmax(sm->outP[GPS_KALMAN_SYM_IDX(GPS_KALMAN_STATE_N, GPS_KALMAN_STATE_N)], 0.0));
+    SmoothPtr->smoothSigmaE =
+            sqrt(fmax(sm->outP[GPS_KALMAN_SYM_IDX(GPS_KALMAN_STATE_E, GPS_KALMAN_STATE_E)], 0.0));
+
+    CFE_SB_TimeStampMsg((CFE_SB_Msg_t*) SmoothPtr);
+    iStatus = CFE_SB_ZeroCopySend((CFE_SB_Msg_t*) SmoothPtr, BufHdl);
+    if (iStatus == CFE_SUCCESS)
+    {
+        g_GPS_KALMAN_AppData.bSmoothBufFailed = FALSE;
+    }
+    else
+    {
+        CFE_SB_ZeroCopyReleasePtr((CFE_SB_Msg_t*) SmoothPtr, BufHdl);
+    }
+
+GPS_KALMAN_SendSmoothData_Exit_Tag:
+#endif
+    return;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_SendDiag
+**
+** Purpose: To publish the diagnostic packet and the periodic summary event, as selected
+**          by the diagnostic mode
+**
+** Arguments:
+**    None
+**
+** Returns:
+**    None
+**
+** Routines Called:
+**    CFE_SB_TimeStampMsg
+**    CFE_SB_SendMsg
+**    CFE_EVS_SendEvent
+**
+** Called By:
+**    GPS_KALMAN_RcvMsg
+**
+** Global Inputs/Reads:
+**    g_GPS_KALMAN_AppData.ucDiagMode
+**    g_GPS_KALMAN_AppData.usSummaryPeriod
+**    g_GPS_KALMAN_AppData summary counters
+**
+** Global Outputs/Writes:
+**    g_GPS_KALMAN_AppData.DiagTlm
+**    g_GPS_KALMAN_AppData summary counters
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. Called once per Wakeup cycle, after GPS_KALMAN_SendOutData
+**    2. With the mode at GPS_KALMAN_DIAG_OFF nothing is sent or formatted
+**    3. The summary counters keep counting while the summary is off, and are reset
+**       each time a summary is sent
+**
+** Algorithm:
+**    DIAG_TLM:     send the binary packet every cycle
+**    DIAG_SUMMARY: one event every usSummaryPeriod cycles
+**
+** Author(s):  GPS_KALMAN Team
+**
+** History:  Date Written  2026-10-17
+**           Unit Tested   yyyy-mm-dd
+**=====================================================================================*/
+void GPS_KALMAN_SendDiag(void)
+{
+    g_GPS_KALMAN_AppData.DiagTlm.uiCounter++;
+    g_GPS_KALMAN_AppData.uiSummaryCycles++;
+
+    if (g_GPS_KALMAN_AppData.ucDiagMode & GPS_KALMAN_DIAG_TLM)
+    {
+        CFE_SB_TimeStampMsg((CFE_SB_Msg_t*) &g_GPS_KALMAN_AppData.DiagTlm);
+        CFE_SB_SendMsg((CFE_SB_Msg_t*) &g_GPS_KALMAN_AppData.DiagTlm);
+    }
+
+    if (g_GPS_KALMAN_AppData.uiSummaryCycles >= g_GPS_KALMAN_AppData.usSummaryPeriod)
+    {
+        if (g_GPS_KALMAN_AppData.ucDiagMode & GPS_KALMAN_DIAG_SUMMARY)
+        {
+            CFE_EVS_SendEvent(GPS_KALMAN_INF_EID, CFE_EVS_INFORMATION,
+                    "GPS_KALMAN - %u cycles: %u fixes, %u bad, %u rejected, pos sigma %.2f m",
+                    (unsigned int) g_GPS_KALMAN_AppData.uiSummaryCycles,
+                    (unsigned int) g_GPS_KALMAN_AppData.uiSummaryFixes,
+                    (unsigned int) g_GPS_KALMAN_AppData.uiSummaryBadFixes,
+                    (unsigned int) g_GPS_KALMAN_AppData.uiSummaryRejects,
+                    sqrt(g_GPS_KALMAN_AppData.DiagTlm.stateVar[GPS_KALMAN_STATE_N] +
+                         g_GPS_KALMAN_AppData.DiagTlm.stateVar[GPS_KALMAN_STATE_E]));
+        }
+        g_GPS_KALMAN_AppData.uiSummaryCycles   = 0;
+        g_GPS_KALMAN_AppData.uiSummaryFixes    = 0;
+        g_GPS_KALMAN_AppData.uiSummaryBadFixes = 0;
+        g_GPS_KALMAN_AppData.uiSummaryRejects  = 0;
+    }
 }
 
 /*=====================================================================================
@@ -1171,6 +2387,7 @@ boolean GPS_KALMAN_VerifyCmdLength(CFE_SB_Msg_t* MsgPtr, uint16 usExpectedLen)
     if (MsgPtr != NULL)
     {
         usMsgLen = CFE_SB_GetTotalMsgLength(MsgPtr);
+        bResult = (usExpectedLen == usMsgLen);
 
         if (usExpectedLen != usMsgLen)
         {
@@ -1208,6 +2425,7 @@ boolean GPS_KALMAN_VerifyCmdLength(CFE_SB_Msg_t* MsgPtr, uint16 usExpectedLen)
 **    CFE_ES_WaitForStartupSync
 **    GPS_KALMAN_InitApp
 **    GPS_KALMAN_RcvMsg
+**    GPS_KALMAN_SaveCds
 **
 ** Called By:
 **    TBD
@@ -1260,6 +2478,9 @@ void GPS_KALMAN_AppMain()
         GPS_KALMAN_RcvMsg(1000);
     }
 
+    /* Leave the latest state for the next start */
+    GPS_KALMAN_SaveCds(TRUE);
+
     /* Stop Performance Log entry */
     CFE_ES_PerfLogExit(GPS_KALMAN_MAIN_TASK_PERF_ID);
 
@@ -35,12 +35,19 @@
 #include "gps_kalman_msgids.h"
 #include "gps_kalman_msg.h"
 #include "gps_kalman_utils.h"
+#include "gps_kalman_stats.h"
+#include "gps_kalman_core.h"
+#include "gps_kalman_smooth.h"
+#include "gps_kalman_tbldefs.h"
 
 /*
 ** Local Defines
 */
 #define GPS_KALMAN_TIMEOUT_MSEC    1000
 
+/* GPS_KALMAN_ValidateParamTbl result for a table that fails its range checks */
+#define GPS_KALMAN_PARAM_TBL_INVALID  (-1)
+
 /*
 ** Local Structure Declarations
 */
@@ -68,17 +75,56 @@ typedef struct
     uint32  uiRunStatus;
     
     /* Input data - from I/O devices or subscribed from other apps' output data.
-       Data structure should be defined in gps_kalman/fsw/src/gps_kalman_private_types.h */
-    GPS_KALMAN_InData_t   InData;
+       Data structure should be defined in gps_kalman/fsw/src/gps_kalman_private_types.h
+       One per receiver, in GPS_KALMAN_SOURCE_MIDS order. */
+    GPS_KALMAN_InData_t   InData[GPS_KALMAN_SOURCE_MAX];
+
+    /* Output data - published at the end of a Wakeup cycle, or per fix when event
+       driven. Built in an SB buffer by GPS_KALMAN_SendOutData, so there is no copy here. */
+    uint32   uiOutCnt;        /* GPS_KALMAN_OutData_t messages published */
+    boolean  bOutBufFailed;   /* the last SB buffer request failed, and was reported */
 
-    /* Output data - to be published at the end of a Wakeup cycle.
-       Data structure should be defined in gps_kalman/fsw/src/gps_kalman_private_types.h */
-    GPS_KALMAN_OutData_t  OutData;
+    /* Smoothed output data - published per fix once GPS_KALMAN_SMOOTH_LAG fixes have
+       followed it, by GPS_KALMAN_SendSmoothData */
+    uint32   uiSmoothCnt;      /* GPS_KALMAN_SmoothData_t messages published */
+    boolean  bSmoothBufFailed; /* the last SB buffer request failed, and was reported */
 
     /* Housekeeping telemetry - for downlink only.
        Data structure should be defined in gps_kalman/fsw/src/gps_kalman_msg.h */
     GPS_KALMAN_HkTlm_t  HkTlm;
 
+    /* Filter parameter table; its contents are copied into Core when loaded */
+    CFE_TBL_Handle_t    ParamTblHdl;
+
+    /* Filter bookkeeping: timing, motion model cache and local frame */
+    GPS_KALMAN_Core_t   Core;
+    boolean             bFixSinceWakeup; /* a fix was filtered since the last wakeup's
+                                         ** output, else the next one coasts */
+#if GPS_KALMAN_SMOOTH_LAG
+    GPS_KALMAN_Smooth_t Smooth;          /* fixed-lag smoother fed by Core */
+#endif
+
+    /* Filter state checkpoint, see GPS_KALMAN_SaveCds */
+    CFE_ES_CDSHandle_t       CdsHdl;
+    boolean                  bCdsEnabled;     /* the CDS block is registered */
+    boolean                  bCdsDirty;       /* the state changed since it was saved */
+    boolean                  bCdsSaveFailed;  /* the last save failed, and was reported */
+    uint16                   usCdsCycles;     /* wakeups since the last save */
+    GPS_KALMAN_Checkpoint_t  Checkpoint;      /* staging for CFE_ES_CopyToCDS */
+
+    /* Diagnostics, see GPS_KALMAN_SendDiag */
+    uint8   ucDiagMode;       /* GPS_KALMAN_DIAG_* flags */
+    uint16  usSummaryPeriod;  /* cycles between summary events */
+    uint32  uiSummaryCycles;  /* cycles since the last summary */
+    uint32  uiSummaryFixes;   /* good fixes used since the last summary */
+    uint32  uiSummaryBadFixes;/* bad fixes since the last summary */
+    uint32  uiSummaryRejects; /* updates skipped since the last summary */
+    GPS_KALMAN_DiagTlm_t  DiagTlm;
+
+    /* Stage execution times, see GPS_KALMAN_StageEntry/Exit */
+    GPS_KALMAN_Stats_t  StageStats[GPS_KALMAN_STAGE_CNT];
+    uint64              StageStartNs[GPS_KALMAN_STAGE_CNT];
+
     /* TODO:  Add declarations for additional private data here */
 } GPS_KALMAN_AppData_t;
 
@@ -100,20 +146,37 @@ typedef struct
 int32  GPS_KALMAN_InitEvent(void);
 int32  GPS_KALMAN_InitPipe(void);
 int32  GPS_KALMAN_InitData(void);
+int32  GPS_KALMAN_InitTable(void);
+void   GPS_KALMAN_InitCds(void);
 int32  GPS_KALMAN_InitApp(void);
 
+int32  GPS_KALMAN_ValidateParamTbl(void*);
+void   GPS_KALMAN_ManageTable(boolean);
+
 void  GPS_KALMAN_CleanupCallback(void);
 
 int32  GPS_KALMAN_RcvMsg(int32 iBlocking);
 
 void  GPS_KALMAN_ProcessNewData(void);
+uint32 GPS_KALMAN_SourceOf(CFE_SB_MsgId_t);
+void  GPS_KALMAN_ProcessGpsInfo(CFE_SB_Msg_t*, uint32);
 void  GPS_KALMAN_ProcessNewCmds(void);
 void  GPS_KALMAN_ProcessNewAppCmds(CFE_SB_Msg_t*);
 
-int32 GPS_KALMAN_RunFilter(void);
+int32 GPS_KALMAN_RunFilter(uint32);
+void  GPS_KALMAN_RunNewest(void);
+void  GPS_KALMAN_Coast(GPS_KALMAN_OutData_t*, boolean);
+double GPS_KALMAN_TimeToSec(CFE_TIME_SysTime_t);
+
+void  GPS_KALMAN_StageEntry(uint32);
+void  GPS_KALMAN_StageExit(uint32);
+
+void  GPS_KALMAN_SaveCds(boolean);
 
 void  GPS_KALMAN_ReportHousekeeping(void);
-void  GPS_KALMAN_SendOutData(void);
+void  GPS_KALMAN_SendOutData(boolean);
+void  GPS_KALMAN_SendSmoothData(void);
+void  GPS_KALMAN_SendDiag(void);
 
 boolean  GPS_KALMAN_VerifyCmdLength(CFE_SB_Msg_t*, uint16);
 
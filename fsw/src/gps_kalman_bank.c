@@ -0,0 +1,221 @@
+/*=======================================================================================
+** File Name:  gps_kalman_bank.c
+**
+** Title:  Multi-track filter bank for GPS_KALMAN Application
+**
+** $Author:    GPS_KALMAN Team
+** $Revision: 1.1 $
+** $Date:      2026-10-17
+**
+** Purpose:  This file runs the GPS_KALMAN filter for many independent tracks at once,
+**           using the structure-of-arrays GPS_KALMAN_Bank_t
+**
+** Functions Defined:
+**    Function GPS_KALMAN_Bank_Init: reset the tracks in a bank
+**    Function GPS_KALMAN_Bank_Predict: predict every track
+**    Function GPS_KALMAN_Bank_Update: update every track with a pending measurement
+**    Function GPS_KALMAN_Bank_GetTrack: read one track in scalar layout
+**    Function GPS_KALMAN_Bank_SetTrack: write one track in scalar layout
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. Each track runs the same arithmetic as GPS_KALMAN_Filter_Predict/Update (see
+**       gps_kalman_filter_kernel.h), so results are bit-identical to the scalar
+**       filter built with the same flags. Build both without FMA contraction
+**       (-ffp-contract=off) if bitwise agreement is required.
+**    2. The track loops have no control flow and unit-stride accesses, and are left
+**       to compiler auto-vectorisation (SSE2/AVX depending on -march)
+**    3. No allocation: the caller owns the GPS_KALMAN_Bank_t
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**   2026-10-17 | GPS_KALMAN Team | Build #: Code Started
+**   2026-10-17 | GPS_KALMAN Team | Tracks in GPS_KALMAN_Real_t
+**   2026-10-17 | GPS_KALMAN Team | Chi-square innovation gate
+**
+**=====================================================================================*/
+
+#include <string.h>
+
+#include "gps_kalman_bank.h"
+#include "gps_kalman_filter_kernel.h"
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Bank_Init
+**
+** Purpose: To reset the first count tracks of a bank
+**
+** Arguments:
+**    GPS_KALMAN_Bank_t *bank  - bank to reset
+**    unsigned int count       - number of active tracks
+**    double p0                - initial covariance diagonal
+**
+** Returns:
+**    GPS_KALMAN_FILTER_SUCCESS, or -1 if count exceeds GPS_KALMAN_BANK_SIZE
+**=====================================================================================*/
+int GPS_KALMAN_Bank_Init(GPS_KALMAN_Bank_t *bank, unsigned int count, double p0)
+{
+    unsigned int i;
+    unsigned int j;
+    GPS_KALMAN_Real_t d = GPS_KALMAN_D2R(p0);
+
+    if ((bank == NULL) || (count > GPS_KALMAN_BANK_SIZE))
+    {
+        return -1;
+    }
+
+    memset((void*) bank, 0x00, sizeof(*bank));
+    bank->count = count;
+
+    for (j = 0; j < GPS_KALMAN_FILTER_LEN; j++)
+    {
+        for (i = 0; i < count; i++)
+        {
+            bank->P[GPS_KALMAN_SYM_IDX(j, j)][i] = d;
+        }
+    }
+
+    return GPS_KALMAN_FILTER_SUCCESS;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Bank_Predict
+**
+** Purpose: To predict every active track one step
+**
+** Arguments:
+**    GPS_KALMAN_Bank_t *bank      - bank to predict
+**    const GPS_KALMAN_Real_t F[]  - state transition matrix, shared by all tracks
+**    const GPS_KALMAN_Real_t Q[]  - process noise covariance, packed, shared
+**
+** Returns:
+**    None
+**=====================================================================================*/
+void GPS_KALMAN_Bank_Predict(GPS_KALMAN_Bank_t *bank,
+                             const GPS_KALMAN_Real_t F[GPS_KALMAN_FILTER_MAT_LEN],
+                             const GPS_KALMAN_Real_t Q[GPS_KALMAN_FILTER_SYM_LEN])
+{
+    unsigned int i;
+    unsigned int n = bank->count;
+    GPS_KALMAN_Real_t Fl[GPS_KALMAN_FILTER_MAT_LEN];
+    GPS_KALMAN_Real_t Ql[GPS_KALMAN_FILTER_SYM_LEN];
+
+    /* Local copies cannot alias the bank, which saves the vectoriser from
+    ** versioning the loop on run-time overlap checks */
+    memcpy((void*) Fl, (const void*) F, sizeof(Fl));
+    memcpy((void*) Ql, (const void*) Q, sizeof(Ql));
+
+    for (i = 0; i < n; i++)
+    {
+        GPS_KALMAN_Kernel_Predict(Fl, Ql, &bank->x[0][i], &bank->P[0][i],
+                                  GPS_KALMAN_BANK_SIZE);
+    }
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Bank_Update
+**
+** Purpose: To update every active track that has a pending measurement
+**
+** Arguments:
+**    GPS_KALMAN_Bank_t *bank  - bank to update; z, r and valid are read
+**    double gate              - largest squared Mahalanobis distance accepted, shared
+**                               by all tracks; <= 0 accepts all
+**
+** Returns:
+**    unsigned int - number of valid tracks rejected by the gate or as not positive
+**                   definite; status tells which
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. S, K and d2 are formed for every active track, valid or not, so the loop stays
+**       branch-free; only x and P honour the valid flag
+**    2. valid is cleared for every track once consumed
+**=====================================================================================*/
+unsigned int GPS_KALMAN_Bank_Update(GPS_KALMAN_Bank_t *bank, double gate)
+{
+    unsigned int i;
+    unsigned int n = bank->count;
+    unsigned int rejected = 0;
+    GPS_KALMAN_Real_t g = GPS_KALMAN_D2R(gate);
+
+    for (i = 0; i < n; i++)
+    {
+        bank->status[i] = GPS_KALMAN_Kernel_Update(&bank->z[0][i], &bank->r[0][i],
+                                                   &bank->x[0][i], &bank->P[0][i],
+                                                   &bank->S[0][i], &bank->K[0][i],
+                                                   &bank->d2[i], GPS_KALMAN_BANK_SIZE, g,
+                                                   bank->valid[i] != 0);
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        rejected += (bank->valid[i] != 0) & (bank->status[i] != GPS_KALMAN_FILTER_SUCCESS);
+        bank->valid[i] = 0;
+    }
+
+    return rejected;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Bank_GetTrack
+**
+** Purpose: To copy one track's state out of the bank
+**
+** Arguments:
+**    const GPS_KALMAN_Bank_t *bank  - bank to read
+**    unsigned int track             - track index
+**    GPS_KALMAN_Real_t x[]          - state (output)
+**    GPS_KALMAN_Real_t P[]          - covariance, packed (output)
+**
+** Returns:
+**    None
+**=====================================================================================*/
+void GPS_KALMAN_Bank_GetTrack(const GPS_KALMAN_Bank_t *bank, unsigned int track,
+                              GPS_KALMAN_Real_t x[GPS_KALMAN_FILTER_LEN],
+                              GPS_KALMAN_Real_t P[GPS_KALMAN_FILTER_SYM_LEN])
+{
+    unsigned int j;
+
+    for (j = 0; j < GPS_KALMAN_FILTER_LEN; j++)
+    {
+        x[j] = bank->x[j][track];
+    }
+    for (j = 0; j < GPS_KALMAN_FILTER_SYM_LEN; j++)
+    {
+        P[j] = bank->P[j][track];
+    }
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Bank_SetTrack
+**
+** Purpose: To copy one track's state into the bank
+**
+** Arguments:
+**    GPS_KALMAN_Bank_t *bank      - bank to write
+**    unsigned int track           - track index
+**    const GPS_KALMAN_Real_t x[]  - state
+**    const GPS_KALMAN_Real_t P[]  - covariance, packed
+**
+** Returns:
+**    None
+**=====================================================================================*/
+void GPS_KALMAN_Bank_SetTrack(GPS_KALMAN_Bank_t *bank, unsigned int track,
+                              const GPS_KALMAN_Real_t x[GPS_KALMAN_FILTER_LEN],
+                              const GPS_KALMAN_Real_t P[GPS_KALMAN_FILTER_SYM_LEN])
+{
+    unsigned int j;
+
+    for (j = 0; j < GPS_KALMAN_FILTER_LEN; j++)
+    {
+        bank->x[j][track] = x[j];
+    }
+    for (j = 0; j < GPS_KALMAN_FILTER_SYM_LEN; j++)
+    {
+        bank->P[j][track] = P[j];
+    }
+}
+
+/*=======================================================================================
+** End of file gps_kalman_bank.c
+**=====================================================================================*/
@@ -0,0 +1,89 @@
+/*=======================================================================================
+** File Name:  gps_kalman_bank.h
+**
+** Title:  Header File for the GPS_KALMAN multi-track filter bank
+**
+** $Author:    GPS_KALMAN Team
+** $Revision: 1.1 $
+** $Date:      2026-10-17
+**
+** Purpose:  To define a bank of independent GPS_KALMAN filters held in a
+**           structure-of-arrays layout, for ground-side replay and fleet monitoring.
+**           Element j of every track's state lives in one contiguous row, so the
+**           per-track predict/update loops vectorise across tracks.
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**   2026-10-17 | GPS_KALMAN Team | Build #: Code Started
+**
+**=====================================================================================*/
+
+#ifndef _GPS_KALMAN_BANK_H_
+#define _GPS_KALMAN_BANK_H_
+
+#include "gps_kalman_filter.h"
+
+/* Maximum number of tracks in one bank. Also the stride between rows. */
+#ifndef GPS_KALMAN_BANK_SIZE
+#define GPS_KALMAN_BANK_SIZE (1024)
+#endif
+
+/* Rows are aligned so each one starts on a vector boundary */
+#define GPS_KALMAN_BANK_ALIGN (64)
+
+typedef struct
+{
+    unsigned int count; /* number of active tracks, [0, GPS_KALMAN_BANK_SIZE] */
+
+    /* Filter state, one row per element, one column per track */
+    GPS_KALMAN_Real_t x[GPS_KALMAN_FILTER_LEN][GPS_KALMAN_BANK_SIZE]
+        __attribute__((aligned(GPS_KALMAN_BANK_ALIGN)));     /* state */
+    GPS_KALMAN_Real_t P[GPS_KALMAN_FILTER_SYM_LEN][GPS_KALMAN_BANK_SIZE]
+        __attribute__((aligned(GPS_KALMAN_BANK_ALIGN)));     /* covariance, packed */
+
+    /* Measurement inputs for the next GPS_KALMAN_Bank_Update */
+    GPS_KALMAN_Real_t z[GPS_KALMAN_FILTER_LEN][GPS_KALMAN_BANK_SIZE]
+        __attribute__((aligned(GPS_KALMAN_BANK_ALIGN)));     /* measurement */
+    GPS_KALMAN_Real_t r[GPS_KALMAN_FILTER_LEN][GPS_KALMAN_BANK_SIZE]
+        __attribute__((aligned(GPS_KALMAN_BANK_ALIGN)));     /* measurement variances */
+    int    valid[GPS_KALMAN_BANK_SIZE]
+        __attribute__((aligned(GPS_KALMAN_BANK_ALIGN)));     /* nonzero: update this track */
+
+    /* Outputs of the last GPS_KALMAN_Bank_Update */
+    GPS_KALMAN_Real_t S[GPS_KALMAN_FILTER_SYM_LEN][GPS_KALMAN_BANK_SIZE]
+        __attribute__((aligned(GPS_KALMAN_BANK_ALIGN)));     /* innovation covariance, packed */
+    GPS_KALMAN_Real_t K[GPS_KALMAN_FILTER_MAT_LEN][GPS_KALMAN_BANK_SIZE]
+        __attribute__((aligned(GPS_KALMAN_BANK_ALIGN)));     /* gain */
+    GPS_KALMAN_Real_t d2[GPS_KALMAN_BANK_SIZE]
+        __attribute__((aligned(GPS_KALMAN_BANK_ALIGN)));     /* squared Mahalanobis distance */
+    int    status[GPS_KALMAN_BANK_SIZE]
+        __attribute__((aligned(GPS_KALMAN_BANK_ALIGN)));     /* GPS_KALMAN_FILTER_* per track */
+} GPS_KALMAN_Bank_t;
+
+/* Reset count tracks to x = 0, P = p0 * I, with no pending measurements */
+int  GPS_KALMAN_Bank_Init(GPS_KALMAN_Bank_t *bank, unsigned int count, double p0);
+
+/* Predict every active track with the shared F and packed Q */
+void GPS_KALMAN_Bank_Predict(GPS_KALMAN_Bank_t *bank,
+                             const GPS_KALMAN_Real_t F[GPS_KALMAN_FILTER_MAT_LEN],
+                             const GPS_KALMAN_Real_t Q[GPS_KALMAN_FILTER_SYM_LEN]);
+
+/* Update every active track whose valid flag is set from its z and r, unless its
+** innovation is outside gate (see GPS_KALMAN_Filter_Update). Returns the number of
+** tracks not updated, gated or with an innovation covariance not positive definite. */
+unsigned int GPS_KALMAN_Bank_Update(GPS_KALMAN_Bank_t *bank, double gate);
+
+/* Copy one track out of / into the bank in the scalar filter's layout */
+void GPS_KALMAN_Bank_GetTrack(const GPS_KALMAN_Bank_t *bank, unsigned int track,
+                              GPS_KALMAN_Real_t x[GPS_KALMAN_FILTER_LEN],
+                              GPS_KALMAN_Real_t P[GPS_KALMAN_FILTER_SYM_LEN]);
+void GPS_KALMAN_Bank_SetTrack(GPS_KALMAN_Bank_t *bank, unsigned int track,
+                              const GPS_KALMAN_Real_t x[GPS_KALMAN_FILTER_LEN],
+                              const GPS_KALMAN_Real_t P[GPS_KALMAN_FILTER_SYM_LEN]);
+
+#endif /* _GPS_KALMAN_BANK_H_ */
+
+/*=======================================================================================
+** End of file gps_kalman_bank.h
+**=====================================================================================*/
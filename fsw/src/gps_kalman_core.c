@@ -0,0 +1,1553 @@
+/*=======================================================================================
+** File Name:  gps_kalman_core.c
+**
+** Title:  Filter core for GPS_KALMAN Application
+**
+** $Author:    GPS_KALMAN Team
+** $Revision: 1.1 $
+** $Date:      2026-10-17
+**
+** Purpose:  This file contains the GPS_KALMAN filter proper, independent of cFE: the
+**           local frame, the measurement and its noise, the time step and motion
+**           model, and the predict/update on the matrices of gps_kalman_data.h
+**
+** Functions Defined:
+**    Function GPS_KALMAN_Core_Init: reset the filter
+**    Function GPS_KALMAN_Core_DefaultParams: the platform default tuning
+**    Function GPS_KALMAN_Core_CheckParams: range check tuning
+**    Function GPS_KALMAN_Core_SetParams: change the tuning without a reset
+**    Function GPS_KALMAN_Core_Save: checkpoint the state
+**    Function GPS_KALMAN_Core_Restore: resume from a checkpoint
+**    Function GPS_KALMAN_Core_Prepare: load a fix and set up the step to it
+**    Function GPS_KALMAN_Core_Predict: propagate to the fix
+**    Function GPS_KALMAN_Core_Update: update with the fix
+**    Function GPS_KALMAN_Core_Step: prepare, predict and update
+**    Function GPS_KALMAN_Core_Estimate: the state as latitude, longitude, speed, heading
+**    Function GPS_KALMAN_Core_Heading: the heading filter's heading and yaw rate
+**    Function GPS_KALMAN_Core_Coast: extrapolate the position and its error without a fix
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. No cFE, OSAL or gps_reader dependency, and no allocation
+**    2. Re-entrant: all filter state is in the GPS_KALMAN_Core_t, so any number of
+**       cores can run side by side, one thread each
+**    3. Tuning defaults to gps_kalman_platform_cfg.h, and can be changed at any time
+**       with GPS_KALMAN_Core_SetParams
+**    4. Heading and yaw rate are a second, two state filter on the measured heading,
+**       beside the position/velocity one. Headings are degrees in [0, 360), and
+**       every difference of two is wrapped into (-180, 180].
+**    5. With params.steadyGainTol, a gain that has settled is frozen and fixes take
+**       state-only steps until the time step changes. Frozen gains are cached by
+**       measurement noise, so a DOP change to one seen before switches gain rather
+**       than ending them, and the full filter, once its covariance is back at a
+**       cached steady state, goes back to that gain.
+**       The GSL path always runs the full filter.
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**   2026-10-17 | GPS_KALMAN Team | Build #: Code Started, from GPS_KALMAN_RunFilter
+**   2026-10-17 | GPS_KALMAN Team | Filter matrices in the core instead of global
+**   2026-10-17 | GPS_KALMAN Team | Convert to and from GPS_KALMAN_Real_t at the boundary
+**   2026-10-17 | GPS_KALMAN Team | Tuning parameters set at run time
+**   2026-10-17 | GPS_KALMAN Team | State checkpoint for warm restarts
+**   2026-10-17 | GPS_KALMAN Team | Innovation gate
+**   2026-10-17 | GPS_KALMAN Team | Fixes from several receivers
+**   2026-10-17 | GPS_KALMAN Team | Heading and yaw rate filter
+**   2026-10-17 | GPS_KALMAN Team | Steady-state gain
+**   2026-10-17 | GPS_KALMAN Team | Steady-state gains cached by DOP
+**   2026-10-17 | GPS_KALMAN Team | Coast quality and covariance, bounded coast time
+**
+**=====================================================================================*/
+
+#include <math.h>
+#include <string.h>
+
+#include "gps_kalman_platform_cfg.h"
+#include "gps_kalman_core.h"
+#include "gps_kalman_data.h"
+
+/* lo < v <= hi, false for NaN */
+#define GPS_KALMAN_CORE_IN_RANGE(v, lo, hi)  (((v) > (lo)) && ((v) <= (hi)))
+
+#define GPS_KALMAN_CORE_RAD2DEG  (57.29577951308232)
+
+/* A heading in [0, 360), and a heading difference in (-180, 180]. Headings are
+** nearly always within a turn of the range, so fmod is left for the rest. */
+static double GPS_KALMAN_Core_WrapHdg(double hdg)
+{
+    if (hdg >= 360.0)
+    {
+        hdg -= 360.0;
+    }
+    else if (hdg < 0.0)
+    {
+        hdg += 360.0;
+    }
+    if (!((hdg >= 0.0) && (hdg < 360.0)))
+    {
+        hdg = fmod(hdg, 360.0);
+        hdg = (hdg < 0.0) ? (hdg + 360.0) : hdg;
+        hdg = (hdg >= 360.0) ? 0.0 : hdg;
+    }
+    return hdg;
+}
+
+static double GPS_KALMAN_Core_WrapHdgDiff(double diff)
+{
+    diff = GPS_KALMAN_Core_WrapHdg(diff);
+    return (diff > 180.0) ? (diff - 360.0) : diff;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Core_HdgStart
+**
+** Purpose: To start the heading filter from the prepared fix's heading
+**
+** Arguments:
+**    GPS_KALMAN_Core_t *core  - core, with hdgUse set
+**
+** Returns:
+**    None
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. The yaw rate starts at 0 with params.yawRateSigma0, as one heading says
+**       nothing about it
+**=====================================================================================*/
+static void GPS_KALMAN_Core_HdgStart(GPS_KALMAN_Core_t *core)
+{
+    core->hdg[GPS_KALMAN_HDG]      = core->hdgMeas;
+    core->hdg[GPS_KALMAN_HDG_RATE] = 0.0;
+    core->hdgP[0] = core->hdgVar * core->params.initVarScale;
+    core->hdgP[1] = 0.0;
+    core->hdgP[2] = core->params.yawRateSigma0 * core->params.yawRateSigma0;
+    core->hdgState = GPS_KALMAN_HDG_TRACKING;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Core_HdgHold
+**
+** Purpose: To stop the heading filter turning while the vehicle is too slow for a
+**          heading
+**
+** Arguments:
+**    GPS_KALMAN_Core_t *core  - core
+**
+** Returns:
+**    None
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. The heading and its variance are kept. The yaw rate goes back to 0 with
+**       params.yawRateSigma0 and no correlation with the heading, as at
+**       GPS_KALMAN_Core_HdgStart, so the vehicle does not move off still turning at
+**       the rate it had before it stopped.
+**=====================================================================================*/
+static void GPS_KALMAN_Core_HdgHold(GPS_KALMAN_Core_t *core)
+{
+    core->hdg[GPS_KALMAN_HDG_RATE] = 0.0;
+    core->hdgP[1] = 0.0;
+    core->hdgP[2] = core->params.yawRateSigma0 * core->params.yawRateSigma0;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Core_HdgPredict
+**
+** Purpose: To propagate the heading filter to the prepared fix
+**
+** Arguments:
+**    GPS_KALMAN_Core_t *core  - core
+**
+** Returns:
+**    None
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. Below params.hdgMinSpeedKph the heading is held rather than turned at the
+**       yaw rate, since a stopped vehicle does not keep turning. The yaw rate is
+**       reset by GPS_KALMAN_Core_HdgHold, and the heading's variance still grows
+**       so that the first fix on moving off can correct it.
+**
+** Algorithm:
+**    Constant yaw rate: hdg += rate * dt, P = F * P * F' + Q, with F = [1 dt; 0 1]
+**    and Q = params.yawAccelPsd * [dt^3/3 dt^2/2; dt^2/2 dt]. When held, F = I and
+**    the heading is a random walk, P00 += params.yawAccelPsd * dt^3/3, the variance
+**    the turn noise alone adds over dt, with no cross term.
+**=====================================================================================*/
+static void GPS_KALMAN_Core_HdgPredict(GPS_KALMAN_Core_t *core)
+{
+    double *P = core->hdgP;
+    double dt = core->dt;
+    double q  = core->params.yawAccelPsd;
+
+    if (core->hdgState != GPS_KALMAN_HDG_TRACKING)
+    {
+        return;
+    }
+
+    if (!core->hdgUse)
+    {
+        GPS_KALMAN_Core_HdgHold(core);
+        P[0] += q * dt * dt * dt / 3.0;
+        return;
+    }
+
+    core->hdg[GPS_KALMAN_HDG] = GPS_KALMAN_Core_WrapHdg(core->hdg[GPS_KALMAN_HDG] +
+                                                       dt * core->hdg[GPS_KALMAN_HDG_RATE]);
+    P[0] += 2.0 * dt * P[1] + dt * dt * P[2] + q * dt * dt * dt / 3.0;
+    P[1] += dt * P[2] + q * dt * dt / 2.0;
+    P[2] += q * dt;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Core_HdgUpdate
+**
+** Purpose: To update the heading filter with the prepared fix's heading
+**
+** Arguments:
+**    GPS_KALMAN_Core_t *core  - core, tracking, with hdgUse set
+**
+** Returns:
+**    None
+**
+** Algorithm:
+**    y = wrap(hdgMeas - hdg), S = P00 + hdgVar, K = P * H' / S with H = [1 0], then
+**    x += K * y and the Joseph form P = (I - K H) P (I - K H)' + K hdgVar K', as the
+**    position filter's scalar updates. The wrap keeps a fix at 359 from pulling a
+**    heading of 1 round the long way.
+**=====================================================================================*/
+static void GPS_KALMAN_Core_HdgUpdate(GPS_KALMAN_Core_t *core)
+{
+    double *P = core->hdgP;
+    double r  = core->hdgVar;
+    double y  = GPS_KALMAN_Core_WrapHdgDiff(core->hdgMeas - core->hdg[GPS_KALMAN_HDG]);
+    double s  = P[0] + r;
+    double k0 = P[0] / s;
+    double k1 = P[1] / s;
+    double p00 = P[0];
+    double p01 = P[1];
+
+    core->hdg[GPS_KALMAN_HDG] = GPS_KALMAN_Core_WrapHdg(core->hdg[GPS_KALMAN_HDG] + k0 * y);
+    core->hdg[GPS_KALMAN_HDG_RATE] += k1 * y;
+    P[0] = (1.0 - k0) * (1.0 - k0) * p00 + k0 * k0 * r;
+    P[1] = (1.0 - k0) * (p01 - k1 * p00) + k0 * k1 * r;
+    P[2] = P[2] - 2.0 * k1 * p01 + k1 * k1 * (p00 + r);
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Core_GainFind
+**
+** Purpose: To look up the cached steady-state gain for a time step and measurement noise
+**
+** Arguments:
+**    const GPS_KALMAN_Core_t *core   - core
+**    double dt                       - time step, s
+**    const GPS_KALMAN_Real_t *R      - measurement variances
+**
+** Returns:
+**    int - index into core->gainCache, or -1 if none matches bit for bit
+**=====================================================================================*/
+static int GPS_KALMAN_Core_GainFind(const GPS_KALMAN_Core_t *core, double dt,
+                                    const GPS_KALMAN_Real_t *R)
+{
+    unsigned int i;
+
+    for (i = 0; i < core->gainCount; i++)
+    {
+        if ((core->gainCache[i].dt == dt) &&
+            (memcmp(core->gainCache[i].R, R, sizeof(core->gainCache[i].R)) == 0))
+        {
+            return (int) i;
+        }
+    }
+    return -1;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Core_GainNear
+**
+** Purpose: To tell whether the covariance has settled back to a cached steady state
+**
+** Arguments:
+**    const GPS_KALMAN_Core_t *core   - core, after the update of the last fix
+**    const GPS_KALMAN_Gain_t *gain   - cached gain
+**
+** Returns:
+**    int - 1 if P is within params.steadyGainTol of gain->PPost, else 0
+**
+** Algorithm:
+**    Element by element, relative to the steady-state standard deviations, so that
+**    positions and velocities weigh alike: |P_ij - PPost_ij| <= tol *
+**    sqrt(PPost_ii * PPost_jj).
+**=====================================================================================*/
+static int GPS_KALMAN_Core_GainNear(const GPS_KALMAN_Core_t *core,
+                                    const GPS_KALMAN_Gain_t *gain)
+{
+    const GPS_KALMAN_Real_t *P = core->data.PMatrixData;
+    double sd[GPS_KALMAN_FILTER_LEN];
+    unsigned int i;
+    unsigned int j;
+
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        sd[i] = sqrt(GPS_KALMAN_R2D(gain->PPost[GPS_KALMAN_SYM_IDX(i, i)]));
+    }
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        for (j = i; j < GPS_KALMAN_FILTER_LEN; j++)
+        {
+            if (fabs(GPS_KALMAN_R2D(P[GPS_KALMAN_SYM_IDX(i, j)]) -
+                     GPS_KALMAN_R2D(gain->PPost[GPS_KALMAN_SYM_IDX(i, j)])) >
+                core->params.steadyGainTol * sd[i] * sd[j])
+            {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+#ifndef GPS_KALMAN_USE_GSL
+/*=====================================================================================
+** Name: GPS_KALMAN_Core_GainFreeze
+**
+** Purpose: To store a converged gain in the steady-state gain cache
+**
+** Arguments:
+**    GPS_KALMAN_Core_t *core        - core
+**    double dt                      - time step, s
+**    const GPS_KALMAN_Real_t *R     - measurement variances
+**    const GPS_KALMAN_Real_t *K     - gain
+**    const GPS_KALMAN_Real_t *S     - innovation covariance, packed
+**    const GPS_KALMAN_Real_t *P     - covariance after the update, packed
+**
+** Returns:
+**    int - index of the entry, or -1 if S could not be inverted
+**
+** Algorithm:
+**    The entry kept is S, S^-1 for the gate, and the covariance before (S less the
+**    measurement variances) and after the update, which the state-only steps then
+**    report as P. It replaces an entry with the same dt and R, else fills an empty
+**    one, else replaces the least recently used.
+**=====================================================================================*/
+static int GPS_KALMAN_Core_GainFreeze(GPS_KALMAN_Core_t *core, double dt,
+                                      const GPS_KALMAN_Real_t *R, const GPS_KALMAN_Real_t *K,
+                                      const GPS_KALMAN_Real_t *S, const GPS_KALMAN_Real_t *P)
+{
+    GPS_KALMAN_Real_t Sinv[GPS_KALMAN_FILTER_SYM_LEN];
+    GPS_KALMAN_Gain_t *gain;
+    int idx;
+    unsigned int i;
+
+    if (GPS_KALMAN_Filter_SymInverse(S, Sinv) != GPS_KALMAN_FILTER_SUCCESS)
+    {
+        return -1;
+    }
+
+    idx = GPS_KALMAN_Core_GainFind(core, dt, R);
+    if ((idx < 0) && (core->gainCount < GPS_KALMAN_GAIN_CACHE_LEN))
+    {
+        idx = (int) core->gainCount++;
+    }
+    else if (idx < 0)
+    {
+        idx = 0;
+        for (i = 1; i < core->gainCount; i++)
+        {
+            if (core->gainCache[i].lastUse < core->gainCache[idx].lastUse)
+            {
+                idx = (int) i;
+            }
+        }
+    }
+
+    gain = &core->gainCache[idx];
+    gain->dt = dt;
+    memcpy(gain->R, R, sizeof(gain->R));
+    memcpy(gain->K, K, sizeof(gain->K));
+    memcpy(gain->S, S, sizeof(gain->S));
+    memcpy(gain->Sinv, Sinv, sizeof(gain->Sinv));
+    memcpy(gain->PPrior, S, sizeof(gain->PPrior));
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        gain->PPrior[GPS_KALMAN_SYM_IDX(i, i)] = GPS_KALMAN_RSAT(
+            (GPS_KALMAN_Acc_t) gain->PPrior[GPS_KALMAN_SYM_IDX(i, i)] - R[i]);
+    }
+    memcpy(gain->PPost, P, sizeof(gain->PPost));
+    gain->lastUse = ++core->gainClock;
+
+    return idx;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Core_Settle
+**
+** Purpose: To track whether the gain has reached steady state, and freeze it if so
+**
+** Arguments:
+**    GPS_KALMAN_Core_t *core  - core, just after a full update
+**    int status               - result of that update
+**
+** Returns:
+**    None
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. Only consecutive full updates at the same dt and measurement variances count.
+**       With a fixed rate and noise model the Riccati recursion converges, so the
+**       gain stops moving; with alternating receivers or a changing DOP it does not,
+**       and the gain is never frozen.
+**
+** Algorithm:
+**    settled counts the updates in a row whose gain is within params.steadyGainTol
+**    of the one before, element by element. At params.steadySettleFixes the gain is
+**    frozen into the gain cache with GPS_KALMAN_Core_GainFreeze.
+**=====================================================================================*/
+static void GPS_KALMAN_Core_Settle(GPS_KALMAN_Core_t *core, int status)
+{
+    GPS_KALMAN_Data_t *data = &core->data;
+    double moved = 0.0;
+    int    same;
+    int    idx;
+    int    i;
+
+    if ((status != GPS_KALMAN_FILTER_SUCCESS) || (core->params.steadyGainTol == 0.0))
+    {
+        core->settled = 0;
+        return;
+    }
+
+    same = (core->dt == core->settle.dt) &&
+        (memcmp(data->SigmaActualData, core->settle.R, sizeof(core->settle.R)) == 0);
+    for (i = 0; same && (i < GPS_KALMAN_FILTER_MAT_LEN); i++)
+    {
+        moved = fmax(moved, fabs(GPS_KALMAN_R2D(data->KMatrixData[i]) -
+                                 GPS_KALMAN_R2D(core->settle.K[i])));
+    }
+    core->settled = (same && (moved <= core->params.steadyGainTol)) ? core->settled + 1 : 0;
+
+    memcpy(core->settle.K, data->KMatrixData, sizeof(core->settle.K));
+    memcpy(core->settle.R, data->SigmaActualData, sizeof(core->settle.R));
+    core->settle.dt = core->dt;
+
+    if (core->settled >= core->params.steadySettleFixes)
+    {
+        idx = GPS_KALMAN_Core_GainFreeze(core, core->dt, data->SigmaActualData,
+                  data->KMatrixData, data->SigmaExpectMatrixData, data->PMatrixData);
+        if (idx >= 0)
+        {
+            core->gainIdx = (unsigned int) idx;
+            core->steady  = 1;
+        }
+    }
+}
+#endif
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Core_Resume
+**
+** Purpose: To carry a restored checkpoint over the outage to the first fix after it
+**
+** Arguments:
+**    GPS_KALMAN_Core_t *core  - core, holding a restored state
+**    double dt                - time from the checkpoint to the fix, s, over
+**                               params.maxDtSec
+**
+** Returns:
+**    int - 1 if the state is now at the fix's time, 0 if the covariance grown over dt
+**          would not fit in GPS_KALMAN_Real_t, and the filter should restart instead
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. Done in double, once, so the long step does not overflow a float or fixed
+**       point F * P * F'. In fixed point only a short outage fits.
+**    2. A yaw rate means nothing after minutes off, so the heading is held as at a
+**       restart, and the first fast enough fix starts it again
+**
+** Algorithm:
+**    The constant velocity prediction P = F * P * F' + Q, x = F * x over the whole
+**    outage, with F = [I dt*I; 0 I] and Q = params.accelPsd * [dt^3/3 dt^2/2;
+**    dt^2/2 dt] per axis: the position variance grows by the closed form coast
+**    variance of GPS_KALMAN_Core_Coast for the actual outage.
+**=====================================================================================*/
+static int GPS_KALMAN_Core_Resume(GPS_KALMAN_Core_t *core, double dt)
+{
+    GPS_KALMAN_Data_t *data = &core->data;
+    double q = core->params.accelPsd;
+    double P[GPS_KALMAN_FILTER_LEN][GPS_KALMAN_FILTER_LEN];
+    double FP[GPS_KALMAN_FILTER_LEN][GPS_KALMAN_FILTER_LEN];
+    double Pn[GPS_KALMAN_FILTER_SYM_LEN];
+    int    i;
+    int    j;
+
+    /* Positions N, E come first and their velocities VN, VE two after them */
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        for (j = 0; j < GPS_KALMAN_FILTER_LEN; j++)
+        {
+            P[i][j] = GPS_KALMAN_R2D(data->PMatrixData[(i <= j) ?
+                          GPS_KALMAN_SYM_IDX(i, j) : GPS_KALMAN_SYM_IDX(j, i)]);
+        }
+    }
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        for (j = 0; j < GPS_KALMAN_FILTER_LEN; j++)
+        {
+            FP[i][j] = P[i][j] + ((i < 2) ? dt * P[i + 2][j] : 0.0);
+        }
+    }
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        for (j = i; j < GPS_KALMAN_FILTER_LEN; j++)
+        {
+            double v = FP[i][j] + ((j < 2) ? dt * FP[i][j + 2] : 0.0);
+
+            if ((i % 2) == (j % 2))
+            {
+                v += (j < 2) ? q * dt * dt * dt / 3.0 :
+                     (i < 2) ? q * dt * dt / 2.0 : q * dt;
+            }
+            Pn[GPS_KALMAN_SYM_IDX(i, j)] = v;
+        }
+    }
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        if (!(Pn[GPS_KALMAN_SYM_IDX(i, i)] <= GPS_KALMAN_R_MAX / 4.0))
+        {
+            return 0;
+        }
+    }
+
+    for (i = 0; i < GPS_KALMAN_FILTER_SYM_LEN; i++)
+    {
+        data->PMatrixData[i] = GPS_KALMAN_D2R(Pn[i]);
+    }
+    for (i = 0; i < 2; i++)
+    {
+        data->XHatData[i] = GPS_KALMAN_D2R(GPS_KALMAN_R2D(data->XHatData[i]) +
+                                           dt * GPS_KALMAN_R2D(data->XHatData[i + 2]));
+    }
+    if (core->hdgState != GPS_KALMAN_HDG_NONE)
+    {
+        GPS_KALMAN_Core_HdgHold(core);
+        core->hdgState = GPS_KALMAN_HDG_HELD;
+    }
+
+    return 1;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Core_Init
+**
+** Purpose: To reset the filter; the next fix starts it
+**
+** Arguments:
+**    GPS_KALMAN_Core_t *core  - core to reset
+**
+** Returns:
+**    None
+**=====================================================================================*/
+void GPS_KALMAN_Core_Init(GPS_KALMAN_Core_t *core)
+{
+    GPS_KALMAN_Data_t *data = &core->data;
+    GPS_KALMAN_Params_t params;
+    int i;
+
+    /* No fix yet, and no F and Q cached */
+    memset((void*) core, 0x00, sizeof(*core));
+    core->modelDt = -1.0;
+
+    GPS_KALMAN_Init_Matrix_Data(data);
+    GPS_KALMAN_Filter_Identity(data->FMatrixData, 1.0);
+    GPS_KALMAN_Filter_SymIdentity(data->PMatrixData, 0.0);    /* set from the first fix */
+    GPS_KALMAN_Filter_SymIdentity(data->QMatrixData, 0.0);    /* built from dt per fix */
+    GPS_KALMAN_Filter_Identity(data->HMatrixData, 1.0);
+    GPS_KALMAN_Filter_SymIdentity(data->SigmaExpectMatrixData, 1.0);
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        data->SigmaActualData[i] = GPS_KALMAN_R_ONE;
+    }
+    GPS_KALMAN_Filter_Identity(data->KMatrixData, 0.0);
+
+    GPS_KALMAN_Core_DefaultParams(&params);
+    GPS_KALMAN_Core_SetParams(core, &params);
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Core_DefaultParams
+**
+** Purpose: To fill in the tuning of gps_kalman_platform_cfg.h
+**
+** Arguments:
+**    GPS_KALMAN_Params_t *params  - parameters (output)
+**
+** Returns:
+**    None
+**=====================================================================================*/
+void GPS_KALMAN_Core_DefaultParams(GPS_KALMAN_Params_t *params)
+{
+    int i;
+
+    for (i = 0; i < GPS_KALMAN_SOURCE_MAX; i++)
+    {
+        params->source[i].uereM       = GPS_KALMAN_UERE_M;
+        params->source[i].velSigmaMps = GPS_KALMAN_VEL_SIGMA_MPS;
+        params->source[i].latencySec  = GPS_KALMAN_LATENCY_SEC;
+    }
+    params->accelPsd     = GPS_KALMAN_ACCEL_PSD;
+    params->initVarScale = GPS_KALMAN_INIT_VAR_SCALE;
+    params->dtQuantumSec = GPS_KALMAN_DT_QUANTUM_SEC;
+    params->maxDtSec     = GPS_KALMAN_MAX_DT_SEC;
+    params->enuMaxRangeM   = GPS_KALMAN_ENU_MAX_RANGE_M;
+    params->gateChi2       = GPS_KALMAN_GATE_CHI2;
+    params->gateMaxRejects = GPS_KALMAN_GATE_MAX_REJECTS;
+    params->spare          = 0;
+    params->hdgMinSpeedKph = GPS_KALMAN_HDG_MIN_SPEED_KPH;
+    params->yawAccelPsd    = GPS_KALMAN_YAW_ACCEL_PSD;
+    params->yawRateSigma0  = GPS_KALMAN_YAW_RATE_SIGMA0;
+    params->steadyGainTol     = GPS_KALMAN_STEADY_GAIN_TOL;
+    params->steadySettleFixes = GPS_KALMAN_STEADY_SETTLE_FIXES;
+    params->spare2            = 0;
+    params->coastMaxSec       = GPS_KALMAN_COAST_MAX_SEC;
+    params->resumeMaxSec      = GPS_KALMAN_RESUME_MAX_SEC;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Core_CheckParams
+**
+** Purpose: To range check tuning before it is used
+**
+** Arguments:
+**    const GPS_KALMAN_Params_t *params  - parameters
+**
+** Returns:
+**    NULL if all are in range, else the name of the first that is not
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. Every check fails for NaN
+**    2. The local frame range is also limited to what GPS_KALMAN_Real_t holds, with
+**       room for the state to run past it before the frame moves
+**    3. A gate below 1 would turn away most consistent fixes, so it is either off (0)
+**       or at least 1
+**    4. Every receiver entry is checked, flown or not. A latency must be shorter
+**       than maxDtSec.
+**    5. hdgMinSpeedKph must be over 0, which bounds the heading measurement variance
+**    6. coastMaxSec is at most maxDtSec, past which the state is not kept anyway
+**    7. resumeMaxSec is at least maxDtSec, as a restored state is otherwise kept for
+**       no longer than any other
+**=====================================================================================*/
+const char *GPS_KALMAN_Core_CheckParams(const GPS_KALMAN_Params_t *params)
+{
+    const char *bad = NULL;
+    int i;
+
+    if (!GPS_KALMAN_CORE_IN_RANGE(params->accelPsd, 0.0, 10000.0))
+    {
+        bad = "accelPsd";
+    }
+    else if (!GPS_KALMAN_CORE_IN_RANGE(params->initVarScale, 0.0, 1.0e6))
+    {
+        bad = "initVarScale";
+    }
+    else if (!GPS_KALMAN_CORE_IN_RANGE(params->dtQuantumSec, 1.0e-6, 1.0))
+    {
+        bad = "dtQuantumSec";
+    }
+    else if (!GPS_KALMAN_CORE_IN_RANGE(params->maxDtSec, params->dtQuantumSec, 3600.0))
+    {
+        bad = "maxDtSec";
+    }
+    else if (!GPS_KALMAN_CORE_IN_RANGE(params->enuMaxRangeM, 0.0,
+                                       fmin(100000.0, GPS_KALMAN_R_MAX / 4.0)))
+    {
+        bad = "enuMaxRangeM";
+    }
+    else if (!((params->gateChi2 == 0.0) ||
+               GPS_KALMAN_CORE_IN_RANGE(params->gateChi2, 1.0, 10000.0)))
+    {
+        bad = "gateChi2";
+    }
+    else if (!GPS_KALMAN_CORE_IN_RANGE(params->gateMaxRejects, 0, 1000))
+    {
+        bad = "gateMaxRejects";
+    }
+    else if (!GPS_KALMAN_CORE_IN_RANGE(params->hdgMinSpeedKph, 0.0, 1000.0))
+    {
+        bad = "hdgMinSpeedKph";
+    }
+    else if (!GPS_KALMAN_CORE_IN_RANGE(params->yawAccelPsd, 0.0, 1.0e6))
+    {
+        bad = "yawAccelPsd";
+    }
+    else if (!GPS_KALMAN_CORE_IN_RANGE(params->yawRateSigma0, 0.0, 1000.0))
+    {
+        bad = "yawRateSigma0";
+    }
+    else if (!((params->steadyGainTol == 0.0) ||
+               GPS_KALMAN_CORE_IN_RANGE(params->steadyGainTol, 0.0, 0.01)))
+    {
+        bad = "steadyGainTol";
+    }
+    else if (!GPS_KALMAN_CORE_IN_RANGE(params->steadySettleFixes, 0, 100000))
+    {
+        bad = "steadySettleFixes";
+    }
+    else if (!GPS_KALMAN_CORE_IN_RANGE(params->coastMaxSec, 0.0, params->maxDtSec))
+    {
+        bad = "coastMaxSec";
+    }
+    else if (!((params->resumeMaxSec >= params->maxDtSec) &&
+               (params->resumeMaxSec <= 86400.0)))
+    {
+        bad = "resumeMaxSec";
+    }
+
+    /* After maxDtSec, which bounds the latencies */
+    for (i = 0; (i < GPS_KALMAN_SOURCE_MAX) && (bad == NULL); i++)
+    {
+        if (!GPS_KALMAN_CORE_IN_RANGE(params->source[i].uereM, 0.0, 1000.0))
+        {
+            bad = "source.uereM";
+        }
+        else if (!GPS_KALMAN_CORE_IN_RANGE(params->source[i].velSigmaMps, 0.0, 100.0))
+        {
+            bad = "source.velSigmaMps";
+        }
+        else if (!((params->source[i].latencySec >= 0.0) &&
+                   (params->source[i].latencySec < params->maxDtSec)))
+        {
+            bad = "source.latencySec";
+        }
+    }
+
+    return bad;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Core_SetParams
+**
+** Purpose: To change the tuning without resetting the filter
+**
+** Arguments:
+**    GPS_KALMAN_Core_t *core             - core
+**    const GPS_KALMAN_Params_t *params   - parameters that passed
+**                                          GPS_KALMAN_Core_CheckParams
+**
+** Returns:
+**    None
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. The state and covariance are kept, and the next fix is filtered with the new
+**       parameters. Everything derived from them alone is worked out here, once,
+**       rather than per fix.
+**=====================================================================================*/
+void GPS_KALMAN_Core_SetParams(GPS_KALMAN_Core_t *core, const GPS_KALMAN_Params_t *params)
+{
+    int i;
+
+    core->params       = *params;
+    core->dtQuantumInv = 1.0 / params->dtQuantumSec;
+    for (i = 0; i < GPS_KALMAN_SOURCE_MAX; i++)
+    {
+        core->velVar[i] = params->source[i].velSigmaMps * params->source[i].velSigmaMps;
+    }
+
+    /* Q scales with the noise density, so rebuild F and Q at the next fix, and let
+    ** the gain settle again with none of the cached gains */
+    core->modelDt   = -1.0;
+    core->steady    = 0;
+    core->settled   = 0;
+    core->gainCount = 0;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Core_Save
+**
+** Purpose: To copy what the filter needs to resume into a checkpoint
+**
+** Arguments:
+**    const GPS_KALMAN_Core_t *core  - core
+**    GPS_KALMAN_Checkpoint_t *ckpt  - checkpoint (output)
+**
+** Returns:
+**    None
+**=====================================================================================*/
+void GPS_KALMAN_Core_Save(const GPS_KALMAN_Core_t *core, GPS_KALMAN_Checkpoint_t *ckpt)
+{
+    const GPS_KALMAN_Data_t *data = &core->data;
+    int i;
+
+    memset((void*) ckpt, 0x00, sizeof(*ckpt));
+    if (!core->init)
+    {
+        return;
+    }
+
+    ckpt->magic       = GPS_KALMAN_CHECKPOINT_MAGIC;
+    ckpt->lastFixTime = core->lastFixTime;
+    ckpt->anchorLat   = core->anchor.lat0;
+    ckpt->anchorLon   = core->anchor.lon0;
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        ckpt->x[i] = GPS_KALMAN_R2D(data->XHatData[i]);
+    }
+    for (i = 0; i < GPS_KALMAN_FILTER_SYM_LEN; i++)
+    {
+        ckpt->P[i] = GPS_KALMAN_R2D(data->PMatrixData[i]);
+    }
+    if (core->hdgState != GPS_KALMAN_HDG_NONE)
+    {
+        ckpt->hdgState = (uint32_t) core->hdgState;
+        memcpy(ckpt->hdg, core->hdg, sizeof(ckpt->hdg));
+        memcpy(ckpt->hdgP, core->hdgP, sizeof(ckpt->hdgP));
+    }
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Core_Restore
+**
+** Purpose: To resume the filter from a checkpoint
+**
+** Arguments:
+**    GPS_KALMAN_Core_t *core              - core, with its parameters set
+**    const GPS_KALMAN_Checkpoint_t *ckpt  - checkpoint
+**
+** Returns:
+**    GPS_KALMAN_FILTER_SUCCESS       - the state is the checkpoint's
+**    GPS_KALMAN_CORE_SKIP            - the checkpoint holds no state
+**    GPS_KALMAN_CORE_ERR_CHECKPOINT  - the checkpoint is not a usable state
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. The next fix predicts from the checkpoint's time as from any other, but may
+**       be up to params.resumeMaxSec later rather than params.maxDtSec; see
+**       GPS_KALMAN_Core_Resume. If it is later still the filter restarts from it as
+**       usual, so a stale checkpoint does no harm.
+**    2. Checked: every value finite, the anchor a valid position, the state within
+**       the local frame range and the covariance diagonal positive, and the same
+**       for the heading if there is one
+**=====================================================================================*/
+int GPS_KALMAN_Core_Restore(GPS_KALMAN_Core_t *core, const GPS_KALMAN_Checkpoint_t *ckpt)
+{
+    GPS_KALMAN_Data_t *data = &core->data;
+    int status = GPS_KALMAN_FILTER_SUCCESS;
+    int i;
+
+    if (ckpt->magic != GPS_KALMAN_CHECKPOINT_MAGIC)
+    {
+        status = (ckpt->magic == 0) ? GPS_KALMAN_CORE_SKIP : GPS_KALMAN_CORE_ERR_CHECKPOINT;
+        goto GPS_KALMAN_Core_Restore_Exit_Tag;
+    }
+
+    status = GPS_KALMAN_CORE_ERR_CHECKPOINT;
+    if (!isfinite(ckpt->lastFixTime) ||
+        !(fabs(ckpt->anchorLat) <= 90.0) || !(fabs(ckpt->anchorLon) <= 360.0) ||
+        !(fabs(ckpt->x[GPS_KALMAN_STATE_N]) <= 2.0 * core->params.enuMaxRangeM) ||
+        !(fabs(ckpt->x[GPS_KALMAN_STATE_E]) <= 2.0 * core->params.enuMaxRangeM))
+    {
+        goto GPS_KALMAN_Core_Restore_Exit_Tag;
+    }
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        if (!isfinite(ckpt->x[i]) || !(ckpt->P[GPS_KALMAN_SYM_IDX(i, i)] > 0.0))
+        {
+            goto GPS_KALMAN_Core_Restore_Exit_Tag;
+        }
+    }
+    for (i = 0; i < GPS_KALMAN_FILTER_SYM_LEN; i++)
+    {
+        if (!isfinite(ckpt->P[i]))
+        {
+            goto GPS_KALMAN_Core_Restore_Exit_Tag;
+        }
+    }
+    if (ckpt->hdgState > GPS_KALMAN_HDG_HELD)
+    {
+        goto GPS_KALMAN_Core_Restore_Exit_Tag;
+    }
+    if ((ckpt->hdgState != GPS_KALMAN_HDG_NONE) &&
+        (!(ckpt->hdg[GPS_KALMAN_HDG] >= 0.0) || !(ckpt->hdg[GPS_KALMAN_HDG] < 360.0) ||
+         !isfinite(ckpt->hdg[GPS_KALMAN_HDG_RATE]) ||
+         !(ckpt->hdgP[0] > 0.0) || !isfinite(ckpt->hdgP[0]) || !isfinite(ckpt->hdgP[1]) ||
+         !(ckpt->hdgP[2] > 0.0) || !isfinite(ckpt->hdgP[2])))
+    {
+        goto GPS_KALMAN_Core_Restore_Exit_Tag;
+    }
+
+    enu_anchor_set(&core->anchor, ckpt->anchorLat, ckpt->anchorLon);
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        data->XHatData[i] = GPS_KALMAN_D2R(ckpt->x[i]);
+    }
+    for (i = 0; i < GPS_KALMAN_FILTER_SYM_LEN; i++)
+    {
+        data->PMatrixData[i] = GPS_KALMAN_D2R(ckpt->P[i]);
+    }
+    memcpy(core->hdg, ckpt->hdg, sizeof(core->hdg));
+    memcpy(core->hdgP, ckpt->hdgP, sizeof(core->hdgP));
+    core->hdgState    = (int) ckpt->hdgState;
+    core->hdgUse      = 0;
+    core->steady      = 0;
+    core->settled     = 0;
+    core->lastFixTime = ckpt->lastFixTime;
+    core->lastSource  = 0;
+    core->init        = 1;
+    core->dt          = 0.0;
+    core->rejects     = 0;
+    core->resumed     = 1;
+    status = GPS_KALMAN_FILTER_SUCCESS;
+
+GPS_KALMAN_Core_Restore_Exit_Tag:
+    return status;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Core_Prepare
+**
+** Purpose: To load a fix as the measurement and set up the step to it
+**
+** Arguments:
+**    GPS_KALMAN_Core_t *core       - core
+**    const GPS_KALMAN_Fix_t *fix   - good fix
+**
+** Returns:
+**    GPS_KALMAN_FILTER_SUCCESS  - predict and update should follow
+**    GPS_KALMAN_CORE_RESTART    - the state was set from the fix
+**    GPS_KALMAN_CORE_SKIP       - the fix is not newer than the state, or its receiver
+**                                 is unknown; nothing changed
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. The first fix, or the first after a gap of more than params.maxDtSec,
+**       restarts the state and anchors the local frame at the fix. A fix more than
+**       params.enuMaxRangeM from the anchor moves it. The first fix after
+**       GPS_KALMAN_Core_Restore may instead be up to params.resumeMaxSec after the
+**       checkpoint; GPS_KALMAN_Core_Resume carries the state over the gap, and the
+**       fix updates it with no further prediction.
+**    2. dt is rounded to params.dtQuantumSec, and F and Q are rebuilt only when
+**       it changes
+**    3. After params.gateMaxRejects gated updates in a row the state is taken to be
+**       lost, and the next fix restarts it as after a gap
+**    4. The fix is taken to be params.source[fix->source].latencySec older than its
+**       time stamp, and is weighted with that receiver's noise model. Receivers'
+**       fixes interleave in time; one older than the state is skipped, and one from
+**       another receiver at the same time as the state updates it without a
+**       prediction (a zero time step).
+**    5. The fix updates the heading filter only at params.hdgMinSpeedKph or over.
+**       Its heading is the direction of its velocity, so its variance is taken as
+**       (velocity sigma / speed)^2 radians squared.
+**    6. A frozen steady-state gain is kept only for a fix with the dt it was frozen
+**       at. A fix with other measurement variances, e.g. after a DOP change, takes
+**       the cached gain frozen at those, bit for bit, and its K and S are reported
+**       from then on. Otherwise, after a rate change or a DOP not in the cache, the
+**       full filter resumes from the steady-state covariance, and
+**       GPS_KALMAN_Core_Settle caches the new gain once it has settled.
+**    7. Off a frozen gain, each fix also looks up the cache, and goes back to the
+**       cached gain for its dt and measurement variances as soon as P is within
+**       params.steadyGainTol of that gain's steady state (GPS_KALMAN_Core_GainNear),
+**       rather than waiting params.steadySettleFixes updates to freeze it again
+**=====================================================================================*/
+int GPS_KALMAN_Core_Prepare(GPS_KALMAN_Core_t *core, const GPS_KALMAN_Fix_t *fix)
+{
+    int    status = GPS_KALMAN_FILTER_SUCCESS;
+    int    i;
+    int    restart;
+    int    resumed;
+    double pos_var;
+    double vel_var;
+    double mu[GPS_KALMAN_FILTER_LEN];
+    GPS_KALMAN_Data_t *data = &core->data;
+    const GPS_KALMAN_SourceParams_t *src;
+    double time;
+    double dt;
+
+    if (fix->source >= GPS_KALMAN_SOURCE_MAX)
+    {
+        status = GPS_KALMAN_CORE_SKIP;
+        goto GPS_KALMAN_Core_Prepare_Exit_Tag;
+    }
+    src     = &core->params.source[fix->source];
+    vel_var = core->velVar[fix->source];
+    time    = fix->time - src->latencySec;
+    dt      = time - core->lastFixTime;
+
+    /* The first fix after a restore may come up to params.resumeMaxSec later; the
+    ** state is then brought up to it here, and the step to it is 0 */
+    resumed = core->resumed && core->init && (dt > core->params.maxDtSec) &&
+              (dt <= core->params.resumeMaxSec) && GPS_KALMAN_Core_Resume(core, dt);
+    core->resumed = 0;
+    if (resumed)
+    {
+        dt = 0.0;
+    }
+
+    /* (Re)start from the fix itself when there is no usable previous one. The local
+    ** frame is anchored at that fix. */
+    restart = !core->init || (dt > core->params.maxDtSec) ||
+              (core->rejects >= core->params.gateMaxRejects);
+    if (restart)
+    {
+        enu_anchor_set(&core->anchor, fix->lat, fix->lon);
+    }
+    else
+    {
+        /* A repeated or out of order time stamp carries no new information, but
+        ** another receiver's fix of the same instant does */
+        dt = floor(dt * core->dtQuantumInv + 0.5) * core->params.dtQuantumSec;
+        if ((dt < 0.0) || ((dt == 0.0) && (fix->source == core->lastSource) && !resumed))
+        {
+            status = GPS_KALMAN_CORE_SKIP;
+            goto GPS_KALMAN_Core_Prepare_Exit_Tag;
+        }
+    }
+
+    /* MuActual = Actual measurement in the local frame: north/east position and
+    ** velocity, metres and m/s */
+    geodetic2enu_fast(&core->anchor, fix->lat, fix->lon,
+            &mu[GPS_KALMAN_STATE_E], &mu[GPS_KALMAN_STATE_N]);
+    speed_heading2north_east(fix->vel, fix->hdg,
+            &mu[GPS_KALMAN_STATE_VN], &mu[GPS_KALMAN_STATE_VE]);
+
+    /* Far from the anchor the flat frame distorts, so move the anchor to this fix and
+    ** carry the state position across through latitude and longitude */
+    if ((fabs(mu[GPS_KALMAN_STATE_E]) > core->params.enuMaxRangeM) ||
+        (fabs(mu[GPS_KALMAN_STATE_N]) > core->params.enuMaxRangeM))
+    {
+        double state_lat;
+        double state_lon;
+        double state_e;
+        double state_n;
+
+        enu2geodetic_fast(&core->anchor,
+                GPS_KALMAN_R2D(data->XHatData[GPS_KALMAN_STATE_E]),
+                GPS_KALMAN_R2D(data->XHatData[GPS_KALMAN_STATE_N]),
+                &state_lat, &state_lon);
+        enu_anchor_set(&core->anchor, fix->lat, fix->lon);
+        geodetic2enu_fast(&core->anchor, state_lat, state_lon, &state_e, &state_n);
+        data->XHatData[GPS_KALMAN_STATE_E] = GPS_KALMAN_D2R(state_e);
+        data->XHatData[GPS_KALMAN_STATE_N] = GPS_KALMAN_D2R(state_n);
+        mu[GPS_KALMAN_STATE_E] = 0.0;
+        mu[GPS_KALMAN_STATE_N] = 0.0;
+    }
+
+    /* SigmaActual: position from DOP and the receiver's range error, velocity from
+    ** its velocity noise. The position variance is capped so that P + SigmaActual
+    ** stays in range in fixed point. */
+    pos_var = fabs(fix->dop) * src->uereM;
+    pos_var = fmin(pos_var * pos_var, GPS_KALMAN_R_MAX / 4.0);
+    data->SigmaActualData[GPS_KALMAN_STATE_N]  = GPS_KALMAN_D2R(pos_var);
+    data->SigmaActualData[GPS_KALMAN_STATE_E]  = GPS_KALMAN_D2R(pos_var);
+    data->SigmaActualData[GPS_KALMAN_STATE_VN] = GPS_KALMAN_D2R(vel_var);
+    data->SigmaActualData[GPS_KALMAN_STATE_VE] = GPS_KALMAN_D2R(vel_var);
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        data->MuActualData[i] = GPS_KALMAN_D2R(mu[i]);
+    }
+
+    /* Heading measurement, if the fix is moving fast enough for it to mean anything */
+    core->hdgUse = (fix->vel >= core->params.hdgMinSpeedKph) && isfinite(fix->hdg);
+    if (core->hdgUse)
+    {
+        double hdg_sigma = src->velSigmaMps * 3.6 / fix->vel * GPS_KALMAN_CORE_RAD2DEG;
+
+        core->hdgMeas = GPS_KALMAN_Core_WrapHdg(fix->hdg);
+        core->hdgVar  = hdg_sigma * hdg_sigma;
+    }
+
+    core->lastFixTime = time;
+    core->lastSource  = fix->source;
+
+    if (restart)
+    {
+        double scale = core->params.initVarScale;
+
+        GPS_KALMAN_Filter_SymIdentity(data->PMatrixData, 0.0);
+        for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+        {
+            data->XHatData[i] = data->MuActualData[i];
+        }
+        data->PMatrixData[GPS_KALMAN_SYM_IDX(GPS_KALMAN_STATE_N, GPS_KALMAN_STATE_N)] =
+            GPS_KALMAN_D2R(fmin(pos_var * scale, GPS_KALMAN_R_MAX));
+        data->PMatrixData[GPS_KALMAN_SYM_IDX(GPS_KALMAN_STATE_E, GPS_KALMAN_STATE_E)] =
+            GPS_KALMAN_D2R(fmin(pos_var * scale, GPS_KALMAN_R_MAX));
+        data->PMatrixData[GPS_KALMAN_SYM_IDX(GPS_KALMAN_STATE_VN, GPS_KALMAN_STATE_VN)] =
+            GPS_KALMAN_D2R(fmin(vel_var * scale, GPS_KALMAN_R_MAX));
+        data->PMatrixData[GPS_KALMAN_SYM_IDX(GPS_KALMAN_STATE_VE, GPS_KALMAN_STATE_VE)] =
+            GPS_KALMAN_D2R(fmin(vel_var * scale, GPS_KALMAN_R_MAX));
+        core->init    = 1;
+        core->dt      = 0.0;
+        core->rejects = 0;
+        core->steady     = 0;
+        core->steadyStep = 0;
+        core->settled    = 0;
+
+        /* A fix that is too slow for a heading leaves the last one standing, as the
+        ** best guess there is, until one that is fast enough */
+        if (core->hdgUse)
+        {
+            GPS_KALMAN_Core_HdgStart(core);
+        }
+        else if (core->hdgState != GPS_KALMAN_HDG_NONE)
+        {
+            GPS_KALMAN_Core_HdgHold(core);
+            core->hdgState = GPS_KALMAN_HDG_HELD;
+        }
+        status = GPS_KALMAN_CORE_RESTART;
+        goto GPS_KALMAN_Core_Prepare_Exit_Tag;
+    }
+
+    /* F and Q only change with dt, so a steady fix rate never rebuilds them */
+    if (dt != core->modelDt)
+    {
+        GPS_KALMAN_Filter_CVModel(dt, core->params.accelPsd,
+                data->FMatrixData, data->QMatrixData);
+        core->modelDt = dt;
+    }
+    core->dt = dt;
+
+    core->steadyStep = 0;
+    if (core->steady && (dt != core->gainCache[core->gainIdx].dt))
+    {
+        core->steady  = 0;
+        core->settled = 0;
+    }
+    else if (core->steady &&
+             (memcmp(data->SigmaActualData, core->gainCache[core->gainIdx].R,
+                     sizeof(core->gainCache[core->gainIdx].R)) != 0))
+    {
+        i = GPS_KALMAN_Core_GainFind(core, dt, data->SigmaActualData);
+        if (i >= 0)
+        {
+            core->gainHits++;
+            core->gainIdx = (unsigned int) i;
+            memcpy(data->KMatrixData, core->gainCache[i].K, sizeof(data->KMatrixData));
+            memcpy(data->SigmaExpectMatrixData, core->gainCache[i].S,
+                   sizeof(data->SigmaExpectMatrixData));
+        }
+        else
+        {
+            core->gainMisses++;
+            core->steady  = 0;
+            core->settled = 0;
+        }
+    }
+    else if (!core->steady && (core->params.steadyGainTol != 0.0))
+    {
+        /* Off a cached gain, after a gated fix or a miss, the full filter brings P
+        ** back towards the steady state; once it is there the cached gain is the
+        ** one it would settle to again */
+        i = GPS_KALMAN_Core_GainFind(core, dt, data->SigmaActualData);
+        if ((i >= 0) && GPS_KALMAN_Core_GainNear(core, &core->gainCache[i]))
+        {
+            core->gainHits++;
+            core->steady  = 1;
+            core->gainIdx = (unsigned int) i;
+            memcpy(data->KMatrixData, core->gainCache[i].K, sizeof(data->KMatrixData));
+            memcpy(data->SigmaExpectMatrixData, core->gainCache[i].S,
+                   sizeof(data->SigmaExpectMatrixData));
+        }
+    }
+
+    if (core->steady)
+    {
+        core->steadyStep = 1;
+        core->gainCache[core->gainIdx].lastUse = ++core->gainClock;
+    }
+
+GPS_KALMAN_Core_Prepare_Exit_Tag:
+    return status;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Core_Predict
+**
+** Purpose: To propagate the state and covariance to the prepared fix
+**
+** Arguments:
+**    GPS_KALMAN_Core_t *core  - core
+**
+** Returns:
+**    None
+**
+** Algorithm:
+**    x = F * x, P = F * P * F' + Q, by the fixed-size kernel in gps_kalman_filter.c,
+**    or with GPS_KALMAN_USE_GSL by the original generic GSL BLAS calls on the same
+**    arrays, so the two can be compared for equivalence and cycle count.
+**    With a frozen steady-state gain only x = F * x, and P is the steady-state
+**    prediction. Then the heading filter, the same way on its own two states.
+**=====================================================================================*/
+void GPS_KALMAN_Core_Predict(GPS_KALMAN_Core_t *core)
+{
+    GPS_KALMAN_Data_t *data = &core->data;
+#ifdef GPS_KALMAN_USE_GSL
+    GPS_KALMAN_GslData_t *gsl = &data->gsl;
+
+    /* The GSL path works on full-storage copies of the packed covariances */
+    GPS_KALMAN_Filter_SymUnpack(data->PMatrixData, gsl->PMatrix->data);
+    GPS_KALMAN_Filter_SymUnpack(data->QMatrixData, gsl->QMatrix->data);
+
+    /* Predict the next state */
+    /* DGEMV: y = alpha*op(A)*x + Beta*y */
+    /* With CblasNoTrans, op(A) = A */
+    /* x_k+1 = F_k * x_k */
+    gsl_blas_dgemv(CblasNoTrans, 1.0, gsl->FMatrix, gsl->XHat, 0.0, gsl->XHatNext);
+
+    /* Next covariance: P = F * P * F' + Q */
+    /* DGEMM: C = alpha*opa(A)*opb(B) + beta*C */
+    /* P = 1:(F * P) * F' + Q */
+    gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, gsl->FMatrix, gsl->PMatrix,
+            0.0, gsl->TmpMatrix);
+    /* P = 2:(1:(tmp) * F') + Q */
+    gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, gsl->TmpMatrix, gsl->FMatrix,
+            0.0, gsl->PMatrix);
+    /* P = 3:(2:(1:(tmp) * F') + Q) */
+    gsl_matrix_add(gsl->PMatrix, gsl->QMatrix);
+
+    /* state <- state_next, and back to packed storage between the two steps */
+    gsl_vector_memcpy(gsl->XHat, gsl->XHatNext);
+    GPS_KALMAN_Filter_SymPack(gsl->PMatrix->data, data->PMatrixData);
+#else
+    if (core->steadyStep)
+    {
+        GPS_KALMAN_Filter_SteadyPredict(data->FMatrixData, data->XHatData);
+        memcpy(data->PMatrixData, core->gainCache[core->gainIdx].PPrior,
+               sizeof(data->PMatrixData));
+    }
+    else
+    {
+        GPS_KALMAN_Filter_Predict(data->FMatrixData, data->QMatrixData,
+                data->XHatData, data->PMatrixData);
+    }
+#endif
+
+    GPS_KALMAN_Core_HdgPredict(core);
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Core_Update
+**
+** Purpose: To update the state and covariance with the prepared fix
+**
+** Arguments:
+**    GPS_KALMAN_Core_t *core  - core
+**
+** Returns:
+**    GPS_KALMAN_FILTER_SUCCESS
+**    GPS_KALMAN_FILTER_ERR_NOT_PD if the innovation covariance is not positive
+**    definite, or GPS_KALMAN_FILTER_ERR_GATED if the innovation is outside
+**    params.gateChi2; the state and covariance are left at the prediction
+**
+** Algorithm:
+**    S = P + SigmaActual. The squared Mahalanobis distance of the innovation,
+**    d2 = (mu1 - x)' * S^-1 * (mu1 - x), is worked out along with the gain, and the
+**    update is skipped if it is over the gate. Otherwise K = P * S^-1,
+**    x += K * (mu1 - x), P = (I - K) * P * (I - K)' + K * SigmaActual * K' (Joseph
+**    form). SigmaActual is diagonal, so by default this is done as one scalar update
+**    per component with no inverse; GPS_KALMAN_UPDATE_FORM_JOINT solves for K with
+**    a Cholesky factor of S instead.
+**    With GPS_KALMAN_USE_GSL, the original LU inverse, which d2 reuses, and
+**    P = P - K * H * P.
+**    With a frozen steady-state gain, d2 from the frozen S^-1 and x += K * (mu1 - x)
+**    only, and P is the steady-state update; a gated fix leaves P at the
+**    prediction and unfreezes the gain. Otherwise a full update also tells
+**    GPS_KALMAN_Core_Settle how far its gain moved.
+**    A fix that updated the state and is fast enough for its heading then updates,
+**    or starts, the heading filter; a gated one does neither.
+**=====================================================================================*/
+int GPS_KALMAN_Core_Update(GPS_KALMAN_Core_t *core)
+{
+    int status = GPS_KALMAN_FILTER_SUCCESS;
+#ifdef GPS_KALMAN_USE_GSL
+    GPS_KALMAN_Data_t *data = &core->data;
+    GPS_KALMAN_GslData_t *gsl = &data->gsl;
+    int i;
+    int signum;
+
+    GPS_KALMAN_Filter_SymUnpack(data->PMatrixData, gsl->PMatrix->data);
+
+    gsl_matrix_set_zero(gsl->SigmaActualMatrix);
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        gsl_matrix_set(gsl->SigmaActualMatrix, i, i, data->SigmaActualData[i]);
+    }
+
+    /* MuExpected = H * XHatNext */
+    gsl_blas_dgemv(CblasNoTrans, 1.0, gsl->HMatrix, gsl->XHatNext, 0.0, gsl->MuExpected);
+    /* SigmaExpectMatrix = H * P * H' */
+    /* SigmaExpectMatrix = 1:(H * P) * H' */
+    gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, gsl->HMatrix, gsl->PMatrix,
+            0.0, gsl->TmpMatrix);
+    /* SigmaExpectMatrix = 2:(1:(tmp) * H') */
+    gsl_blas_dgemm(CblasNoTrans, CblasTrans,   1.0, gsl->TmpMatrix, gsl->HMatrix,
+            0.0, gsl->SigmaExpectMatrix);
+
+    /* K = SigmaExpectMatrix * (SigmaExpectMatrix + SigmaActualMatrix)^-1 */
+    /* (1) K = SigmaExpectMatrix * (1:(SigmaExpectMatrix + SigmaActualMatrix))^-1 */
+    gsl_matrix_memcpy(gsl->TmpMatrix, gsl->SigmaExpectMatrix); /* tmp <-  sigma0 */
+    gsl_matrix_add(gsl->SigmaExpectMatrix, gsl->SigmaActualMatrix); /* sigma0 <- sigma0 + sigma1 */
+    gsl_matrix_swap(gsl->TmpMatrix, gsl->SigmaExpectMatrix); /* sigma0 <-> tmp */
+
+    /*  TmpMatrix = $1 = SigmaExpectMatrix + SigmaActualMatrix */
+    /* (2) K = SigmaExpectMatrix * 2:($1^-1) */
+    gsl_linalg_LU_decomp(gsl->TmpMatrix, gsl->GSLPermutation, &signum);
+    gsl_linalg_LU_invert(gsl->TmpMatrix, gsl->GSLPermutation, gsl->TmpMatrix2);
+
+    /* TmpMatrix2 = $2 */
+    /* (3) K = 3:(SigmaExpectMatrix * $2) */
+    gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, gsl->SigmaExpectMatrix, gsl->TmpMatrix2,
+            0.0, gsl->KMatrix);
+
+    /* state_next = state_next + K * (mu1 - mu0) */
+    /* (1) state_next = state_next + K * 1:(mu1 - mu0) */
+    gsl_vector_sub(gsl->MuActual, gsl->MuExpected);
+    /* mu1 = $1 */
+
+    /* Keep the packed innovation covariance comparable with the kernel's */
+    GPS_KALMAN_Filter_SymPack(gsl->SigmaExpectMatrix->data, data->SigmaExpectMatrixData);
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        data->SigmaExpectMatrixData[GPS_KALMAN_SYM_IDX(i, i)] += data->SigmaActualData[i];
+    }
+
+    /* d2 = $1' * 2:($1^-1) * $1, the state and covariance stay at the prediction
+    ** outside the gate */
+    gsl_blas_dgemv(CblasNoTrans, 1.0, gsl->TmpMatrix2, gsl->MuActual, 0.0, gsl->MuExpected);
+    gsl_blas_ddot(gsl->MuActual, gsl->MuExpected, &core->d2);
+    if ((core->params.gateChi2 > 0.0) && !(core->d2 <= core->params.gateChi2))
+    {
+        status = GPS_KALMAN_FILTER_ERR_GATED;
+        goto GPS_KALMAN_Core_Update_Exit_Tag;
+    }
+
+    /* (2) state_next = 2:(K * 1:(mu1 - mu0) + state_next) */
+    gsl_blas_dgemv(CblasNoTrans, 1.0, gsl->KMatrix, gsl->MuActual, 1.0, gsl->XHatNext);
+
+    /* P = K * H * P - P */
+    /* (1) P = K * 1:(H * P) - P */
+    gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, gsl->HMatrix, gsl->PMatrix,
+            0.0, gsl->TmpMatrix);
+    /* TmpMatrix = $1 */
+    /* (2) P = 2:(K * 1:(H * P) - P) */
+    gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, -1.0, gsl->KMatrix, gsl->TmpMatrix,
+            1.0, gsl->PMatrix);
+
+    /* state <- state_next */
+    gsl_vector_memcpy(gsl->XHat, gsl->XHatNext);
+
+    /* back to packed storage, which also removes any asymmetry GSL introduced */
+    GPS_KALMAN_Filter_SymPack(gsl->PMatrix->data, data->PMatrixData);
+
+GPS_KALMAN_Core_Update_Exit_Tag:
+#else
+    GPS_KALMAN_Data_t *data = &core->data;
+
+    if (core->steadyStep)
+    {
+        const GPS_KALMAN_Gain_t *gain = &core->gainCache[core->gainIdx];
+
+        status = GPS_KALMAN_Filter_SteadyUpdate(data->MuActualData, gain->K, gain->Sinv,
+                    data->XHatData, core->params.gateChi2, &core->d2);
+        if (status == GPS_KALMAN_FILTER_SUCCESS)
+        {
+            memcpy(data->PMatrixData, gain->PPost, sizeof(data->PMatrixData));
+        }
+        else
+        {
+            core->steady  = 0;
+            core->settled = 0;
+        }
+    }
+    else
+    {
+        status = GPS_KALMAN_Filter_Update(data->MuActualData, data->SigmaActualData,
+                    data->XHatData, data->PMatrixData, data->SigmaExpectMatrixData,
+                    data->KMatrixData, core->params.gateChi2, &core->d2);
+        GPS_KALMAN_Core_Settle(core, status);
+    }
+#endif
+
+    /* Only consecutive rejections count towards a restart */
+    if (status == GPS_KALMAN_FILTER_ERR_GATED)
+    {
+        core->rejects++;
+    }
+    else if (status == GPS_KALMAN_FILTER_SUCCESS)
+    {
+        core->rejects = 0;
+        if (core->hdgUse && (core->hdgState == GPS_KALMAN_HDG_TRACKING))
+        {
+            GPS_KALMAN_Core_HdgUpdate(core);
+        }
+        else if (core->hdgUse)
+        {
+            GPS_KALMAN_Core_HdgStart(core);
+        }
+    }
+
+    return status;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Core_Step
+**
+** Purpose: To run the filter on one fix
+**
+** Arguments:
+**    GPS_KALMAN_Core_t *core       - core
+**    const GPS_KALMAN_Fix_t *fix   - good fix
+**
+** Returns:
+**    GPS_KALMAN_FILTER_SUCCESS, GPS_KALMAN_CORE_RESTART, GPS_KALMAN_CORE_SKIP,
+**    GPS_KALMAN_FILTER_ERR_NOT_PD or GPS_KALMAN_FILTER_ERR_GATED
+**=====================================================================================*/
+int GPS_KALMAN_Core_Step(GPS_KALMAN_Core_t *core, const GPS_KALMAN_Fix_t *fix)
+{
+    int status = GPS_KALMAN_Core_Prepare(core, fix);
+
+    if (status == GPS_KALMAN_FILTER_SUCCESS)
+    {
+        GPS_KALMAN_Core_Predict(core);
+        status = GPS_KALMAN_Core_Update(core);
+    }
+
+    return status;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Core_Estimate
+**
+** Purpose: To express the state as latitude, longitude, speed and heading
+**
+** Arguments:
+**    const GPS_KALMAN_Core_t *core  - core
+**    double *lat                    - latitude, degrees (output)
+**    double *lon                    - longitude, degrees (output)
+**    double *vel                    - ground speed, kph (output)
+**    double *hdg                    - heading, degrees true in [0, 360) (output)
+**
+** Returns:
+**    None
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. The heading is the heading filter's, so it holds steady when stopped. Before
+**       the first fix fast enough to start it, it is the direction of the velocity.
+**=====================================================================================*/
+void GPS_KALMAN_Core_Estimate(const GPS_KALMAN_Core_t *core, double *lat, double *lon,
+                              double *vel, double *hdg)
+{
+    const GPS_KALMAN_Data_t *data = &core->data;
+
+    enu2geodetic_fast(&core->anchor,
+            GPS_KALMAN_R2D(data->XHatData[GPS_KALMAN_STATE_E]),
+            GPS_KALMAN_R2D(data->XHatData[GPS_KALMAN_STATE_N]), lat, lon);
+    north_east2speed_heading(GPS_KALMAN_R2D(data->XHatData[GPS_KALMAN_STATE_VN]),
+            GPS_KALMAN_R2D(data->XHatData[GPS_KALMAN_STATE_VE]), vel, hdg);
+    if (core->hdgState != GPS_KALMAN_HDG_NONE)
+    {
+        *hdg = core->hdg[GPS_KALMAN_HDG];
+    }
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Core_Heading
+**
+** Purpose: To get the heading filter's heading and yaw rate
+**
+** Arguments:
+**    const GPS_KALMAN_Core_t *core  - core
+**    double *hdg                    - heading, degrees true in [0, 360) (output)
+**    double *rate                   - yaw rate, deg/s, + clockwise (output)
+**
+** Returns:
+**    1 if hdg and rate were set, 0 if the heading filter has not started
+**=====================================================================================*/
+int GPS_KALMAN_Core_Heading(const GPS_KALMAN_Core_t *core, double *hdg, double *rate)
+{
+    if (core->hdgState == GPS_KALMAN_HDG_NONE)
+    {
+        return 0;
+    }
+
+    *hdg  = core->hdg[GPS_KALMAN_HDG];
+    *rate = core->hdg[GPS_KALMAN_HDG_RATE];
+    return 1;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Core_Coast
+**
+** Purpose: To extrapolate the position and its error to a later time without a fix
+**
+** Arguments:
+**    const GPS_KALMAN_Core_t *core  - core
+**    double time                    - time to extrapolate to, s, same epoch as fixes
+**    double *lat                    - latitude, degrees (output)
+**    double *lon                    - longitude, degrees (output)
+**    double *sigmaN                 - 1-sigma position error north, m (output)
+**    double *sigmaE                 - 1-sigma position error east, m (output)
+**
+** Returns:
+**    GPS_KALMAN_QUALITY_NONE before the first fix, with the outputs left alone;
+**    _FIX at or before the last fix, which gives the estimate at it; _COAST up to
+**    params.coastMaxSec after it; _STALE beyond, held at params.coastMaxSec
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. The state is not changed: the next fix still predicts from the time of the
+**       last one, so a fix that is older than the coast time is not lost
+**    2. Holding a stale estimate bounds the error growth, and the number of output
+**       messages a consumer must tell apart, at params.coastMaxSec
+**
+** Algorithm:
+**    F is block diagonal, position and velocity of each axis apart from the other,
+**    so each axis's position variance has a closed form for any dt:
+**        Ppp + 2 dt Ppv + dt^2 Pvv + q dt^3 / 3
+**    which costs a few multiplies rather than the full F * P * F' + Q.
+**=====================================================================================*/
+int GPS_KALMAN_Core_Coast(const GPS_KALMAN_Core_t *core, double time,
+                          double *lat, double *lon, double *sigmaN, double *sigmaE)
+{
+    const GPS_KALMAN_Real_t *P = core->data.PMatrixData;
+    const GPS_KALMAN_Real_t *x = core->data.XHatData;
+    double q3 = core->params.accelPsd / 3.0;
+    double dt = time - core->lastFixTime;
+    double var[2];
+    int    quality = GPS_KALMAN_QUALITY_COAST;
+    int    i;
+    static const int axis[2][2] = {
+        { GPS_KALMAN_STATE_N, GPS_KALMAN_STATE_VN },
+        { GPS_KALMAN_STATE_E, GPS_KALMAN_STATE_VE }
+    };
+
+    if (!core->init)
+    {
+        return GPS_KALMAN_QUALITY_NONE;
+    }
+    if (dt <= 0.0)
+    {
+        dt = 0.0;
+        quality = GPS_KALMAN_QUALITY_FIX;
+    }
+    else if (dt > core->params.coastMaxSec)
+    {
+        dt = core->params.coastMaxSec;
+        quality = GPS_KALMAN_QUALITY_STALE;
+    }
+
+    enu2geodetic_fast(&core->anchor,
+            GPS_KALMAN_R2D(x[GPS_KALMAN_STATE_E]) +
+            GPS_KALMAN_R2D(x[GPS_KALMAN_STATE_VE]) * dt,
+            GPS_KALMAN_R2D(x[GPS_KALMAN_STATE_N]) +
+            GPS_KALMAN_R2D(x[GPS_KALMAN_STATE_VN]) * dt,
+            lat, lon);
+
+    for (i = 0; i < 2; i++)
+    {
+        int pos = axis[i][0];
+        int vel = axis[i][1];
+
+        var[i] = GPS_KALMAN_R2D(P[GPS_KALMAN_SYM_IDX(pos, pos)]) +
+            dt * (2.0 * GPS_KALMAN_R2D(P[GPS_KALMAN_SYM_IDX(pos, vel)]) +
+            dt * (GPS_KALMAN_R2D(P[GPS_KALMAN_SYM_IDX(vel, vel)]) + dt * q3));
+    }
+    *sigmaN = sqrt(var[0]);
+    *sigmaE = sqrt(var[1]);
+
+    return quality;
+}
+
+/*=======================================================================================
+** End of file gps_kalman_core.c
+**=====================================================================================*/
@@ -0,0 +1,247 @@
+/*=======================================================================================
+** File Name:  gps_kalman_core.h
+**
+** Title:  Header File for the GPS_KALMAN filter core
+**
+** $Author:    GPS_KALMAN Team
+** $Revision: 1.1 $
+** $Date:      2026-10-17
+**
+** Purpose:  To define the GPS_KALMAN filter as a library with no cFE, OSAL or
+**           gps_reader dependency: a fix in decimal degrees goes in, the filtered
+**           latitude, longitude, speed and heading come out. GPS_KALMAN_RunFilter is a
+**           thin cFE wrapper around it; the host benchmark and replay tools link it
+**           directly.
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**   2026-10-17 | GPS_KALMAN Team | Build #: Code Started
+**   2026-10-17 | GPS_KALMAN Team | Tuning parameters set at run time
+**   2026-10-17 | GPS_KALMAN Team | State checkpoint for warm restarts
+**   2026-10-17 | GPS_KALMAN Team | Innovation gate
+**   2026-10-17 | GPS_KALMAN Team | Fixes from several receivers
+**   2026-10-17 | GPS_KALMAN Team | Heading and yaw rate filter
+**   2026-10-17 | GPS_KALMAN Team | Steady-state gain
+**   2026-10-17 | GPS_KALMAN Team | Steady-state gains cached by DOP
+**   2026-10-17 | GPS_KALMAN Team | Coast quality and covariance, bounded coast time
+**
+**=====================================================================================*/
+
+#ifndef _GPS_KALMAN_CORE_H_
+#define _GPS_KALMAN_CORE_H_
+
+#include "gps_kalman_platform_cfg.h"
+#include "gps_kalman_data.h"
+#include "gps_kalman_filter.h"
+#include "gps_kalman_utils.h"
+
+/* GPS_KALMAN_Core_Prepare results besides GPS_KALMAN_FILTER_SUCCESS */
+#define GPS_KALMAN_CORE_RESTART  (1) /* the state was set from the fix; no predict/update */
+#define GPS_KALMAN_CORE_SKIP     (2) /* repeated or out of order time stamp, or unknown
+                                     ** receiver; fix ignored */
+
+/* GPS_KALMAN_Core_Restore result for a checkpoint that fails its sanity checks */
+#define GPS_KALMAN_CORE_ERR_CHECKPOINT  (-2)
+
+/* GPS_KALMAN_Checkpoint_t.magic of a checkpoint holding a state. Change it whenever
+** the layout or the meaning of the state changes. */
+#define GPS_KALMAN_CHECKPOINT_MAGIC  (0x474B4602u)
+
+/* Heading filter: heading (degrees true, [0, 360)) and yaw rate (deg/s, + clockwise
+** seen from above), with its covariance packed as P00, P01, P11 */
+#define GPS_KALMAN_HDG_LEN       (2)
+#define GPS_KALMAN_HDG_SYM_LEN   (3)
+#define GPS_KALMAN_HDG           (0)
+#define GPS_KALMAN_HDG_RATE      (1)
+
+/* GPS_KALMAN_Core_t.hdgState */
+#define GPS_KALMAN_HDG_NONE      (0) /* no heading yet */
+#define GPS_KALMAN_HDG_TRACKING  (1) /* filtered from the fixes */
+#define GPS_KALMAN_HDG_HELD      (2) /* kept over a restart until a fix restarts it */
+
+/* Quality of an estimate from GPS_KALMAN_Core_Coast. Only _FIX and _COAST are valid. */
+#define GPS_KALMAN_QUALITY_NONE  (0) /* no estimate: no fix yet */
+#define GPS_KALMAN_QUALITY_FIX   (1) /* the estimate at the last fix */
+#define GPS_KALMAN_QUALITY_COAST (2) /* extrapolated from it, within params.coastMaxSec */
+#define GPS_KALMAN_QUALITY_STALE (3) /* no fix for longer than that; held there */
+
+/* One good fix */
+typedef struct
+{
+    double time; /* time stamp, seconds from any fixed epoch */
+    double lat;  /* latitude, decimal degrees, + north */
+    double lon;  /* longitude, decimal degrees, + east */
+    double vel;  /* ground speed, kph */
+    double hdg;  /* heading, degrees true */
+    double dop;  /* horizontal dilution of precision */
+    uint32_t source; /* receiver, index of params.source; 0 with one receiver */
+} GPS_KALMAN_Fix_t;
+
+/* Noise model and latency of one receiver */
+typedef struct
+{
+    double   uereM;           /* 1-sigma range error, position sigma = HDOP * uereM */
+    double   velSigmaMps;     /* 1-sigma velocity measurement noise, m/s */
+    double   latencySec;      /* age of a fix at its time stamp, s; taken off the stamp */
+} GPS_KALMAN_SourceParams_t;
+
+/* Filter tuning. The defaults are the GPS_KALMAN_* values of gps_kalman_platform_cfg.h;
+** in flight the app loads them from its parameter table. */
+typedef struct
+{
+    GPS_KALMAN_SourceParams_t source[GPS_KALMAN_SOURCE_MAX]; /* per receiver */
+    double   accelPsd;        /* white acceleration noise density, m^2/s^3 */
+    double   initVarScale;    /* initial state variance / first fix's measurement variance */
+    double   dtQuantumSec;    /* dt between fixes is rounded to this, s */
+    double   maxDtSec;        /* a longer gap restarts the filter, s */
+    double   enuMaxRangeM;    /* the local frame moves to a fix further than this, m */
+    double   gateChi2;        /* innovation gate on d2 = y' * S^-1 * y, 0 = none */
+    uint32_t gateMaxRejects;  /* this many gated fixes in a row restart the filter */
+    uint32_t spare;
+    double   hdgMinSpeedKph;  /* slower fixes do not update the heading, kph */
+    double   yawAccelPsd;     /* white yaw acceleration noise density, deg^2/s^3 */
+    double   yawRateSigma0;   /* 1-sigma yaw rate when the heading starts, deg/s */
+    double   steadyGainTol;   /* the gain is frozen once no element of it moves by more
+                              ** than this for steadySettleFixes updates; 0 = never */
+    uint32_t steadySettleFixes;
+    uint32_t spare2;
+    double   coastMaxSec;     /* an estimate coasted further than this is stale, s */
+    double   resumeMaxSec;    /* a restored checkpoint is kept for a first fix up to
+                              ** this much later, s; at least maxDtSec */
+} GPS_KALMAN_Params_t;
+
+/* What a filter needs to carry on where it left off: the state, its covariance, the
+** time it is at and the local frame it is in. Always double, so a checkpoint does not
+** depend on GPS_KALMAN_PRECISION. */
+typedef struct
+{
+    uint32_t magic;       /* GPS_KALMAN_CHECKPOINT_MAGIC, or 0 when there is no state */
+    uint32_t hdgState;    /* GPS_KALMAN_HDG_*, of hdg and hdgP */
+    double   lastFixTime; /* time stamp of the fix the state is at, s */
+    double   anchorLat;   /* origin of the local frame, degrees */
+    double   anchorLon;
+    double   x[GPS_KALMAN_FILTER_LEN];     /* state */
+    double   P[GPS_KALMAN_FILTER_SYM_LEN]; /* covariance, packed */
+    double   hdg[GPS_KALMAN_HDG_LEN];      /* heading state */
+    double   hdgP[GPS_KALMAN_HDG_SYM_LEN]; /* its covariance, packed */
+} GPS_KALMAN_Checkpoint_t;
+
+#if GPS_KALMAN_GAIN_CACHE_LEN < 1
+#error "GPS_KALMAN_GAIN_CACHE_LEN must be at least 1"
+#endif
+
+/* A steady-state gain and what goes with it, for one dt and measurement noise */
+typedef struct
+{
+    double   dt;                                         /* time step, s */
+    GPS_KALMAN_Real_t R[GPS_KALMAN_FILTER_LEN];          /* measurement variances */
+    GPS_KALMAN_Real_t K[GPS_KALMAN_FILTER_MAT_LEN];      /* gain */
+    GPS_KALMAN_Real_t S[GPS_KALMAN_FILTER_SYM_LEN];      /* innovation covariance */
+    GPS_KALMAN_Real_t Sinv[GPS_KALMAN_FILTER_SYM_LEN];   /* innovation covariance^-1 */
+    GPS_KALMAN_Real_t PPrior[GPS_KALMAN_FILTER_SYM_LEN]; /* P before and after an update */
+    GPS_KALMAN_Real_t PPost[GPS_KALMAN_FILTER_SYM_LEN];
+    uint32_t lastUse;                                    /* gainClock when last used */
+} GPS_KALMAN_Gain_t;
+
+/* One filter instance. Cores share nothing, so separate cores may run on separate
+** threads; with GPS_KALMAN_USE_GSL a core must not be moved after GPS_KALMAN_Core_Init. */
+typedef struct
+{
+    GPS_KALMAN_Data_t data;       /* state, covariance and working matrices */
+    int     init;         /* the state holds a fix */
+    double  lastFixTime;  /* time stamp of the fix the state is at, s */
+    double  modelDt;      /* dt the cached F and Q were built for, < 0 if none */
+    double  dt;           /* time step of the fix being processed, s */
+    GPS_KALMAN_EnuAnchor_t anchor; /* origin of the local east/north frame */
+    GPS_KALMAN_Params_t    params; /* tuning in use */
+    double  dtQuantumInv; /* 1 / params.dtQuantumSec */
+    double  velVar[GPS_KALMAN_SOURCE_MAX]; /* params.source[].velSigmaMps squared */
+    uint32_t lastSource;  /* receiver of the fix the state is at */
+    double  d2;           /* squared Mahalanobis distance of the last update's innovation */
+    unsigned int rejects; /* updates rejected by the gate in a row */
+    int     resumed;      /* the state is a restored checkpoint no fix has used yet */
+
+    /* Heading and yaw rate, filtered apart from the position and velocity. Always
+    ** double: it is two states, updated at most once per fix. */
+    int     hdgState;     /* GPS_KALMAN_HDG_* */
+    int     hdgUse;       /* the prepared fix is fast enough to update it */
+    double  hdgMeas;      /* heading of the prepared fix, degrees true */
+    double  hdgVar;       /* and its variance, deg^2 */
+    double  hdg[GPS_KALMAN_HDG_LEN];
+    double  hdgP[GPS_KALMAN_HDG_SYM_LEN];
+
+    /* Steady-state gains. Once the gain has settled at a fixed dt and noise model it is
+    ** frozen, and fixes at the same dt take state-only steps. Gains are cached by
+    ** measurement noise, that is by DOP, so a DOP change need not end them. Off a
+    ** frozen gain, after a gated fix or a DOP not in the cache, every fix also looks
+    ** up the cache, and a cached gain for its dt and noise is taken back as soon as P
+    ** is within params.steadyGainTol of that gain's steady state. */
+    int     steady;       /* gainCache[gainIdx] is in use */
+    int     steadyStep;   /* the prepared fix takes a state-only step */
+    unsigned int settled; /* full updates in a row whose gain moved within tolerance */
+    unsigned int gainIdx;
+    unsigned int gainCount; /* gainCache entries filled */
+    uint32_t gainClock;   /* counts cache uses, for least recently used replacement */
+    uint32_t gainHits;    /* DOP changes while steady whose gain was in the cache, and
+                          ** returns to a cached gain */
+    uint32_t gainMisses;  /* DOP changes while steady whose gain was not, so the full
+                          ** filter ran */
+    GPS_KALMAN_Gain_t settle; /* dt, R and K of the last full update */
+    GPS_KALMAN_Gain_t gainCache[GPS_KALMAN_GAIN_CACHE_LEN];
+} GPS_KALMAN_Core_t;
+
+/* Reset the core and the filter arrays, with the default parameters; the next fix
+** starts the filter */
+void GPS_KALMAN_Core_Init(GPS_KALMAN_Core_t *core);
+
+/* The parameters of gps_kalman_platform_cfg.h */
+void GPS_KALMAN_Core_DefaultParams(GPS_KALMAN_Params_t *params);
+
+/* NULL if every parameter is in range, else the name of the first one that is not */
+const char *GPS_KALMAN_Core_CheckParams(const GPS_KALMAN_Params_t *params);
+
+/* Use checked parameters from the next fix on. The state is kept. */
+void GPS_KALMAN_Core_SetParams(GPS_KALMAN_Core_t *core, const GPS_KALMAN_Params_t *params);
+
+/* Copy the state into a checkpoint; magic is 0 before the first fix */
+void GPS_KALMAN_Core_Save(const GPS_KALMAN_Core_t *core, GPS_KALMAN_Checkpoint_t *ckpt);
+
+/* Resume from a checkpoint. Returns GPS_KALMAN_FILTER_SUCCESS, GPS_KALMAN_CORE_SKIP if
+** it holds no state, or GPS_KALMAN_CORE_ERR_CHECKPOINT; the core is unchanged unless
+** it succeeds. The parameters are kept. */
+int  GPS_KALMAN_Core_Restore(GPS_KALMAN_Core_t *core, const GPS_KALMAN_Checkpoint_t *ckpt);
+
+/* Load a fix as the measurement and set up the step to it. Returns
+** GPS_KALMAN_FILTER_SUCCESS when Predict and Update should follow. */
+int  GPS_KALMAN_Core_Prepare(GPS_KALMAN_Core_t *core, const GPS_KALMAN_Fix_t *fix);
+
+/* Propagate the state to the prepared fix */
+void GPS_KALMAN_Core_Predict(GPS_KALMAN_Core_t *core);
+
+/* Update with the prepared fix: GPS_KALMAN_FILTER_SUCCESS, _ERR_NOT_PD or _ERR_GATED */
+int  GPS_KALMAN_Core_Update(GPS_KALMAN_Core_t *core);
+
+/* Prepare, Predict and Update in one call; returns the first non-success result */
+int  GPS_KALMAN_Core_Step(GPS_KALMAN_Core_t *core, const GPS_KALMAN_Fix_t *fix);
+
+/* The state as latitude/longitude (degrees), speed (kph) and heading (degrees true).
+** The heading is the heading filter's once it has one, else the velocity's. */
+void GPS_KALMAN_Core_Estimate(const GPS_KALMAN_Core_t *core, double *lat, double *lon,
+                              double *vel, double *hdg);
+
+/* The heading filter's heading (degrees true) and yaw rate (deg/s). Returns 0 and
+** leaves both alone until a fix at params.hdgMinSpeedKph or over has started it. */
+int  GPS_KALMAN_Core_Heading(const GPS_KALMAN_Core_t *core, double *hdg, double *rate);
+
+/* Position (degrees) and its 1-sigma error north and east (m), extrapolated to a
+** later time without changing the state, at most params.coastMaxSec. Returns the
+** GPS_KALMAN_QUALITY_* of the result; with _NONE the outputs are left alone. */
+int  GPS_KALMAN_Core_Coast(const GPS_KALMAN_Core_t *core, double time,
+                           double *lat, double *lon, double *sigmaN, double *sigmaE);
+
+#endif /* _GPS_KALMAN_CORE_H_ */
+
+/*=======================================================================================
+** End of file gps_kalman_core.h
+**=====================================================================================*/
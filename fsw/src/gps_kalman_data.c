@@ -13,89 +13,20 @@
 **   Date | Author | Description
 **   ---------------------------
 **   2019-09-12 | Jacob Killelea | Build #: Code Started
+**   2026-10-17 | GPS_KALMAN Team | Matrices per filter instance instead of global
 **
 **=====================================================================================*/
 
-#include "cfe.h"
 #include "gps_kalman_data.h"
 
-/* Vector data */
-/* State vector */
-static double XHatData[GPS_KALMAN_FILTER_LEN] = {0.0};
-/* Next state vector */
-static double XHatNextData[GPS_KALMAN_FILTER_LEN] = {0.0};
-/* Expected measurement */
-static double MuExpectedData[GPS_KALMAN_FILTER_LEN] = {0.0};
-/* Actual measurement */
-static double MuActualData[GPS_KALMAN_FILTER_LEN] = {0.0};
-
-/* Matrix data */
-/* State prediction matrix */
-static double FMatrixData[GPS_KALMAN_FILTER_LEN * GPS_KALMAN_FILTER_LEN];
-/* State covariance matrix */
-static double PMatrixData[GPS_KALMAN_FILTER_LEN * GPS_KALMAN_FILTER_LEN] = {0.0};
-/* State covariance increment matrix */
-static double QMatrixData[GPS_KALMAN_FILTER_LEN * GPS_KALMAN_FILTER_LEN] = {0.0};
-/* Measurement matrix */
-static double HMatrixData[GPS_KALMAN_FILTER_LEN * GPS_KALMAN_FILTER_LEN] = {0.0};
-/* Expected measuremnet covariance matrix */
-static double SigmaExpectMatrixData[GPS_KALMAN_FILTER_LEN * GPS_KALMAN_FILTER_LEN] = {0.0};
-/* Actual measuremnet covariance matrix */
-static double SigmaActualMatrixData[GPS_KALMAN_FILTER_LEN * GPS_KALMAN_FILTER_LEN] = {0.0};
-/* Kalman gain matrix */
-static double KMatrixData[GPS_KALMAN_FILTER_LEN * GPS_KALMAN_FILTER_LEN] = {0.0};
-/* Temporary matrix */
-static double TmpMatrixData[GPS_KALMAN_FILTER_LEN * GPS_KALMAN_FILTER_LEN] = {0.0};
-/* Temporary matrix */
-static double TmpMatrix2Data[GPS_KALMAN_FILTER_LEN * GPS_KALMAN_FILTER_LEN] = {0.0};
-/* Permutation matrix */
-static size_t PermutationBackingData[GPS_KALMAN_FILTER_LEN * GPS_KALMAN_FILTER_LEN] = {0.0};
-gsl_permutation GSLPermutationData = {
-    .size = GPS_KALMAN_FILTER_LEN,
-    .data = PermutationBackingData
-};
-
-
-/* Use views to translate between arrays and vector/matrix objects */
-static gsl_vector_view XHatView;
-static gsl_vector_view XHatNextView;
-static gsl_vector_view MuExpectedView;
-static gsl_vector_view MuActualView;
-
-static gsl_matrix_view FMatrixView;
-static gsl_matrix_view HMatrixView;
-static gsl_matrix_view KMatrixView;
-static gsl_matrix_view PMatrixView;
-static gsl_matrix_view QMatrixView;
-static gsl_matrix_view SigmaActualMatrixView;
-static gsl_matrix_view SigmaExpectMatrixView;
-static gsl_matrix_view TmpMatrix2View;
-static gsl_matrix_view TmpMatrixView;
-
-gsl_vector *XHat = NULL; /* kalman state vector */
-gsl_vector *XHatNext = NULL; /* kalman state vector */
-gsl_vector *MuExpected = NULL; /* expected measurement */
-gsl_vector *MuActual = NULL; /* actual measurement */
-
-gsl_matrix *FMatrix = NULL; /* kalman system matrix */
-gsl_matrix *HMatrix = NULL; /* kalman measurement matrix (identity for now) */
-gsl_matrix *KMatrix = NULL; /* kalman gain */
-gsl_matrix *PMatrix = NULL; /* kalman state covariance matrix */
-gsl_matrix *QMatrix = NULL; /* kalman state covariance uncertainty matrix (0.1*identity for now) */
-gsl_matrix *SigmaActualMatrix = NULL; /* actual covariance */
-gsl_matrix *SigmaExpectMatrix = NULL; /* expected covariance */
-gsl_matrix *TmpMatrix2 = NULL; /* Temporary matrix */
-gsl_matrix *TmpMatrix = NULL; /* Temporary matrix */
-gsl_permutation *GSLPermutation = NULL; /* used for inverting matrices */
-
 /*=====================================================================================
 ** Name: GPS_KALMAN_Init_Matrix_Data
 **
-** Purpose: To initialize pointers to each matrix and vector from statically 
-**          allocated arrays, as well as the gsl_permutation data
+** Purpose: To initialize pointers to each matrix and vector from the arrays of
+**          one filter instance, as well as the gsl_permutation data
 **
 ** Arguments:
-**    None
+**    GPS_KALMAN_Data_t *data  - matrices of the filter instance
 **
 ** Returns:
 **    None
@@ -105,16 +36,19 @@ gsl_permutation *GSLPermutation = NULL; /* used for inverting matrices */
 **    gsl_vector_view_array
 **
 ** Called By:
-**    GPS_KALMAN_InitData
+**    GPS_KALMAN_Core_Init
 **
 ** Global Inputs/Reads:
 **    None
 **
 ** Global Outputs/Writes:
-**    all gsl_matrix, gsl_vector, and gsl_permutation pointers
+**    None
 **
 ** Limitations, Assumptions, External Events, and Notes:
 **    1. GSL will not fail silently but will throw some kind of exception
+**    2. Only does anything when built with GPS_KALMAN_USE_GSL; the fixed-size
+**       kernel uses the backing arrays directly
+**    3. The views point into data itself, so data must stay where it is afterwards
 **
 ** Algorithm:
 **    For the matrices and vectors: Create a view object from each array, assign the 
@@ -128,56 +62,64 @@ gsl_permutation *GSLPermutation = NULL; /* used for inverting matrices */
 ** History:  Date Written  2019-09-12
 **           Unit Tested   yyyy-mm-dd
 **=====================================================================================*/
-void GPS_KALMAN_Init_Matrix_Data() {
-    XHatView = gsl_vector_view_array(XHatData, GPS_KALMAN_FILTER_LEN);
-    XHat = &XHatView.vector;
+void GPS_KALMAN_Init_Matrix_Data(GPS_KALMAN_Data_t *data) {
+#ifdef GPS_KALMAN_USE_GSL
+    GPS_KALMAN_GslData_t *gsl = &data->gsl;
 
-    XHatNextView = gsl_vector_view_array(XHatNextData, GPS_KALMAN_FILTER_LEN);
-    XHatNext = &XHatNextView.vector;
+    gsl->XHatView = gsl_vector_view_array(data->XHatData, GPS_KALMAN_FILTER_LEN);
+    gsl->XHat = &gsl->XHatView.vector;
 
-    MuExpectedView = gsl_vector_view_array(MuExpectedData, GPS_KALMAN_FILTER_LEN);
-    MuExpected = &MuExpectedView.vector;
+    gsl->XHatNextView = gsl_vector_view_array(data->XHatNextData, GPS_KALMAN_FILTER_LEN);
+    gsl->XHatNext = &gsl->XHatNextView.vector;
 
-    MuActualView = gsl_vector_view_array(MuActualData, GPS_KALMAN_FILTER_LEN);
-    MuActual = &MuActualView.vector;
+    gsl->MuExpectedView = gsl_vector_view_array(data->MuExpectedData, GPS_KALMAN_FILTER_LEN);
+    gsl->MuExpected = &gsl->MuExpectedView.vector;
 
-    FMatrixView = gsl_matrix_view_array(FMatrixData,
-            GPS_KALMAN_FILTER_LEN, GPS_KALMAN_FILTER_LEN);
-    FMatrix = &FMatrixView.matrix;
+    gsl->MuActualView = gsl_vector_view_array(data->MuActualData, GPS_KALMAN_FILTER_LEN);
+    gsl->MuActual = &gsl->MuActualView.vector;
 
-    HMatrixView = gsl_matrix_view_array(HMatrixData,
+    gsl->FMatrixView = gsl_matrix_view_array(data->FMatrixData,
             GPS_KALMAN_FILTER_LEN, GPS_KALMAN_FILTER_LEN);
-    HMatrix = &HMatrixView.matrix;
+    gsl->FMatrix = &gsl->FMatrixView.matrix;
 
-    KMatrixView = gsl_matrix_view_array(KMatrixData,
+    gsl->HMatrixView = gsl_matrix_view_array(data->HMatrixData,
             GPS_KALMAN_FILTER_LEN, GPS_KALMAN_FILTER_LEN);
-    KMatrix = &KMatrixView.matrix;
+    gsl->HMatrix = &gsl->HMatrixView.matrix;
 
-    PMatrixView = gsl_matrix_view_array(PMatrixData,
+    gsl->KMatrixView = gsl_matrix_view_array(data->KMatrixData,
             GPS_KALMAN_FILTER_LEN, GPS_KALMAN_FILTER_LEN);
-    PMatrix = &PMatrixView.matrix;
+    gsl->KMatrix = &gsl->KMatrixView.matrix;
 
-    QMatrixView = gsl_matrix_view_array(QMatrixData,
+    gsl->PMatrixView = gsl_matrix_view_array(gsl->PMatrixFullData,
             GPS_KALMAN_FILTER_LEN, GPS_KALMAN_FILTER_LEN);
-    QMatrix = &QMatrixView.matrix;
+    gsl->PMatrix = &gsl->PMatrixView.matrix;
 
-    SigmaActualMatrixView = gsl_matrix_view_array(SigmaActualMatrixData,
+    gsl->QMatrixView = gsl_matrix_view_array(gsl->QMatrixFullData,
             GPS_KALMAN_FILTER_LEN, GPS_KALMAN_FILTER_LEN);
-    SigmaActualMatrix = &SigmaActualMatrixView.matrix;
+    gsl->QMatrix = &gsl->QMatrixView.matrix;
 
-    SigmaExpectMatrixView = gsl_matrix_view_array(SigmaExpectMatrixData,
+    gsl->SigmaActualMatrixView = gsl_matrix_view_array(gsl->SigmaActualMatrixFullData,
             GPS_KALMAN_FILTER_LEN, GPS_KALMAN_FILTER_LEN);
-    SigmaExpectMatrix = &SigmaExpectMatrixView.matrix;
+    gsl->SigmaActualMatrix = &gsl->SigmaActualMatrixView.matrix;
 
-    TmpMatrixView = gsl_matrix_view_array(TmpMatrixData,
+    gsl->SigmaExpectMatrixView = gsl_matrix_view_array(gsl->SigmaExpectMatrixFullData,
             GPS_KALMAN_FILTER_LEN, GPS_KALMAN_FILTER_LEN);
-    TmpMatrix = &TmpMatrixView.matrix;
+    gsl->SigmaExpectMatrix = &gsl->SigmaExpectMatrixView.matrix;
 
-    TmpMatrix2View = gsl_matrix_view_array(TmpMatrix2Data,
+    gsl->TmpMatrixView = gsl_matrix_view_array(gsl->TmpMatrixData,
             GPS_KALMAN_FILTER_LEN, GPS_KALMAN_FILTER_LEN);
-    TmpMatrix2 = &TmpMatrix2View.matrix;
+    gsl->TmpMatrix = &gsl->TmpMatrixView.matrix;
 
-    GSLPermutation = &GSLPermutationData;
+    gsl->TmpMatrix2View = gsl_matrix_view_array(gsl->TmpMatrix2Data,
+            GPS_KALMAN_FILTER_LEN, GPS_KALMAN_FILTER_LEN);
+    gsl->TmpMatrix2 = &gsl->TmpMatrix2View.matrix;
+
+    gsl->GSLPermutationData.size = GPS_KALMAN_FILTER_LEN;
+    gsl->GSLPermutationData.data = gsl->PermutationBackingData;
+    gsl->GSLPermutation = &gsl->GSLPermutationData;
+#else
+    (void) data;
+#endif /* GPS_KALMAN_USE_GSL */
 }
 
 
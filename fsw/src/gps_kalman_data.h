@@ -14,37 +14,92 @@
 **   Date | Author | Description
 **   ---------------------------
 **   2019-09-12 | Jacob Killelea | Build #: Code Started
+**   2026-10-17 | GPS_KALMAN Team | Matrices per filter instance instead of global
+**   2026-10-17 | GPS_KALMAN Team | Filter arrays in GPS_KALMAN_Real_t
 **
 **=====================================================================================*/
 
 #define GPS_KALMAN_DATA_H_
 
+#include <stddef.h>
+
+#include "gps_kalman_filter.h"
+
+/* GSL views onto the arrays of one GPS_KALMAN_Data_t, for the reference GSL BLAS path */
+#ifdef GPS_KALMAN_USE_GSL
 #include <gsl/gsl_blas.h>
 #include <gsl/gsl_linalg.h>
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_vector.h>
 
+/* Vectors, F, H and K view the arrays of GPS_KALMAN_Data_t; the covariances view
+** full-storage scratch copies which the core unpacks and packs around the GSL calls. */
+typedef struct
+{
+    double PMatrixFullData[GPS_KALMAN_FILTER_MAT_LEN];
+    double QMatrixFullData[GPS_KALMAN_FILTER_MAT_LEN];
+    double SigmaExpectMatrixFullData[GPS_KALMAN_FILTER_MAT_LEN];
+    double SigmaActualMatrixFullData[GPS_KALMAN_FILTER_MAT_LEN];
+    double TmpMatrixData[GPS_KALMAN_FILTER_MAT_LEN];
+    double TmpMatrix2Data[GPS_KALMAN_FILTER_MAT_LEN];
+    size_t PermutationBackingData[GPS_KALMAN_FILTER_LEN];
+    gsl_permutation GSLPermutationData;
+
+    gsl_vector_view XHatView;
+    gsl_vector_view XHatNextView;
+    gsl_vector_view MuExpectedView;
+    gsl_vector_view MuActualView;
+    gsl_matrix_view FMatrixView;
+    gsl_matrix_view HMatrixView;
+    gsl_matrix_view KMatrixView;
+    gsl_matrix_view PMatrixView;
+    gsl_matrix_view QMatrixView;
+    gsl_matrix_view SigmaActualMatrixView;
+    gsl_matrix_view SigmaExpectMatrixView;
+    gsl_matrix_view TmpMatrix2View;
+    gsl_matrix_view TmpMatrixView;
+
+    gsl_vector *XHat;                /* kalman state vector */
+    gsl_vector *XHatNext;            /* kalman state vector */
+    gsl_vector *MuExpected;          /* expected measurement */
+    gsl_vector *MuActual;            /* actual measurement */
+    gsl_matrix *FMatrix;             /* kalman system matrix */
+    gsl_matrix *HMatrix;             /* kalman measurement matrix (identity for now) */
+    gsl_matrix *KMatrix;             /* kalman gain */
+    gsl_matrix *PMatrix;             /* kalman state covariance matrix */
+    gsl_matrix *QMatrix;             /* kalman state covariance uncertainty matrix (0.1*identity for now) */
+    gsl_matrix *SigmaActualMatrix;   /* actual covariance */
+    gsl_matrix *SigmaExpectMatrix;   /* expected covariance */
+    gsl_matrix *TmpMatrix2;          /* Temporary matrix */
+    gsl_matrix *TmpMatrix;           /* Temporary matrix */
+    gsl_permutation *GSLPermutation; /* used for inverting matrices */
+} GPS_KALMAN_GslData_t;
+#endif /* GPS_KALMAN_USE_GSL */
+
+/* The matrices of one filter instance. Full matrices are row-major, covariances are
+** packed symmetric (see GPS_KALMAN_FILTER_SYM_LEN); the fixed-size kernel uses the
+** arrays directly. */
+typedef struct
+{
+    GPS_KALMAN_Real_t XHatData[GPS_KALMAN_FILTER_LEN];                  /* kalman state vector */
+    GPS_KALMAN_Real_t XHatNextData[GPS_KALMAN_FILTER_LEN];              /* kalman state vector */
+    GPS_KALMAN_Real_t MuExpectedData[GPS_KALMAN_FILTER_LEN];            /* expected measurement */
+    GPS_KALMAN_Real_t MuActualData[GPS_KALMAN_FILTER_LEN];              /* actual measurement */
+    GPS_KALMAN_Real_t FMatrixData[GPS_KALMAN_FILTER_MAT_LEN];           /* kalman system matrix */
+    GPS_KALMAN_Real_t HMatrixData[GPS_KALMAN_FILTER_MAT_LEN];           /* kalman measurement matrix */
+    GPS_KALMAN_Real_t KMatrixData[GPS_KALMAN_FILTER_MAT_LEN];           /* kalman gain */
+    GPS_KALMAN_Real_t PMatrixData[GPS_KALMAN_FILTER_SYM_LEN];           /* kalman state covariance matrix, packed */
+    GPS_KALMAN_Real_t QMatrixData[GPS_KALMAN_FILTER_SYM_LEN];           /* kalman state covariance uncertainty matrix, packed */
+    GPS_KALMAN_Real_t SigmaActualData[GPS_KALMAN_FILTER_LEN];           /* actual covariance (diagonal) */
+    GPS_KALMAN_Real_t SigmaExpectMatrixData[GPS_KALMAN_FILTER_SYM_LEN]; /* innovation covariance of the last update, packed */
+#ifdef GPS_KALMAN_USE_GSL
+    GPS_KALMAN_GslData_t gsl;
+#endif
+} GPS_KALMAN_Data_t;
 
-/* Size of the vectors (1x3 and matrices (3x3) in the filter */
-#define GPS_KALMAN_FILTER_LEN (3)
-
-extern gsl_vector *XHat;                /* kalman state vector */
-extern gsl_vector *XHatNext;            /* kalman state vector */
-extern gsl_vector *MuExpected;          /* expected measurement */
-extern gsl_vector *MuActual;            /* actual measurement */
-extern gsl_matrix *FMatrix;             /* kalman system matrix */
-extern gsl_matrix *HMatrix;             /* kalman measurement matrix (identity for now) */
-extern gsl_matrix *KMatrix;             /* kalman gain */
-extern gsl_matrix *PMatrix;             /* kalman state covariance matrix */
-extern gsl_matrix *QMatrix;             /* kalman state covariance uncertainty matrix (0.1*identity for now) */
-extern gsl_matrix *SigmaActualMatrix;   /* actual covariance */
-extern gsl_matrix *SigmaExpectMatrix;   /* expected covariance */
-extern gsl_matrix *TmpMatrix2;          /* Temporary matrix */
-extern gsl_matrix *TmpMatrix;           /* Temporary matrix */
-extern gsl_permutation *GSLPermutation; /* used for inverting matrices */
-
-/* Initialize all the pointer above from static memory (no deallocation needed) */
-void GPS_KALMAN_Init_Matrix_Data(void);
+/* Point the GSL views of data at its own arrays. With GPS_KALMAN_USE_GSL the views
+** are self-referencing, so data must not be copied or moved afterwards. */
+void GPS_KALMAN_Init_Matrix_Data(GPS_KALMAN_Data_t *data);
 
 #endif /* end of include guard: GPS_KALMAN_DATA_H_ */
 
@@ -0,0 +1,101 @@
+/*=======================================================================================
+** File Name:  gps_kalman_decode.c
+**
+** Title:  Receiver data decoding for GPS_KALMAN Application
+**
+** $Author:    GPS_KALMAN Team
+** $Revision: 1.1 $
+** $Date:      2026-10-17
+**
+** Purpose:  This file converts libnmea receiver state to filter fixes
+**
+** Functions Defined:
+**    Function GPS_KALMAN_DecodeInfo: receiver state to a fix, and whether it is good
+**    Function GPS_KALMAN_DecodeUtc: receiver UTC time to seconds
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. No cFE or OSAL dependency; only the libnmea types are needed
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**   2026-10-17 | GPS_KALMAN Team | Build #: Code Started, from GPS_KALMAN_ProcessNewData
+**   2026-10-17 | GPS_KALMAN Team | A position that does not convert is not good
+**
+**=====================================================================================*/
+
+#include <math.h>
+
+#include "gps_kalman_decode.h"
+#include "gps_kalman_utils.h"
+
+/*=====================================================================================
+** Name: GPS_KALMAN_DecodeInfo
+**
+** Purpose: To convert receiver state to a fix and judge whether it is good
+**
+** Arguments:
+**    const nmeaINFO *info     - receiver state, as parsed by libnmea
+**    GPS_KALMAN_Fix_t *fix    - fix; the time stamp and source are left alone
+**
+** Returns:
+**    int - 1 for a good fix, 0 otherwise
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. A fix is good with a 2D or 3D solution, a valid quality indicator, a
+**       determined HDOP, and a latitude and longitude that convert (not NaN)
+**=====================================================================================*/
+int GPS_KALMAN_DecodeInfo(const nmeaINFO *info, GPS_KALMAN_Fix_t *fix)
+{
+    /* Lat and Lon are +/- in decimal format */
+    fix->lat = decimal_minutes2decimal_decimal(info->lat);
+    fix->lon = decimal_minutes2decimal_decimal(info->lon);
+    /* kph */
+    fix->vel = info->speed;
+    /* degrees true */
+    fix->hdg = info->direction;
+    fix->dop = info->HDOP; /* Horizontal Dilution Of Precision */
+
+    /* fix = Operating mode, used for navigation (1 = Fix not available; 2 = 2D; 3 = 3D) */
+    return (info->fix >= 2)
+    /* sig = GPS quality indicator (0 = Invalid; 1 = Fix; 2 = Differential, 3 = Sensitive) */
+        && (info->sig >= 1)
+    /* 99.99 is used for undetermined/null */
+        && (info->HDOP < GPS_KALMAN_DOP_NULL)
+    /* decimal minutes too large to be a coordinate */
+        && !isnan(fix->lat) && !isnan(fix->lon);
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_DecodeUtc
+**
+** Purpose: To convert the receiver UTC time to seconds since 1970-01-01
+**
+** Arguments:
+**    const nmeaINFO *info  - receiver state, as parsed by libnmea
+**
+** Returns:
+**    double - seconds, to the hundredth
+**
+** Algorithm:
+**    Days from the civil date by the era method, which needs no time zone or libc
+**    calendar support. libnmea counts years from 1900 and months from 0.
+**=====================================================================================*/
+double GPS_KALMAN_DecodeUtc(const nmeaINFO *info)
+{
+    long y = (long) info->utc.year + 1900 - ((info->utc.mon < 2) ? 1 : 0);
+    long m = (long) info->utc.mon + 1;
+    long era = ((y >= 0) ? y : y - 399) / 400;
+    long yoe = y - era * 400;
+    long doy = (153 * ((m > 2) ? m - 3 : m + 9) + 2) / 5 + info->utc.day - 1;
+    long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    long days = era * 146097 + doe - 719468;
+
+    return (double) days * 86400.0 +
+           (double) (info->utc.hour * 3600 + info->utc.min * 60 + info->utc.sec) +
+           (double) info->utc.hsec * 0.01;
+}
+
+/*=======================================================================================
+** End of file gps_kalman_decode.c
+**=====================================================================================*/
@@ -0,0 +1,42 @@
+/*=======================================================================================
+** File Name:  gps_kalman_decode.h
+**
+** Title:  Header File for GPS_KALMAN receiver data decoding
+**
+** $Author:    GPS_KALMAN Team
+** $Revision: 1.1 $
+** $Date:      2026-10-17
+**
+** Purpose:  To turn the libnmea receiver state carried in a GpsInfoMsg_t into a filter
+**           fix. The app and the host replay tool both decode through here, so a
+**           replayed log is judged and converted exactly as live traffic is.
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**   2026-10-17 | GPS_KALMAN Team | Build #: Code Started, from GPS_KALMAN_ProcessNewData
+**
+**=====================================================================================*/
+
+#ifndef _GPS_KALMAN_DECODE_H_
+#define _GPS_KALMAN_DECODE_H_
+
+#include "nmea/info.h"
+
+#include "gps_kalman_core.h"
+
+/* HDOP libnmea reports when it is undetermined */
+#define GPS_KALMAN_DOP_NULL  (99.99)
+
+/* Fill fix from info, all but the time stamp and source. Returns 1 if the fix is good enough to
+** filter, else 0; fix is filled either way. */
+int    GPS_KALMAN_DecodeInfo(const nmeaINFO *info, GPS_KALMAN_Fix_t *fix);
+
+/* The UTC time of info as seconds since 1970-01-01 */
+double GPS_KALMAN_DecodeUtc(const nmeaINFO *info);
+
+#endif /* _GPS_KALMAN_DECODE_H_ */
+
+/*=======================================================================================
+** End of file gps_kalman_decode.h
+**=====================================================================================*/
@@ -0,0 +1,491 @@
+/*=======================================================================================
+** File Name:  gps_kalman_filter.c
+**
+** Title:  Fixed-size Kalman filter kernel for GPS_KALMAN Application
+**
+** $Author:    GPS_KALMAN Team
+** $Revision: 1.1 $
+** $Date:      2026-10-17
+**
+** Purpose:  This file contains the fixed-size predict/update kernel that replaces the
+**           generic GSL BLAS calls in GPS_KALMAN_RunFilter, and the constant velocity
+**           motion model it runs
+**
+** Functions Defined:
+**    Function GPS_KALMAN_Filter_Identity: fill a matrix with a scaled identity
+**    Function GPS_KALMAN_Filter_SymIdentity: fill a packed matrix with a scaled identity
+**    Function GPS_KALMAN_Filter_SymUnpack: packed symmetric to full storage
+**    Function GPS_KALMAN_Filter_SymPack: full to packed symmetric storage
+**    Function GPS_KALMAN_Filter_CVModel: build F and Q for a time step
+**    Function GPS_KALMAN_Filter_Predict: propagate the state and covariance
+**    Function GPS_KALMAN_Filter_Update: apply a measurement update
+**    Function GPS_KALMAN_Filter_SymInverse: invert a packed covariance
+**    Function GPS_KALMAN_Filter_SteadyPredict: propagate the state only
+**    Function GPS_KALMAN_Filter_SteadyUpdate: update the state with a fixed gain
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. Full matrices are GPS_KALMAN_FILTER_LEN x GPS_KALMAN_FILTER_LEN, row-major.
+**       Covariances (P, Q, S) are symmetric and stored packed, upper triangle only,
+**       so they cannot drift away from symmetric.
+**    2. The measurement matrix H is identity, so it is never stored or multiplied
+**    3. The measurement noise is diagonal and passed as a vector of variances
+**    4. No inverse is formed per update: the gain is computed from a Cholesky solve.
+**       GPS_KALMAN_Filter_SymInverse is only for freezing a steady-state gain.
+**    5. These functions have no cFE, OSAL or GSL dependency and do not allocate
+**    6. The arithmetic lives in gps_kalman_filter_kernel.h and is shared with the
+**       filter bank in gps_kalman_bank.c
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**   2026-10-17 | GPS_KALMAN Team | Build #: Code Started
+**   2026-10-17 | GPS_KALMAN Team | Packed symmetric covariances, Joseph form update
+**   2026-10-17 | GPS_KALMAN Team | Move the arithmetic to the shared strided kernel
+**   2026-10-17 | GPS_KALMAN Team | 4-state constant velocity model
+**   2026-10-17 | GPS_KALMAN Team | Chi-square innovation gate
+**   2026-10-17 | GPS_KALMAN Team | Matrices in GPS_KALMAN_Real_t
+**   2026-10-17 | GPS_KALMAN Team | State-only steps with a frozen steady-state gain
+**
+**=====================================================================================*/
+
+#include <math.h>
+
+#include "gps_kalman_filter.h"
+#include "gps_kalman_filter_kernel.h"
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Filter_Identity
+**
+** Purpose: To set a full matrix to a scaled identity
+**
+** Arguments:
+**    GPS_KALMAN_Real_t M[]    - matrix to fill
+**    double scale             - value placed on the diagonal
+**
+** Returns:
+**    None
+**=====================================================================================*/
+void GPS_KALMAN_Filter_Identity(GPS_KALMAN_Real_t M[GPS_KALMAN_FILTER_MAT_LEN],
+                                double scale)
+{
+    GPS_KALMAN_Real_t d = GPS_KALMAN_D2R(scale);
+    int i;
+    int j;
+
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        for (j = 0; j < GPS_KALMAN_FILTER_LEN; j++)
+        {
+            M[i * GPS_KALMAN_FILTER_LEN + j] = (i == j) ? d : GPS_KALMAN_R_ZERO;
+        }
+    }
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Filter_SymIdentity
+**
+** Purpose: To set a packed symmetric matrix to a scaled identity
+**
+** Arguments:
+**    GPS_KALMAN_Real_t S[]    - packed matrix to fill
+**    double scale             - value placed on the diagonal
+**
+** Returns:
+**    None
+**=====================================================================================*/
+void GPS_KALMAN_Filter_SymIdentity(GPS_KALMAN_Real_t S[GPS_KALMAN_FILTER_SYM_LEN],
+                                   double scale)
+{
+    GPS_KALMAN_Real_t d = GPS_KALMAN_D2R(scale);
+    int i;
+    int j;
+
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        for (j = i; j < GPS_KALMAN_FILTER_LEN; j++)
+        {
+            S[GPS_KALMAN_SYM_IDX(i, j)] = (i == j) ? d : GPS_KALMAN_R_ZERO;
+        }
+    }
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Filter_SymUnpack
+**
+** Purpose: To expand a packed symmetric matrix to full storage
+**
+** Arguments:
+**    const GPS_KALMAN_Real_t S[]  - packed matrix
+**    GPS_KALMAN_Real_t M[]        - full matrix (output)
+**
+** Returns:
+**    None
+**=====================================================================================*/
+void GPS_KALMAN_Filter_SymUnpack(const GPS_KALMAN_Real_t S[GPS_KALMAN_FILTER_SYM_LEN],
+                                 GPS_KALMAN_Real_t M[GPS_KALMAN_FILTER_MAT_LEN])
+{
+    int i;
+    int j;
+
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        for (j = i; j < GPS_KALMAN_FILTER_LEN; j++)
+        {
+            M[i * GPS_KALMAN_FILTER_LEN + j] = S[GPS_KALMAN_SYM_IDX(i, j)];
+            M[j * GPS_KALMAN_FILTER_LEN + i] = S[GPS_KALMAN_SYM_IDX(i, j)];
+        }
+    }
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Filter_SymPack
+**
+** Purpose: To pack a full matrix into symmetric storage
+**
+** Arguments:
+**    const GPS_KALMAN_Real_t M[]  - full matrix
+**    GPS_KALMAN_Real_t S[]        - packed matrix (output)
+**
+** Returns:
+**    None
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. Off-diagonal pairs are averaged, which removes any asymmetry in M
+**=====================================================================================*/
+void GPS_KALMAN_Filter_SymPack(const GPS_KALMAN_Real_t M[GPS_KALMAN_FILTER_MAT_LEN],
+                               GPS_KALMAN_Real_t S[GPS_KALMAN_FILTER_SYM_LEN])
+{
+    int i;
+    int j;
+
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        S[GPS_KALMAN_SYM_IDX(i, i)] = M[i * GPS_KALMAN_FILTER_LEN + i];
+        for (j = i + 1; j < GPS_KALMAN_FILTER_LEN; j++)
+        {
+            S[GPS_KALMAN_SYM_IDX(i, j)] = GPS_KALMAN_RSAT(
+                    ((GPS_KALMAN_Acc_t) M[i * GPS_KALMAN_FILTER_LEN + j] +
+                     M[j * GPS_KALMAN_FILTER_LEN + i]) / 2);
+        }
+    }
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Filter_CVModel
+**
+** Purpose: To build the constant velocity state transition and process noise for one
+**          time step
+**
+** Arguments:
+**    double dt              - time step, seconds
+**    double q               - acceleration noise spectral density, state units^2 / s^3
+**    GPS_KALMAN_Real_t F[]  - state transition matrix (output)
+**    GPS_KALMAN_Real_t Q[]  - process noise covariance, packed (output)
+**
+** Returns:
+**    None
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. The two axes are independent and share q
+**    2. Callers cache the result on dt; a steady input rate then never rebuilds it
+**
+** Algorithm:
+**    Per axis, with position p and velocity v:
+**        F = | 1 dt |    Q = q * | dt^3/3  dt^2/2 |
+**            | 0  1 |            | dt^2/2  dt     |
+**    which is the exact discretisation of white acceleration noise over dt
+**=====================================================================================*/
+void GPS_KALMAN_Filter_CVModel(double dt, double q,
+                               GPS_KALMAN_Real_t F[GPS_KALMAN_FILTER_MAT_LEN],
+                               GPS_KALMAN_Real_t Q[GPS_KALMAN_FILTER_SYM_LEN])
+{
+    double q11 = q * dt;
+    double q01 = q11 * dt * 0.5;
+    double q00 = q01 * dt * (2.0 / 3.0);
+    GPS_KALMAN_Real_t rdt = GPS_KALMAN_D2R(dt);
+
+    GPS_KALMAN_Filter_Identity(F, 1.0);
+    F[GPS_KALMAN_STATE_N * GPS_KALMAN_FILTER_LEN + GPS_KALMAN_STATE_VN] = rdt;
+    F[GPS_KALMAN_STATE_E * GPS_KALMAN_FILTER_LEN + GPS_KALMAN_STATE_VE] = rdt;
+
+    GPS_KALMAN_Filter_SymIdentity(Q, 0.0);
+    Q[GPS_KALMAN_SYM_IDX(GPS_KALMAN_STATE_N,  GPS_KALMAN_STATE_N)]  = GPS_KALMAN_D2R(q00);
+    Q[GPS_KALMAN_SYM_IDX(GPS_KALMAN_STATE_N,  GPS_KALMAN_STATE_VN)] = GPS_KALMAN_D2R(q01);
+    Q[GPS_KALMAN_SYM_IDX(GPS_KALMAN_STATE_VN, GPS_KALMAN_STATE_VN)] = GPS_KALMAN_D2R(q11);
+    Q[GPS_KALMAN_SYM_IDX(GPS_KALMAN_STATE_E,  GPS_KALMAN_STATE_E)]  = GPS_KALMAN_D2R(q00);
+    Q[GPS_KALMAN_SYM_IDX(GPS_KALMAN_STATE_E,  GPS_KALMAN_STATE_VE)] = GPS_KALMAN_D2R(q01);
+    Q[GPS_KALMAN_SYM_IDX(GPS_KALMAN_STATE_VE, GPS_KALMAN_STATE_VE)] = GPS_KALMAN_D2R(q11);
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Filter_Predict
+**
+** Purpose: To propagate the state and covariance one step
+**
+** Arguments:
+**    const GPS_KALMAN_Real_t F[]  - state transition matrix
+**    const GPS_KALMAN_Real_t Q[]  - process noise covariance, packed
+**    GPS_KALMAN_Real_t x[]        - state, predicted in place
+**    GPS_KALMAN_Real_t P[]        - covariance, packed, predicted in place
+**
+** Returns:
+**    None
+**
+** Algorithm:
+**    See GPS_KALMAN_Kernel_Predict in gps_kalman_filter_kernel.h
+**=====================================================================================*/
+void GPS_KALMAN_Filter_Predict(const GPS_KALMAN_Real_t F[GPS_KALMAN_FILTER_MAT_LEN],
+                               const GPS_KALMAN_Real_t Q[GPS_KALMAN_FILTER_SYM_LEN],
+                               GPS_KALMAN_Real_t x[GPS_KALMAN_FILTER_LEN],
+                               GPS_KALMAN_Real_t P[GPS_KALMAN_FILTER_SYM_LEN])
+{
+    GPS_KALMAN_Kernel_Predict(F, Q, x, P, 1);
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Filter_Update
+**
+** Purpose: To apply one measurement update
+**
+** Arguments:
+**    const GPS_KALMAN_Real_t z[]  - measurement
+**    const GPS_KALMAN_Real_t r[]  - measurement noise variances (diagonal of SigmaActual)
+**    GPS_KALMAN_Real_t x[]        - state, updated in place
+**    GPS_KALMAN_Real_t P[]        - covariance, packed, updated in place
+**    GPS_KALMAN_Real_t S[]        - innovation covariance used for this update, packed (output)
+**    GPS_KALMAN_Real_t K[]        - gain used for this update (output)
+**    double gate                  - largest squared Mahalanobis distance of the
+**                                   innovation accepted; <= 0 accepts all
+**    double *d2                   - squared Mahalanobis distance (output)
+**
+** Returns:
+**    GPS_KALMAN_FILTER_SUCCESS
+**    GPS_KALMAN_FILTER_ERR_NOT_PD if S is not positive definite, or
+**    GPS_KALMAN_FILTER_ERR_GATED if d2 is over the gate; x and P are left untouched
+**    in both cases
+**
+** Algorithm:
+**    Innovation gate and Joseph form update, component by component or with a
+**    Cholesky solve for the gain (GPS_KALMAN_UPDATE_FORM), see
+**    GPS_KALMAN_Kernel_Update in gps_kalman_filter_kernel.h
+**=====================================================================================*/
+int GPS_KALMAN_Filter_Update(const GPS_KALMAN_Real_t z[GPS_KALMAN_FILTER_LEN],
+                             const GPS_KALMAN_Real_t r[GPS_KALMAN_FILTER_LEN],
+                             GPS_KALMAN_Real_t x[GPS_KALMAN_FILTER_LEN],
+                             GPS_KALMAN_Real_t P[GPS_KALMAN_FILTER_SYM_LEN],
+                             GPS_KALMAN_Real_t S[GPS_KALMAN_FILTER_SYM_LEN],
+                             GPS_KALMAN_Real_t K[GPS_KALMAN_FILTER_MAT_LEN],
+                             double gate, double *d2)
+{
+    GPS_KALMAN_Real_t d2r;
+    int status = GPS_KALMAN_Kernel_Update(z, r, x, P, S, K, &d2r, 1,
+                                          GPS_KALMAN_D2R(gate), 1);
+
+    *d2 = GPS_KALMAN_R2D(d2r);
+    return status;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Filter_SymInverse
+**
+** Purpose: To invert a packed symmetric positive definite matrix
+**
+** Arguments:
+**    const GPS_KALMAN_Real_t S[]  - matrix, packed
+**    GPS_KALMAN_Real_t Sinv[]     - its inverse, packed (output)
+**
+** Returns:
+**    GPS_KALMAN_FILTER_SUCCESS, or GPS_KALMAN_FILTER_ERR_NOT_PD with Sinv untouched
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. Worked in double whatever GPS_KALMAN_PRECISION is. It runs once per frozen
+**       gain, not per fix.
+**
+** Algorithm:
+**    S = L * L' (Cholesky), then column j of S^-1 solves L * L' * c = e_j
+**=====================================================================================*/
+int GPS_KALMAN_Filter_SymInverse(const GPS_KALMAN_Real_t S[GPS_KALMAN_FILTER_SYM_LEN],
+                                 GPS_KALMAN_Real_t Sinv[GPS_KALMAN_FILTER_SYM_LEN])
+{
+    double L[GPS_KALMAN_FILTER_LEN][GPS_KALMAN_FILTER_LEN];
+    double c[GPS_KALMAN_FILTER_LEN];
+    double inv[GPS_KALMAN_FILTER_SYM_LEN];
+    int    i;
+    int    j;
+    int    k;
+
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        for (j = 0; j <= i; j++)
+        {
+            double sum = GPS_KALMAN_R2D(S[GPS_KALMAN_SYM_IDX(j, i)]);
+
+            for (k = 0; k < j; k++)
+            {
+                sum -= L[i][k] * L[j][k];
+            }
+            if (i == j)
+            {
+                if (!(sum > 0.0))
+                {
+                    return GPS_KALMAN_FILTER_ERR_NOT_PD;
+                }
+                L[i][i] = sqrt(sum);
+            }
+            else
+            {
+                L[i][j] = sum / L[j][j];
+            }
+        }
+    }
+
+    for (j = 0; j < GPS_KALMAN_FILTER_LEN; j++)
+    {
+        /* L * y = e_j, then L' * c = y, in place */
+        for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+        {
+            double sum = (i == j) ? 1.0 : 0.0;
+
+            for (k = 0; k < i; k++)
+            {
+                sum -= L[i][k] * c[k];
+            }
+            c[i] = sum / L[i][i];
+        }
+        for (i = GPS_KALMAN_FILTER_LEN - 1; i >= 0; i--)
+        {
+            double sum = c[i];
+
+            for (k = i + 1; k < GPS_KALMAN_FILTER_LEN; k++)
+            {
+                sum -= L[k][i] * c[k];
+            }
+            c[i] = sum / L[i][i];
+        }
+        for (i = 0; i <= j; i++)
+        {
+            inv[GPS_KALMAN_SYM_IDX(i, j)] = c[i];
+        }
+    }
+
+    for (i = 0; i < GPS_KALMAN_FILTER_SYM_LEN; i++)
+    {
+        Sinv[i] = GPS_KALMAN_D2R(inv[i]);
+    }
+    return GPS_KALMAN_FILTER_SUCCESS;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Filter_SteadyPredict
+**
+** Purpose: To propagate the state one step without its covariance
+**
+** Arguments:
+**    const GPS_KALMAN_Real_t F[]  - state transition matrix
+**    GPS_KALMAN_Real_t x[]        - state, predicted in place
+**
+** Returns:
+**    None
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. Only for a gain frozen at steady state, where the covariance no longer
+**       changes from one step to the next
+**
+** Algorithm:
+**    x = F * x, the state half of GPS_KALMAN_Kernel_Predict
+**=====================================================================================*/
+void GPS_KALMAN_Filter_SteadyPredict(const GPS_KALMAN_Real_t F[GPS_KALMAN_FILTER_MAT_LEN],
+                                     GPS_KALMAN_Real_t x[GPS_KALMAN_FILTER_LEN])
+{
+    GPS_KALMAN_Real_t xv[GPS_KALMAN_FILTER_LEN];
+    int i;
+    int k;
+
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        xv[i] = x[i];
+    }
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        GPS_KALMAN_Acc_t s = GPS_KALMAN_RMUL(F[i * GPS_KALMAN_FILTER_LEN], xv[0]);
+
+        for (k = 1; k < GPS_KALMAN_FILTER_LEN; k++)
+        {
+            s += GPS_KALMAN_RMUL(F[i * GPS_KALMAN_FILTER_LEN + k], xv[k]);
+        }
+        x[i] = GPS_KALMAN_RSAT(s);
+    }
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Filter_SteadyUpdate
+**
+** Purpose: To update the state with a fixed gain
+**
+** Arguments:
+**    const GPS_KALMAN_Real_t z[]     - measurement
+**    const GPS_KALMAN_Real_t K[]     - steady-state gain
+**    const GPS_KALMAN_Real_t Sinv[]  - inverse of the steady-state innovation
+**                                      covariance, packed
+**    GPS_KALMAN_Real_t x[]           - state, updated in place
+**    double gate                     - largest squared Mahalanobis distance of the
+**                                      innovation accepted; <= 0 accepts all
+**    double *d2                      - squared Mahalanobis distance (output)
+**
+** Returns:
+**    GPS_KALMAN_FILTER_SUCCESS, or GPS_KALMAN_FILTER_ERR_GATED with x untouched
+**
+** Algorithm:
+**    y = z - x, d2 = y' * Sinv * y, x = x + K * y: no division, no square root and
+**    no covariance, against the triangular solves and rank-1 updates of
+**    GPS_KALMAN_Filter_Update
+**=====================================================================================*/
+int GPS_KALMAN_Filter_SteadyUpdate(const GPS_KALMAN_Real_t z[GPS_KALMAN_FILTER_LEN],
+                                   const GPS_KALMAN_Real_t K[GPS_KALMAN_FILTER_MAT_LEN],
+                                   const GPS_KALMAN_Real_t Sinv[GPS_KALMAN_FILTER_SYM_LEN],
+                                   GPS_KALMAN_Real_t x[GPS_KALMAN_FILTER_LEN],
+                                   double gate, double *d2)
+{
+    GPS_KALMAN_Real_t y[GPS_KALMAN_FILTER_LEN];
+    GPS_KALMAN_Acc_t  d2acc = 0;
+    int i;
+    int k;
+
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        y[i] = GPS_KALMAN_RSAT((GPS_KALMAN_Acc_t) z[i] - x[i]);
+    }
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        GPS_KALMAN_Acc_t s = 0;
+
+        for (k = 0; k < GPS_KALMAN_FILTER_LEN; k++)
+        {
+            s += GPS_KALMAN_RMUL((i <= k) ? Sinv[GPS_KALMAN_SYM_IDX(i, k)] :
+                                            Sinv[GPS_KALMAN_SYM_IDX(k, i)], y[k]);
+        }
+        d2acc += GPS_KALMAN_RMUL(GPS_KALMAN_RSAT(s), y[i]);
+    }
+
+    *d2 = GPS_KALMAN_R2D(GPS_KALMAN_RSAT(d2acc));
+    if ((gate > 0.0) && !(*d2 <= gate))
+    {
+        return GPS_KALMAN_FILTER_ERR_GATED;
+    }
+
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        GPS_KALMAN_Acc_t s = x[i];
+
+        for (k = 0; k < GPS_KALMAN_FILTER_LEN; k++)
+        {
+            s += GPS_KALMAN_RMUL(K[i * GPS_KALMAN_FILTER_LEN + k], y[k]);
+        }
+        x[i] = GPS_KALMAN_RSAT(s);
+    }
+    return GPS_KALMAN_FILTER_SUCCESS;
+}
+
+/*=======================================================================================
+** End of file gps_kalman_filter.c
+**=====================================================================================*/
@@ -0,0 +1,277 @@
+/*=======================================================================================
+** File Name:  gps_kalman_filter.h
+**
+** Title:  Header File for the GPS_KALMAN fixed-size filter kernel
+**
+** $Author:    GPS_KALMAN Team
+** $Revision: 1.1 $
+** $Date:      2026-10-17
+**
+** Purpose:  To define the fixed-dimension predict/update kernel used by GPS_KALMAN_RunFilter.
+**           The kernel works on plain arrays sized by GPS_KALMAN_FILTER_LEN and has no
+**           cFE, OSAL or GSL dependency.
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**   2026-10-17 | GPS_KALMAN Team | Build #: Code Started
+**   2026-10-17 | GPS_KALMAN Team | Packed symmetric covariances, Joseph form update
+**   2026-10-17 | GPS_KALMAN Team | 4-state constant velocity model
+**   2026-10-17 | GPS_KALMAN Team | Build-time choice of double, float or fixed point
+**   2026-10-17 | GPS_KALMAN Team | Chi-square innovation gate
+**   2026-10-17 | GPS_KALMAN Team | Build-time choice of sequential or joint update
+**   2026-10-17 | GPS_KALMAN Team | State-only steps with a frozen steady-state gain
+**
+**=====================================================================================*/
+
+#ifndef _GPS_KALMAN_FILTER_H_
+#define _GPS_KALMAN_FILTER_H_
+
+#include <stdint.h>
+
+/* Size of the vectors (1x4) and matrices (4x4) in the filter */
+#define GPS_KALMAN_FILTER_LEN (4)
+
+/* State layout of the constant velocity model. The measurement has the same layout
+** (H = identity). Positions are metres in a local tangent plane, velocities m/s. */
+#define GPS_KALMAN_STATE_N   (0) /* north position */
+#define GPS_KALMAN_STATE_E   (1) /* east position */
+#define GPS_KALMAN_STATE_VN  (2) /* north velocity */
+#define GPS_KALMAN_STATE_VE  (3) /* east velocity */
+
+/* Number of elements in a full GPS_KALMAN_FILTER_LEN x GPS_KALMAN_FILTER_LEN matrix */
+#define GPS_KALMAN_FILTER_MAT_LEN (GPS_KALMAN_FILTER_LEN * GPS_KALMAN_FILTER_LEN)
+
+/* Number of elements in a packed symmetric matrix (upper triangle, row by row):
+**    | 0 1 2 3 |
+**    | . 4 5 6 |
+**    | . . 7 8 |
+**    | . . . 9 |
+*/
+#define GPS_KALMAN_FILTER_SYM_LEN (GPS_KALMAN_FILTER_LEN * (GPS_KALMAN_FILTER_LEN + 1) / 2)
+
+/* Packed index of element (i, j) of a symmetric matrix, i <= j */
+#define GPS_KALMAN_SYM_IDX(i, j) \
+    ((i) * GPS_KALMAN_FILTER_LEN - ((i) * ((i) - 1)) / 2 + ((j) - (i)))
+
+/* Kernel status codes */
+#define GPS_KALMAN_FILTER_SUCCESS     (0)
+#define GPS_KALMAN_FILTER_ERR_NOT_PD  (-1) /* innovation covariance not positive definite */
+#define GPS_KALMAN_FILTER_ERR_GATED   (-2) /* innovation outside the chi-square gate */
+
+/*
+** Filter arithmetic, chosen at build time with GPS_KALMAN_PRECISION:
+**    GPS_KALMAN_PRECISION_DOUBLE  IEEE double, the reference (default)
+**    GPS_KALMAN_PRECISION_FLOAT   IEEE single, for FPUs without fast double
+**    GPS_KALMAN_PRECISION_FIXED   signed Q(31-F).F in an int32, F =
+**                                 GPS_KALMAN_FIXED_FRAC_BITS, for cores with no FPU
+** Only the filter matrices and the kernel change. Scalars passed to these functions
+** are double, and callers convert with GPS_KALMAN_D2R and GPS_KALMAN_R2D.
+*/
+#define GPS_KALMAN_PRECISION_DOUBLE  (0)
+#define GPS_KALMAN_PRECISION_FLOAT   (1)
+#define GPS_KALMAN_PRECISION_FIXED   (2)
+
+#ifndef GPS_KALMAN_PRECISION
+#define GPS_KALMAN_PRECISION GPS_KALMAN_PRECISION_DOUBLE
+#endif
+
+#if (GPS_KALMAN_PRECISION == GPS_KALMAN_PRECISION_DOUBLE)
+
+typedef double GPS_KALMAN_Real_t;   /* element of the filter matrices */
+typedef double GPS_KALMAN_Acc_t;    /* sums of products */
+
+#define GPS_KALMAN_R_ZERO       (0.0)
+#define GPS_KALMAN_R_ONE        (1.0)
+#define GPS_KALMAN_R_MAX        (1.0e300)
+#define GPS_KALMAN_D2R(d)       (d)
+#define GPS_KALMAN_R2D(r)       (r)
+#define GPS_KALMAN_RMUL(a, b)   ((a) * (b))
+#define GPS_KALMAN_RSAT(acc)    (acc)
+#define GPS_KALMAN_RRSQRT(r)    (1.0 / sqrt(r))
+#define GPS_KALMAN_RRECIP(r)    (1.0 / (r))
+
+#elif (GPS_KALMAN_PRECISION == GPS_KALMAN_PRECISION_FLOAT)
+
+typedef float GPS_KALMAN_Real_t;
+typedef float GPS_KALMAN_Acc_t;
+
+#define GPS_KALMAN_R_ZERO       (0.0f)
+#define GPS_KALMAN_R_ONE        (1.0f)
+#define GPS_KALMAN_R_MAX        (1.0e38)
+#define GPS_KALMAN_D2R(d)       ((float) (d))
+#define GPS_KALMAN_R2D(r)       ((double) (r))
+#define GPS_KALMAN_RMUL(a, b)   ((a) * (b))
+#define GPS_KALMAN_RSAT(acc)    (acc)
+#define GPS_KALMAN_RRSQRT(r)    (1.0f / sqrtf(r))
+#define GPS_KALMAN_RRECIP(r)    (1.0f / (r))
+
+#elif (GPS_KALMAN_PRECISION == GPS_KALMAN_PRECISION_FIXED)
+
+/* Fraction bits. 16 gives +/-32767 m and 15 um, and +/-32767 m^2 of variance. */
+#ifndef GPS_KALMAN_FIXED_FRAC_BITS
+#define GPS_KALMAN_FIXED_FRAC_BITS  (16)
+#endif
+#if (GPS_KALMAN_FIXED_FRAC_BITS < 8) || (GPS_KALMAN_FIXED_FRAC_BITS > 20)
+#error "GPS_KALMAN_FIXED_FRAC_BITS must be 8 to 20"
+#endif
+
+/* Products are kept in 64 bits and saturated back to 32 only when stored */
+typedef int32_t GPS_KALMAN_Real_t;
+typedef int64_t GPS_KALMAN_Acc_t;
+
+#define GPS_KALMAN_R_ZERO       (0)
+#define GPS_KALMAN_R_ONE        ((int32_t) 1 << GPS_KALMAN_FIXED_FRAC_BITS)
+#define GPS_KALMAN_R_MAX        (2147483647.0 / (double) GPS_KALMAN_R_ONE)
+#define GPS_KALMAN_D2R(d)       GPS_KALMAN_Fixed_FromDouble(d)
+#define GPS_KALMAN_R2D(r)       ((double) (r) * (1.0 / (double) GPS_KALMAN_R_ONE))
+#define GPS_KALMAN_RMUL(a, b)   \
+    (((int64_t) (a) * (b) + ((int64_t) 1 << (GPS_KALMAN_FIXED_FRAC_BITS - 1))) >> \
+     GPS_KALMAN_FIXED_FRAC_BITS)
+#define GPS_KALMAN_RSAT(acc)    GPS_KALMAN_Fixed_Sat(acc)
+#define GPS_KALMAN_RRSQRT(r)    GPS_KALMAN_Fixed_RSqrt(r)
+#define GPS_KALMAN_RRECIP(r)    GPS_KALMAN_Fixed_Recip(r)
+
+/* Nearest representable value, saturated */
+static inline int32_t GPS_KALMAN_Fixed_FromDouble(double d)
+{
+    double v = d * (double) GPS_KALMAN_R_ONE;
+
+    if (v >= 2147483647.0)
+    {
+        return INT32_MAX;
+    }
+    if (v <= -2147483648.0)
+    {
+        return INT32_MIN;
+    }
+    return (int32_t) ((v >= 0.0) ? v + 0.5 : v - 0.5);
+}
+
+static inline int32_t GPS_KALMAN_Fixed_Sat(int64_t acc)
+{
+    return (acc > INT32_MAX) ? INT32_MAX : ((acc < INT32_MIN) ? INT32_MIN : (int32_t) acc);
+}
+
+/* 1 / r for r > 0: 2^2F / r, saturated */
+static inline int32_t GPS_KALMAN_Fixed_Recip(int32_t r)
+{
+    return GPS_KALMAN_Fixed_Sat(((int64_t) 1 << (2 * GPS_KALMAN_FIXED_FRAC_BITS)) / r);
+}
+
+/* 1 / sqrt(r) for r > 0: 2^F / sqrt(r / 2^F) = sqrt(2^3F / r), by integer square root */
+static inline int32_t GPS_KALMAN_Fixed_RSqrt(int32_t r)
+{
+    uint64_t v = ((uint64_t) 1 << (3 * GPS_KALMAN_FIXED_FRAC_BITS)) / (uint64_t) r;
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t) 1 << 62;
+
+    while (bit > v)
+    {
+        bit >>= 2;
+    }
+    while (bit != 0)
+    {
+        if (v >= root + bit)
+        {
+            v -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (root > INT32_MAX) ? INT32_MAX : (int32_t) root;
+}
+
+#else
+#error "GPS_KALMAN_PRECISION must be GPS_KALMAN_PRECISION_DOUBLE, _FLOAT or _FIXED"
+#endif
+
+#if defined(GPS_KALMAN_USE_GSL) && (GPS_KALMAN_PRECISION != GPS_KALMAN_PRECISION_DOUBLE)
+#error "The GSL BLAS path is double only"
+#endif
+
+/*
+** Measurement update, chosen at build time with GPS_KALMAN_UPDATE_FORM:
+**    GPS_KALMAN_UPDATE_FORM_SEQUENTIAL  one scalar update per measurement component,
+**                                       divisions and rank-1 covariance updates only
+**                                       (default)
+**    GPS_KALMAN_UPDATE_FORM_JOINT       all components at once, the gain from a
+**                                       Cholesky solve of the innovation covariance
+** Both give the same x, P, S, K and d2 up to rounding. The GSL path has its own.
+*/
+#define GPS_KALMAN_UPDATE_FORM_SEQUENTIAL  (0)
+#define GPS_KALMAN_UPDATE_FORM_JOINT       (1)
+
+#ifndef GPS_KALMAN_UPDATE_FORM
+#define GPS_KALMAN_UPDATE_FORM GPS_KALMAN_UPDATE_FORM_SEQUENTIAL
+#endif
+
+#if (GPS_KALMAN_UPDATE_FORM != GPS_KALMAN_UPDATE_FORM_SEQUENTIAL) && \
+    (GPS_KALMAN_UPDATE_FORM != GPS_KALMAN_UPDATE_FORM_JOINT)
+#error "GPS_KALMAN_UPDATE_FORM must be GPS_KALMAN_UPDATE_FORM_SEQUENTIAL or _JOINT"
+#endif
+
+/* M = scale * identity, full storage */
+void GPS_KALMAN_Filter_Identity(GPS_KALMAN_Real_t M[GPS_KALMAN_FILTER_MAT_LEN],
+                                double scale);
+
+/* S = scale * identity, packed symmetric storage */
+void GPS_KALMAN_Filter_SymIdentity(GPS_KALMAN_Real_t S[GPS_KALMAN_FILTER_SYM_LEN],
+                                   double scale);
+
+/* Packed symmetric <-> full storage. Packing averages M(i, j) and M(j, i). */
+void GPS_KALMAN_Filter_SymUnpack(const GPS_KALMAN_Real_t S[GPS_KALMAN_FILTER_SYM_LEN],
+                                 GPS_KALMAN_Real_t M[GPS_KALMAN_FILTER_MAT_LEN]);
+void GPS_KALMAN_Filter_SymPack(const GPS_KALMAN_Real_t M[GPS_KALMAN_FILTER_MAT_LEN],
+                               GPS_KALMAN_Real_t S[GPS_KALMAN_FILTER_SYM_LEN]);
+
+/* F and packed Q of the constant velocity model for a step of dt seconds, with white
+** acceleration noise of spectral density q (state units^2 / s^3) on each axis */
+void GPS_KALMAN_Filter_CVModel(double dt, double q,
+                               GPS_KALMAN_Real_t F[GPS_KALMAN_FILTER_MAT_LEN],
+                               GPS_KALMAN_Real_t Q[GPS_KALMAN_FILTER_SYM_LEN]);
+
+/* x = F * x, P = F * P * F' + Q  (P and Q packed) */
+void GPS_KALMAN_Filter_Predict(const GPS_KALMAN_Real_t F[GPS_KALMAN_FILTER_MAT_LEN],
+                               const GPS_KALMAN_Real_t Q[GPS_KALMAN_FILTER_SYM_LEN],
+                               GPS_KALMAN_Real_t x[GPS_KALMAN_FILTER_LEN],
+                               GPS_KALMAN_Real_t P[GPS_KALMAN_FILTER_SYM_LEN]);
+
+/* S = P + diag(r), d2 = (z - x)' * S^-1 * (z - x); unless d2 > gate > 0,
+** K = P * S^-1, x = x + K * (z - x),
+** P = (I - K) * P * (I - K)' + K * diag(r) * K'  (H = identity, P and S packed),
+** by GPS_KALMAN_UPDATE_FORM */
+int GPS_KALMAN_Filter_Update(const GPS_KALMAN_Real_t z[GPS_KALMAN_FILTER_LEN],
+                             const GPS_KALMAN_Real_t r[GPS_KALMAN_FILTER_LEN],
+                             GPS_KALMAN_Real_t x[GPS_KALMAN_FILTER_LEN],
+                             GPS_KALMAN_Real_t P[GPS_KALMAN_FILTER_SYM_LEN],
+                             GPS_KALMAN_Real_t S[GPS_KALMAN_FILTER_SYM_LEN],
+                             GPS_KALMAN_Real_t K[GPS_KALMAN_FILTER_MAT_LEN],
+                             double gate, double *d2);
+
+/* Sinv = S^-1 (both packed), for S positive definite; GPS_KALMAN_FILTER_SUCCESS or
+** GPS_KALMAN_FILTER_ERR_NOT_PD */
+int GPS_KALMAN_Filter_SymInverse(const GPS_KALMAN_Real_t S[GPS_KALMAN_FILTER_SYM_LEN],
+                                 GPS_KALMAN_Real_t Sinv[GPS_KALMAN_FILTER_SYM_LEN]);
+
+/* x = F * x, with no covariance, for a filter whose gain has reached steady state */
+void GPS_KALMAN_Filter_SteadyPredict(const GPS_KALMAN_Real_t F[GPS_KALMAN_FILTER_MAT_LEN],
+                                     GPS_KALMAN_Real_t x[GPS_KALMAN_FILTER_LEN]);
+
+/* d2 = (z - x)' * Sinv * (z - x); unless d2 > gate > 0, x = x + K * (z - x), with the
+** steady-state K and S^-1 */
+int GPS_KALMAN_Filter_SteadyUpdate(const GPS_KALMAN_Real_t z[GPS_KALMAN_FILTER_LEN],
+                                   const GPS_KALMAN_Real_t K[GPS_KALMAN_FILTER_MAT_LEN],
+                                   const GPS_KALMAN_Real_t Sinv[GPS_KALMAN_FILTER_SYM_LEN],
+                                   GPS_KALMAN_Real_t x[GPS_KALMAN_FILTER_LEN],
+                                   double gate, double *d2);
+
+#endif /* _GPS_KALMAN_FILTER_H_ */
+
+/*=======================================================================================
+** End of file gps_kalman_filter.h
+**=====================================================================================*/
@@ -0,0 +1,660 @@
+/*=======================================================================================
+** File Name:  gps_kalman_filter_kernel.h
+**
+** Title:  Private strided kernel shared by the GPS_KALMAN scalar filter and filter bank
+**
+** $Author:    GPS_KALMAN Team
+** $Revision: 1.1 $
+** $Date:      2026-10-17
+**
+** Purpose:  To hold the single definition of the predict/update arithmetic. The scalar
+**           API in gps_kalman_filter.c runs it with a stride of 1; the structure-of-arrays
+**           bank in gps_kalman_bank.c runs it once per track with a stride equal to the
+**           bank capacity, so the compiler vectorises across tracks. Because both use the
+**           same expressions in the same order, per-track bank results are bit-identical
+**           to the scalar filter when built with the same floating point flags (in
+**           particular, no FMA contraction: -ffp-contract=off).
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. Private to gps_kalman_filter.c and gps_kalman_bank.c, do not include elsewhere
+**    2. Element j of a per-filter array lives at [j * stride]. F and Q are shared and
+**       always contiguous.
+**    3. The update is branch-free (the positive definite check selects the result
+**       instead of returning early), so the bank's track loop has no control flow.
+**    4. All loops have compile-time bounds (GPS_KALMAN_FILTER_LEN) and are fully
+**       unrolled, so packed indices fold to constants.
+**    5. Products go through GPS_KALMAN_RMUL and stores through GPS_KALMAN_RSAT, which
+**       reduce to the plain expressions for double and float, and rescale and
+**       saturate for fixed point. Sums are kept in GPS_KALMAN_Acc_t.
+**    6. GPS_KALMAN_UPDATE_FORM picks one of two GPS_KALMAN_Kernel_Update bodies with
+**       the same interface: scalar updates component by component, or one joint
+**       update through a Cholesky solve
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**   2026-10-17 | GPS_KALMAN Team | Build #: Code Started
+**   2026-10-17 | GPS_KALMAN Team | Fixed-bound loops for the 4-state model
+**   2026-10-17 | GPS_KALMAN Team | Arithmetic in GPS_KALMAN_Real_t for each precision
+**   2026-10-17 | GPS_KALMAN Team | Chi-square innovation gate
+**   2026-10-17 | GPS_KALMAN Team | Sequential scalar update
+**
+**=====================================================================================*/
+
+#ifndef _GPS_KALMAN_FILTER_KERNEL_H_
+#define _GPS_KALMAN_FILTER_KERNEL_H_
+
+#include <math.h>
+#include <stddef.h>
+
+#include "gps_kalman_filter.h"
+
+#define GPS_KALMAN_KN GPS_KALMAN_FILTER_LEN
+
+/* Fully unroll the fixed-bound loops below, so the bank's track loop is straight-line
+** code the vectoriser accepts */
+#if defined(__clang__)
+#define GPS_KALMAN_KERNEL_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__) && (__GNUC__ >= 8)
+#define GPS_KALMAN_KERNEL_UNROLL _Pragma("GCC unroll 16")
+#else
+#define GPS_KALMAN_KERNEL_UNROLL
+#endif
+
+/* The bank's track loops can only vectorise once the kernel is inlined into them */
+#if defined(__GNUC__)
+#define GPS_KALMAN_KERNEL_INLINE static inline __attribute__((always_inline))
+#else
+#define GPS_KALMAN_KERNEL_INLINE static inline
+#endif
+
+/* Row-major element access */
+#define GPS_KALMAN_KM(A, i, j) ((A)[(i) * GPS_KALMAN_KN + (j)])
+
+/* Packed symmetric element access, any (i, j) */
+#define GPS_KALMAN_KS(A, i, j) \
+    ((A)[((i) <= (j)) ? GPS_KALMAN_SYM_IDX(i, j) : GPS_KALMAN_SYM_IDX(j, i)])
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Kernel_CholForward
+**
+** Purpose: Solve L * out = b given the Cholesky factor L of S
+**
+** Arguments:
+**    const GPS_KALMAN_Real_t L[]     - lower factor, row-major, strictly lower part used
+**    const GPS_KALMAN_Real_t dinv[]  - reciprocals of the factor's diagonal
+**    const GPS_KALMAN_Real_t b[]     - right hand side
+**    GPS_KALMAN_Real_t out[]         - solution
+**
+** Returns:
+**    None
+**=====================================================================================*/
+GPS_KALMAN_KERNEL_INLINE
+void GPS_KALMAN_Kernel_CholForward(const GPS_KALMAN_Real_t L[GPS_KALMAN_FILTER_MAT_LEN],
+                                   const GPS_KALMAN_Real_t dinv[GPS_KALMAN_FILTER_LEN],
+                                   const GPS_KALMAN_Real_t b[GPS_KALMAN_FILTER_LEN],
+                                   GPS_KALMAN_Real_t out[GPS_KALMAN_FILTER_LEN])
+{
+    int    i;
+    int    k;
+
+    GPS_KALMAN_KERNEL_UNROLL
+    for (i = 0; i < GPS_KALMAN_KN; i++)
+    {
+        GPS_KALMAN_Acc_t s = b[i];
+        GPS_KALMAN_KERNEL_UNROLL
+        for (k = 0; k < i; k++)
+        {
+            s -= GPS_KALMAN_RMUL(GPS_KALMAN_KM(L, i, k), out[k]);
+        }
+        out[i] = GPS_KALMAN_RSAT(GPS_KALMAN_RMUL(GPS_KALMAN_RSAT(s), dinv[i]));
+    }
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Kernel_CholSolve
+**
+** Purpose: Solve S * out = b given the Cholesky factor of S
+**
+** Arguments:
+**    const GPS_KALMAN_Real_t L[]     - lower factor, row-major, strictly lower part used
+**    const GPS_KALMAN_Real_t dinv[]  - reciprocals of the factor's diagonal
+**    const GPS_KALMAN_Real_t b[]     - right hand side
+**    GPS_KALMAN_Real_t out[]         - solution
+**
+** Returns:
+**    None
+**=====================================================================================*/
+GPS_KALMAN_KERNEL_INLINE
+void GPS_KALMAN_Kernel_CholSolve(const GPS_KALMAN_Real_t L[GPS_KALMAN_FILTER_MAT_LEN],
+                                 const GPS_KALMAN_Real_t dinv[GPS_KALMAN_FILTER_LEN],
+                                 const GPS_KALMAN_Real_t b[GPS_KALMAN_FILTER_LEN],
+                                 GPS_KALMAN_Real_t out[GPS_KALMAN_FILTER_LEN])
+{
+    GPS_KALMAN_Real_t y[GPS_KALMAN_FILTER_LEN];
+    int    i;
+    int    k;
+
+    /* forward substitution: L * y = b */
+    GPS_KALMAN_Kernel_CholForward(L, dinv, b, y);
+
+    /* back substitution: L' * out = y */
+    GPS_KALMAN_KERNEL_UNROLL
+    for (i = GPS_KALMAN_KN - 1; i >= 0; i--)
+    {
+        GPS_KALMAN_Acc_t s = y[i];
+        GPS_KALMAN_KERNEL_UNROLL
+        for (k = i + 1; k < GPS_KALMAN_KN; k++)
+        {
+            s -= GPS_KALMAN_RMUL(GPS_KALMAN_KM(L, k, i), out[k]);
+        }
+        out[i] = GPS_KALMAN_RSAT(GPS_KALMAN_RMUL(GPS_KALMAN_RSAT(s), dinv[i]));
+    }
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Kernel_Predict
+**
+** Purpose: To propagate one filter's state and covariance one step
+**
+** Arguments:
+**    const GPS_KALMAN_Real_t F[]  - state transition matrix, shared
+**    const GPS_KALMAN_Real_t Q[]  - process noise covariance, packed, shared
+**    GPS_KALMAN_Real_t x[]        - state, strided, predicted in place
+**    GPS_KALMAN_Real_t P[]        - covariance, packed, strided, predicted in place
+**    size_t st                    - stride between elements of x and P
+**
+** Returns:
+**    None
+**
+** Algorithm:
+**    x = F * x
+**    T = F * P
+**    P = T * F' + Q, upper triangle only
+**=====================================================================================*/
+GPS_KALMAN_KERNEL_INLINE
+void GPS_KALMAN_Kernel_Predict(const GPS_KALMAN_Real_t * restrict F,
+                               const GPS_KALMAN_Real_t * restrict Q,
+                               GPS_KALMAN_Real_t * restrict x,
+                               GPS_KALMAN_Real_t * restrict P,
+                               size_t st)
+{
+    GPS_KALMAN_Real_t xv[GPS_KALMAN_FILTER_LEN];
+    GPS_KALMAN_Real_t Pv[GPS_KALMAN_FILTER_SYM_LEN];
+    GPS_KALMAN_Real_t T[GPS_KALMAN_FILTER_MAT_LEN];
+    int    i;
+    int    j;
+    int    k;
+
+    GPS_KALMAN_KERNEL_UNROLL
+    for (i = 0; i < GPS_KALMAN_KN; i++)
+    {
+        xv[i] = x[i * st];
+    }
+    GPS_KALMAN_KERNEL_UNROLL
+    for (i = 0; i < GPS_KALMAN_FILTER_SYM_LEN; i++)
+    {
+        Pv[i] = P[i * st];
+    }
+
+    /* x = F * x */
+    GPS_KALMAN_KERNEL_UNROLL
+    for (i = 0; i < GPS_KALMAN_KN; i++)
+    {
+        GPS_KALMAN_Acc_t s = GPS_KALMAN_RMUL(GPS_KALMAN_KM(F, i, 0), xv[0]);
+        GPS_KALMAN_KERNEL_UNROLL
+        for (k = 1; k < GPS_KALMAN_KN; k++)
+        {
+            s += GPS_KALMAN_RMUL(GPS_KALMAN_KM(F, i, k), xv[k]);
+        }
+        x[i * st] = GPS_KALMAN_RSAT(s);
+    }
+
+    /* T = F * P */
+    GPS_KALMAN_KERNEL_UNROLL
+    for (i = 0; i < GPS_KALMAN_KN; i++)
+    {
+        GPS_KALMAN_KERNEL_UNROLL
+        for (j = 0; j < GPS_KALMAN_KN; j++)
+        {
+            GPS_KALMAN_Acc_t s =
+                GPS_KALMAN_RMUL(GPS_KALMAN_KM(F, i, 0), GPS_KALMAN_KS(Pv, 0, j));
+            GPS_KALMAN_KERNEL_UNROLL
+            for (k = 1; k < GPS_KALMAN_KN; k++)
+            {
+                s += GPS_KALMAN_RMUL(GPS_KALMAN_KM(F, i, k), GPS_KALMAN_KS(Pv, k, j));
+            }
+            GPS_KALMAN_KM(T, i, j) = GPS_KALMAN_RSAT(s);
+        }
+    }
+
+    /* P = T * F' + Q */
+    GPS_KALMAN_KERNEL_UNROLL
+    for (i = 0; i < GPS_KALMAN_KN; i++)
+    {
+        GPS_KALMAN_KERNEL_UNROLL
+        for (j = i; j < GPS_KALMAN_KN; j++)
+        {
+            GPS_KALMAN_Acc_t s =
+                GPS_KALMAN_RMUL(GPS_KALMAN_KM(T, i, 0), GPS_KALMAN_KM(F, j, 0));
+            GPS_KALMAN_KERNEL_UNROLL
+            for (k = 1; k < GPS_KALMAN_KN; k++)
+            {
+                s += GPS_KALMAN_RMUL(GPS_KALMAN_KM(T, i, k), GPS_KALMAN_KM(F, j, k));
+            }
+            P[GPS_KALMAN_SYM_IDX(i, j) * st] =
+                GPS_KALMAN_RSAT(s + Q[GPS_KALMAN_SYM_IDX(i, j)]);
+        }
+    }
+}
+
+#if (GPS_KALMAN_UPDATE_FORM == GPS_KALMAN_UPDATE_FORM_JOINT)
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Kernel_Update
+**
+** Purpose: To apply one measurement update to one filter, all components at once
+**
+** Arguments:
+**    const GPS_KALMAN_Real_t z[] - measurement, strided
+**    const GPS_KALMAN_Real_t r[] - measurement noise variances, strided
+**    GPS_KALMAN_Real_t x[]       - state, strided, updated in place
+**    GPS_KALMAN_Real_t P[]       - covariance, packed, strided, updated in place
+**    GPS_KALMAN_Real_t S[]       - innovation covariance, packed, strided (output)
+**    GPS_KALMAN_Real_t K[]       - gain, strided (output)
+**    GPS_KALMAN_Real_t d2[]      - squared Mahalanobis distance of the innovation,
+**                                  strided (output)
+**    size_t st                   - stride between elements of all the arrays above
+**    GPS_KALMAN_Real_t gate      - largest d2 accepted, shared; <= 0 accepts all
+**    int apply                   - when zero, S, K and d2 are still formed but x and
+**                                  P are kept
+**
+** Returns:
+**    GPS_KALMAN_FILTER_SUCCESS
+**    GPS_KALMAN_FILTER_ERR_NOT_PD if S is not positive definite; x and P are kept
+**    GPS_KALMAN_FILTER_ERR_GATED if d2 is over the gate; x and P are kept
+**
+** Algorithm:
+**    With H = I the innovation covariance is S = P + diag(r). S is factored as L * L'
+**    and, since S and P are symmetric, row j of K = P * S^-1 is the solution of
+**    S * k = P(:, j). The innovation y = z - x is tested against the gate first:
+**        d2 = y' * S^-1 * y = w' * w,  with L * w = y
+**    which is the forward half of one more solve with the same factor. d2 is chi-square
+**    with GPS_KALMAN_FILTER_LEN degrees of freedom for a consistent filter. Then
+**        x = x + K * (z - x)
+**        A = I - K
+**        P = A * P * A' + K * diag(r) * K'      (Joseph form)
+**    The Joseph form is a sum of two symmetric positive semi-definite terms, so P
+**    stays positive definite even when K is not exactly optimal due to rounding,
+**    unlike P = P - K * P. Only the upper triangle of P is formed.
+**=====================================================================================*/
+GPS_KALMAN_KERNEL_INLINE
+int GPS_KALMAN_Kernel_Update(const GPS_KALMAN_Real_t * restrict z,
+                             const GPS_KALMAN_Real_t * restrict r,
+                             GPS_KALMAN_Real_t * restrict x,
+                             GPS_KALMAN_Real_t * restrict P,
+                             GPS_KALMAN_Real_t * restrict S,
+                             GPS_KALMAN_Real_t * restrict K,
+                             GPS_KALMAN_Real_t * restrict d2,
+                             size_t st, GPS_KALMAN_Real_t gate, int apply)
+{
+    GPS_KALMAN_Real_t xv[GPS_KALMAN_FILTER_LEN];
+    GPS_KALMAN_Real_t rv[GPS_KALMAN_FILTER_LEN];
+    GPS_KALMAN_Real_t y[GPS_KALMAN_FILTER_LEN];
+    GPS_KALMAN_Real_t Pv[GPS_KALMAN_FILTER_SYM_LEN];
+    GPS_KALMAN_Real_t Sv[GPS_KALMAN_FILTER_SYM_LEN];
+    GPS_KALMAN_Real_t Kv[GPS_KALMAN_FILTER_MAT_LEN];
+    GPS_KALMAN_Real_t L[GPS_KALMAN_FILTER_MAT_LEN];
+    GPS_KALMAN_Real_t dinv[GPS_KALMAN_FILTER_LEN];
+    GPS_KALMAN_Real_t col[GPS_KALMAN_FILTER_LEN];
+    GPS_KALMAN_Real_t w[GPS_KALMAN_FILTER_LEN];
+    GPS_KALMAN_Acc_t  m;
+    GPS_KALMAN_Real_t mv;
+    GPS_KALMAN_Real_t A[GPS_KALMAN_FILTER_MAT_LEN];
+    GPS_KALMAN_Real_t T[GPS_KALMAN_FILTER_MAT_LEN];
+    GPS_KALMAN_Real_t KR[GPS_KALMAN_FILTER_MAT_LEN];
+    GPS_KALMAN_Real_t xn[GPS_KALMAN_FILTER_LEN];
+    GPS_KALMAN_Real_t Pn[GPS_KALMAN_FILTER_SYM_LEN];
+    int    pd = 1;
+    int    pass;
+    int    i;
+    int    j;
+    int    k;
+
+    GPS_KALMAN_KERNEL_UNROLL
+    for (i = 0; i < GPS_KALMAN_KN; i++)
+    {
+        xv[i] = x[i * st];
+        rv[i] = r[i * st];
+        y[i]  = GPS_KALMAN_RSAT((GPS_KALMAN_Acc_t) z[i * st] - xv[i]);
+    }
+    GPS_KALMAN_KERNEL_UNROLL
+    for (i = 0; i < GPS_KALMAN_FILTER_SYM_LEN; i++)
+    {
+        Pv[i] = P[i * st];
+        Sv[i] = Pv[i];
+    }
+
+    /* S = P + diag(r) */
+    GPS_KALMAN_KERNEL_UNROLL
+    for (i = 0; i < GPS_KALMAN_KN; i++)
+    {
+        Sv[GPS_KALMAN_SYM_IDX(i, i)] =
+            GPS_KALMAN_RSAT((GPS_KALMAN_Acc_t) Sv[GPS_KALMAN_SYM_IDX(i, i)] + rv[i]);
+    }
+
+    /* S = L * L'. A non-positive pivot is replaced by 1 so the arithmetic below stays
+    ** finite; pd records that the result must not be used. Only the reciprocals of
+    ** the diagonal are kept, so the solves only multiply. */
+    GPS_KALMAN_KERNEL_UNROLL
+    for (j = 0; j < GPS_KALMAN_KN; j++)
+    {
+        GPS_KALMAN_Acc_t d = GPS_KALMAN_KS(Sv, j, j);
+        GPS_KALMAN_KERNEL_UNROLL
+        for (k = 0; k < j; k++)
+        {
+            d -= GPS_KALMAN_RMUL(GPS_KALMAN_KM(L, j, k), GPS_KALMAN_KM(L, j, k));
+        }
+        pd = pd & (d > GPS_KALMAN_R_ZERO);
+        dinv[j] = GPS_KALMAN_RRSQRT((d > GPS_KALMAN_R_ZERO) ? GPS_KALMAN_RSAT(d)
+                                                            : GPS_KALMAN_R_ONE);
+
+        GPS_KALMAN_KERNEL_UNROLL
+        for (i = j + 1; i < GPS_KALMAN_KN; i++)
+        {
+            GPS_KALMAN_Acc_t s = GPS_KALMAN_KS(Sv, i, j);
+            GPS_KALMAN_KERNEL_UNROLL
+            for (k = 0; k < j; k++)
+            {
+                s -= GPS_KALMAN_RMUL(GPS_KALMAN_KM(L, i, k), GPS_KALMAN_KM(L, j, k));
+            }
+            GPS_KALMAN_KM(L, i, j) =
+                GPS_KALMAN_RSAT(GPS_KALMAN_RMUL(GPS_KALMAN_RSAT(s), dinv[j]));
+        }
+    }
+
+    /* d2 = |w|^2, L * w = y */
+    GPS_KALMAN_Kernel_CholForward(L, dinv, y, w);
+    m = GPS_KALMAN_RMUL(w[0], w[0]);
+    GPS_KALMAN_KERNEL_UNROLL
+    for (i = 1; i < GPS_KALMAN_KN; i++)
+    {
+        m += GPS_KALMAN_RMUL(w[i], w[i]);
+    }
+    mv = GPS_KALMAN_RSAT(m);
+    pass = (gate <= GPS_KALMAN_R_ZERO) | (mv <= gate);
+
+    /* K(j, :) = S^-1 * P(:, j) */
+    GPS_KALMAN_KERNEL_UNROLL
+    for (j = 0; j < GPS_KALMAN_KN; j++)
+    {
+        GPS_KALMAN_KERNEL_UNROLL
+        for (i = 0; i < GPS_KALMAN_KN; i++)
+        {
+            col[i] = GPS_KALMAN_KS(Pv, i, j);
+        }
+        GPS_KALMAN_Kernel_CholSolve(L, dinv, col, &Kv[j * GPS_KALMAN_KN]);
+    }
+
+    /* x = x + K * (z - x), A = I - K, KR = K * diag(r) */
+    GPS_KALMAN_KERNEL_UNROLL
+    for (i = 0; i < GPS_KALMAN_KN; i++)
+    {
+        GPS_KALMAN_Acc_t s = GPS_KALMAN_RMUL(GPS_KALMAN_KM(Kv, i, 0), y[0]);
+        GPS_KALMAN_KERNEL_UNROLL
+        for (k = 1; k < GPS_KALMAN_KN; k++)
+        {
+            s += GPS_KALMAN_RMUL(GPS_KALMAN_KM(Kv, i, k), y[k]);
+        }
+        xn[i] = GPS_KALMAN_RSAT(xv[i] + s);
+
+        GPS_KALMAN_KERNEL_UNROLL
+        for (j = 0; j < GPS_KALMAN_KN; j++)
+        {
+            GPS_KALMAN_KM(A, i, j)  = ((i == j) ? GPS_KALMAN_R_ONE : GPS_KALMAN_R_ZERO) -
+                                      GPS_KALMAN_KM(Kv, i, j);
+            GPS_KALMAN_KM(KR, i, j) =
+                GPS_KALMAN_RSAT(GPS_KALMAN_RMUL(GPS_KALMAN_KM(Kv, i, j), rv[j]));
+        }
+    }
+
+    /* T = A * P */
+    GPS_KALMAN_KERNEL_UNROLL
+    for (i = 0; i < GPS_KALMAN_KN; i++)
+    {
+        GPS_KALMAN_KERNEL_UNROLL
+        for (j = 0; j < GPS_KALMAN_KN; j++)
+        {
+            GPS_KALMAN_Acc_t s =
+                GPS_KALMAN_RMUL(GPS_KALMAN_KM(A, i, 0), GPS_KALMAN_KS(Pv, 0, j));
+            GPS_KALMAN_KERNEL_UNROLL
+            for (k = 1; k < GPS_KALMAN_KN; k++)
+            {
+                s += GPS_KALMAN_RMUL(GPS_KALMAN_KM(A, i, k), GPS_KALMAN_KS(Pv, k, j));
+            }
+            GPS_KALMAN_KM(T, i, j) = GPS_KALMAN_RSAT(s);
+        }
+    }
+
+    /* P = T * A' + KR * K' */
+    GPS_KALMAN_KERNEL_UNROLL
+    for (i = 0; i < GPS_KALMAN_KN; i++)
+    {
+        GPS_KALMAN_KERNEL_UNROLL
+        for (j = i; j < GPS_KALMAN_KN; j++)
+        {
+            GPS_KALMAN_Acc_t s =
+                GPS_KALMAN_RMUL(GPS_KALMAN_KM(T, i, 0), GPS_KALMAN_KM(A, j, 0));
+            GPS_KALMAN_Acc_t u =
+                GPS_KALMAN_RMUL(GPS_KALMAN_KM(KR, i, 0), GPS_KALMAN_KM(Kv, j, 0));
+            GPS_KALMAN_KERNEL_UNROLL
+            for (k = 1; k < GPS_KALMAN_KN; k++)
+            {
+                s += GPS_KALMAN_RMUL(GPS_KALMAN_KM(T, i, k), GPS_KALMAN_KM(A, j, k));
+                u += GPS_KALMAN_RMUL(GPS_KALMAN_KM(KR, i, k), GPS_KALMAN_KM(Kv, j, k));
+            }
+            Pn[GPS_KALMAN_SYM_IDX(i, j)] = GPS_KALMAN_RSAT(s + u);
+        }
+    }
+
+    /* Outputs. x and P are selected rather than branched on. */
+    apply = apply & pd & pass;
+
+    GPS_KALMAN_KERNEL_UNROLL
+    for (i = 0; i < GPS_KALMAN_KN; i++)
+    {
+        x[i * st] = apply ? xn[i] : xv[i];
+    }
+    GPS_KALMAN_KERNEL_UNROLL
+    for (i = 0; i < GPS_KALMAN_FILTER_SYM_LEN; i++)
+    {
+        S[i * st] = Sv[i];
+        P[i * st] = apply ? Pn[i] : Pv[i];
+    }
+    GPS_KALMAN_KERNEL_UNROLL
+    for (i = 0; i < GPS_KALMAN_FILTER_MAT_LEN; i++)
+    {
+        K[i * st] = Kv[i];
+    }
+    d2[0] = mv;
+
+    return pd ? (pass ? GPS_KALMAN_FILTER_SUCCESS : GPS_KALMAN_FILTER_ERR_GATED)
+              : GPS_KALMAN_FILTER_ERR_NOT_PD;
+}
+
+#else /* GPS_KALMAN_UPDATE_FORM_SEQUENTIAL */
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Kernel_Update
+**
+** Purpose: To apply one measurement update to one filter, one component at a time
+**
+** Arguments:
+**    const GPS_KALMAN_Real_t z[] - measurement, strided
+**    const GPS_KALMAN_Real_t r[] - measurement noise variances, strided
+**    GPS_KALMAN_Real_t x[]       - state, strided, updated in place
+**    GPS_KALMAN_Real_t P[]       - covariance, packed, strided, updated in place
+**    GPS_KALMAN_Real_t S[]       - innovation covariance, packed, strided (output)
+**    GPS_KALMAN_Real_t K[]       - gain, strided (output)
+**    GPS_KALMAN_Real_t d2[]      - squared Mahalanobis distance of the innovation,
+**                                  strided (output)
+**    size_t st                   - stride between elements of all the arrays above
+**    GPS_KALMAN_Real_t gate      - largest d2 accepted, shared; <= 0 accepts all
+**    int apply                   - when zero, S, K and d2 are still formed but x and
+**                                  P are kept
+**
+** Returns:
+**    GPS_KALMAN_FILTER_SUCCESS
+**    GPS_KALMAN_FILTER_ERR_NOT_PD if S is not positive definite; x and P are kept
+**    GPS_KALMAN_FILTER_ERR_GATED if d2 is over the gate; x and P are kept
+**
+** Algorithm:
+**    With H = I and a diagonal measurement noise, the components of z are independent
+**    measurements of one state each, and applying them one after the other gives the
+**    same x and P as the joint update. Component i, against the x and P left by the
+**    components before it, is a scalar update:
+**        c = P(:, i),  s = c(i) + r(i),  v = z(i) - x(i)
+**        k = c / s
+**        x = x + k * v
+**        P = P - k * c' - c * k' + s * k * k'   (Joseph form, = (I - k e_i') P (..)' + r k k')
+**    so the only inverse is 1 / s. The s are the pivots of an LDL' factorisation of
+**    the joint innovation covariance, so all are positive exactly when it is positive
+**    definite, and
+**        d2 = sum of v^2 / s
+**    is the same squared Mahalanobis distance the joint update tests.
+**    S is P + diag(r) from the P before the update, as for the joint update, and K is
+**    the equivalent joint gain, P * diag(r)^-1 from the P after it.
+**=====================================================================================*/
+GPS_KALMAN_KERNEL_INLINE
+int GPS_KALMAN_Kernel_Update(const GPS_KALMAN_Real_t * restrict z,
+                             const GPS_KALMAN_Real_t * restrict r,
+                             GPS_KALMAN_Real_t * restrict x,
+                             GPS_KALMAN_Real_t * restrict P,
+                             GPS_KALMAN_Real_t * restrict S,
+                             GPS_KALMAN_Real_t * restrict K,
+                             GPS_KALMAN_Real_t * restrict d2,
+                             size_t st, GPS_KALMAN_Real_t gate, int apply)
+{
+    GPS_KALMAN_Real_t xv[GPS_KALMAN_FILTER_LEN];
+    GPS_KALMAN_Real_t rv[GPS_KALMAN_FILTER_LEN];
+    GPS_KALMAN_Real_t Pv[GPS_KALMAN_FILTER_SYM_LEN];
+    GPS_KALMAN_Real_t xn[GPS_KALMAN_FILTER_LEN];
+    GPS_KALMAN_Real_t Pn[GPS_KALMAN_FILTER_SYM_LEN];
+    GPS_KALMAN_Real_t c[GPS_KALMAN_FILTER_LEN];
+    GPS_KALMAN_Real_t k[GPS_KALMAN_FILTER_LEN];
+    GPS_KALMAN_Real_t sk[GPS_KALMAN_FILTER_LEN];
+    GPS_KALMAN_Real_t rinv;
+    GPS_KALMAN_Real_t sv;
+    GPS_KALMAN_Real_t sinv;
+    GPS_KALMAN_Real_t v;
+    GPS_KALMAN_Acc_t  m = GPS_KALMAN_R_ZERO;
+    GPS_KALMAN_Real_t mv;
+    int    pd = 1;
+    int    pass;
+    int    i;
+    int    j;
+    int    a;
+
+    GPS_KALMAN_KERNEL_UNROLL
+    for (i = 0; i < GPS_KALMAN_KN; i++)
+    {
+        xv[i] = x[i * st];
+        rv[i] = r[i * st];
+        xn[i] = xv[i];
+    }
+    GPS_KALMAN_KERNEL_UNROLL
+    for (i = 0; i < GPS_KALMAN_FILTER_SYM_LEN; i++)
+    {
+        Pv[i] = P[i * st];
+        Pn[i] = Pv[i];
+    }
+
+    GPS_KALMAN_KERNEL_UNROLL
+    for (i = 0; i < GPS_KALMAN_KN; i++)
+    {
+        GPS_KALMAN_Acc_t s;
+
+        GPS_KALMAN_KERNEL_UNROLL
+        for (a = 0; a < GPS_KALMAN_KN; a++)
+        {
+            c[a] = GPS_KALMAN_KS(Pn, a, i);
+        }
+
+        /* A non-positive s is replaced by 1 so the arithmetic below stays finite; pd
+        ** records that the result must not be used */
+        s  = (GPS_KALMAN_Acc_t) c[i] + rv[i];
+        pd = pd & (s > GPS_KALMAN_R_ZERO);
+        sv = (s > GPS_KALMAN_R_ZERO) ? GPS_KALMAN_RSAT(s) : GPS_KALMAN_R_ONE;
+        sinv = GPS_KALMAN_RRECIP(sv);
+
+        v  = GPS_KALMAN_RSAT((GPS_KALMAN_Acc_t) z[i * st] - xn[i]);
+        m += GPS_KALMAN_RMUL(GPS_KALMAN_RSAT(GPS_KALMAN_RMUL(v, v)), sinv);
+
+        GPS_KALMAN_KERNEL_UNROLL
+        for (a = 0; a < GPS_KALMAN_KN; a++)
+        {
+            k[a]  = GPS_KALMAN_RSAT(GPS_KALMAN_RMUL(c[a], sinv));
+            sk[a] = GPS_KALMAN_RSAT(GPS_KALMAN_RMUL(sv, k[a]));
+            xn[a] = GPS_KALMAN_RSAT(xn[a] + GPS_KALMAN_RMUL(k[a], v));
+        }
+
+        GPS_KALMAN_KERNEL_UNROLL
+        for (a = 0; a < GPS_KALMAN_KN; a++)
+        {
+            GPS_KALMAN_KERNEL_UNROLL
+            for (j = a; j < GPS_KALMAN_KN; j++)
+            {
+                Pn[GPS_KALMAN_SYM_IDX(a, j)] = GPS_KALMAN_RSAT(
+                        (GPS_KALMAN_Acc_t) Pn[GPS_KALMAN_SYM_IDX(a, j)] -
+                        GPS_KALMAN_RMUL(k[a], c[j]) - GPS_KALMAN_RMUL(c[a], k[j]) +
+                        GPS_KALMAN_RMUL(sk[a], k[j]));
+            }
+        }
+    }
+    mv = GPS_KALMAN_RSAT(m);
+    pass = (gate <= GPS_KALMAN_R_ZERO) | (mv <= gate);
+
+    /* Outputs. x and P are selected rather than branched on. */
+    apply = apply & pd & pass;
+
+    GPS_KALMAN_KERNEL_UNROLL
+    for (i = 0; i < GPS_KALMAN_KN; i++)
+    {
+        x[i * st] = apply ? xn[i] : xv[i];
+    }
+    GPS_KALMAN_KERNEL_UNROLL
+    for (i = 0; i < GPS_KALMAN_FILTER_SYM_LEN; i++)
+    {
+        P[i * st] = apply ? Pn[i] : Pv[i];
+        S[i * st] = Pv[i];
+    }
+    GPS_KALMAN_KERNEL_UNROLL
+    for (i = 0; i < GPS_KALMAN_KN; i++)
+    {
+        S[GPS_KALMAN_SYM_IDX(i, i) * st] =
+            GPS_KALMAN_RSAT((GPS_KALMAN_Acc_t) Pv[GPS_KALMAN_SYM_IDX(i, i)] + rv[i]);
+    }
+    GPS_KALMAN_KERNEL_UNROLL
+    for (j = 0; j < GPS_KALMAN_KN; j++)
+    {
+        rinv = GPS_KALMAN_RRECIP((rv[j] > GPS_KALMAN_R_ZERO) ? rv[j] : GPS_KALMAN_R_ONE);
+        GPS_KALMAN_KERNEL_UNROLL
+        for (i = 0; i < GPS_KALMAN_KN; i++)
+        {
+            K[(i * GPS_KALMAN_KN + j) * st] =
+                GPS_KALMAN_RSAT(GPS_KALMAN_RMUL(GPS_KALMAN_KS(Pn, i, j), rinv));
+        }
+    }
+    d2[0] = mv;
+
+    return pd ? (pass ? GPS_KALMAN_FILTER_SUCCESS : GPS_KALMAN_FILTER_ERR_GATED)
+              : GPS_KALMAN_FILTER_ERR_NOT_PD;
+}
+
+#endif /* GPS_KALMAN_UPDATE_FORM */
+
+#endif /* _GPS_KALMAN_FILTER_KERNEL_H_ */
+
+/*=======================================================================================
+** End of file gps_kalman_filter_kernel.h
+**=====================================================================================*/
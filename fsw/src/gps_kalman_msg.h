@@ -14,6 +14,12 @@
 **   ---------------------------
 **   2019-06-28 | Jacob Killelea | Build #: Code Started
 **   2019-09-02 | Jacob Killelea | Build #: Move GPS_KALMAN_OutData_t to this file
+**   2026-10-17 | GPS_KALMAN Team | Fix counters per receiver
+**   2026-10-17 | GPS_KALMAN Team | Smoothed output data
+**   2026-10-17 | GPS_KALMAN Team | Filtered heading and yaw rate
+**   2026-10-17 | GPS_KALMAN Team | Steady-state gain counter
+**   2026-10-17 | GPS_KALMAN Team | Output quality and position error
+**   2026-10-17 | GPS_KALMAN Team | Output data length checked at build time
 **
 **=====================================================================================*/
     
@@ -29,6 +35,8 @@
 */
 #include "cfe.h"
 #include "common_types.h"
+#include "gps_kalman_platform_cfg.h"
+#include "gps_kalman_filter.h"
 
 
 /*
@@ -40,31 +48,119 @@
 */
 #define GPS_KALMAN_NOOP_CC                 0
 #define GPS_KALMAN_RESET_CC                1
+#define GPS_KALMAN_SET_DIAG_CC             2
+#define GPS_KALMAN_RESET_STATS_CC          3
+
+/*
+** Diagnostic mode flags, see GPS_KALMAN_SetDiagCmd_t
+*/
+#define GPS_KALMAN_DIAG_OFF                0x00
+#define GPS_KALMAN_DIAG_TLM                0x01 /* send GPS_KALMAN_DiagTlm_t every cycle */
+#define GPS_KALMAN_DIAG_SUMMARY            0x02 /* summary event every N cycles */
+
+/*
+** Timed stages of the GPS_KALMAN cycle, indexes of GPS_KALMAN_HkTlm_t.Stage
+*/
+#define GPS_KALMAN_STAGE_CMDS              0 /* GPS_KALMAN_ProcessNewCmds */
+#define GPS_KALMAN_STAGE_DATA              1 /* GPS_KALMAN_ProcessNewData, with any filter runs */
+#define GPS_KALMAN_STAGE_PREDICT           2 /* filter predict */
+#define GPS_KALMAN_STAGE_UPDATE            3 /* filter update */
+#define GPS_KALMAN_STAGE_SEND_OUT          4 /* GPS_KALMAN_SendOutData */
+#define GPS_KALMAN_STAGE_CNT               5
 
 /*
 ** Local Structure Declarations
 */
+
+/* Execution time of one stage since the last GPS_KALMAN_RESET_STATS_CC */
+typedef struct
+{
+    uint32  uiCount;  /* times the stage ran */
+    uint32  uiMinNs;  /* shortest, ns */
+    uint32  uiMaxNs;  /* longest, ns */
+    uint32  uiMeanNs; /* mean, ns */
+    uint32  uiP99Ns;  /* 99th percentile, ns, to within 19% */
+} GPS_KALMAN_StageTlm_t;
 typedef struct OS_ALIGN(4)
 {
     uint8  TlmHeader[CFE_SB_TLM_HDR_SIZE];
     uint8  usCmdCnt;
     uint8  usCmdErrCnt;
+    uint8  ucSpare[2];
+
+    GPS_KALMAN_StageTlm_t  Stage[GPS_KALMAN_STAGE_CNT];
+
+    uint32  uiGateRejectCnt;  /* fixes rejected by the innovation gate */
+    uint32  uiGateRestartCnt; /* filter restarts after too many rejections in a row */
+    uint32  uiSteadyCnt;      /* updates with the frozen steady-state gain */
+    uint32  uiGainCacheHitCnt;  /* DOP changes while steady with the gain cached */
+    uint32  uiGainCacheMissCnt; /* and without, so the full filter resumed */
+
+    /* Per receiver, in GPS_KALMAN_SOURCE_MIDS order */
+    uint32  uiSourceFixCnt[GPS_KALMAN_SOURCE_MAX];  /* messages with a good fix */
+    uint32  uiSourceBadCnt[GPS_KALMAN_SOURCE_MAX];  /* messages without one */
+    uint32  uiSourceUsedCnt[GPS_KALMAN_SOURCE_MAX]; /* fixes that updated or restarted the
+                                                    ** filter; the rest were stale or gated */
 
     /* TODO:  Add declarations for additional housekeeping data here */
 
 } GPS_KALMAN_HkTlm_t;
 
-/* Filter output data */
+/* Filter output data; GPS_KALMAN_OUT_DATA_LEN bytes after the header, see
+** gps_kalman_msgids.h */
 typedef struct
 {
     uint8   ucTlmHeader[CFE_SB_TLM_HDR_SIZE];
     uint32  uiCounter;
+    uint8   ucQuality; /* GPS_KALMAN_QUALITY_*: only _FIX and _COAST are valid */
+    uint8   ucSpare[3];
     double  filterLat; /* Kalman Filter Lattidue */
     double  filterLon; /* Kalman Filter Longitude */
-    double  filterVel; /* Kalman Filter Velocity */
-    double  filterHdg; /* Kalman Filter Heading (true) TODO: actually filter? */
+    double  filterVel; /* Kalman Filter Velocity (kph) */
+    double  filterHdg; /* Kalman Filter Heading (true), held while stopped */
+    double  filterYawRate; /* Kalman Filter yaw rate, deg/s, + clockwise; 0 until the
+                           ** first fix fast enough for a heading */
+    double  filterSigmaN;  /* 1-sigma position error north, m, grown while coasting */
+    double  filterSigmaE;  /* 1-sigma position error east, m */
 } GPS_KALMAN_OutData_t;
 
+/* Fixed-lag smoothed output data, GPS_KALMAN_SMOOTH_LAG fixes behind the filter */
+typedef struct
+{
+    uint8   ucTlmHeader[CFE_SB_TLM_HDR_SIZE];
+    uint32  uiCounter;
+    uint8   ucSpare[4];
+    double  smoothTime;   /* time of the fix the estimate is for, s, as CFE_TIME seconds */
+    double  smoothLat;    /* latitude, degrees */
+    double  smoothLon;    /* longitude, degrees */
+    double  smoothVel;    /* speed, kph */
+    double  smoothHdg;    /* heading, degrees true */
+    double  smoothSigmaN; /* 1-sigma position error north, m */
+    double  smoothSigmaE; /* 1-sigma position error east, m */
+} GPS_KALMAN_SmoothData_t;
+
+/* Filter diagnostic data, sent every cycle in GPS_KALMAN_DIAG_TLM mode */
+typedef struct
+{
+    uint8   ucTlmHeader[CFE_SB_TLM_HDR_SIZE];
+    uint32  uiCounter;       /* wakeup cycle */
+    uint8   ucFixOk;         /* the last fix was good */
+    uint8   ucFilterInit;    /* the last fix restarted the filter */
+    int16   sFilterStatus;   /* GPS_KALMAN_FILTER_* status of the last update */
+    uint8   ucSource;        /* receiver of the last fix */
+    uint8   ucSpare[3];
+    double  inLat;           /* last fix: latitude */
+    double  inLon;           /* last fix: longitude */
+    double  inVel;           /* last fix: speed, kph */
+    double  inHdg;           /* last fix: heading */
+    double  inDOP;           /* last fix: HDOP */
+    double  dt;              /* time step of the last update, s */
+    double  innovation[GPS_KALMAN_FILTER_LEN];    /* z - x of the last update */
+    double  innovationVar[GPS_KALMAN_FILTER_LEN]; /* diagonal of S of the last update */
+    double  innovationD2;    /* innovation' * S^-1 * innovation, against the gate */
+    double  stateVar[GPS_KALMAN_FILTER_LEN];      /* diagonal of P */
+} GPS_KALMAN_DiagTlm_t;
+
 #endif /* _GPS_KALMAN_MSG_H_ */
 
 /*=======================================================================================
@@ -28,6 +28,7 @@
 ** Include Files
 */
 #include "cfe.h"
+#include "gps_kalman_core.h"
 
 /*
 ** Local Defines
@@ -42,6 +43,14 @@ typedef struct
     uint8  ucCmdHeader[CFE_SB_CMD_HDR_SIZE];
 } GPS_KALMAN_NoArgCmd_t;
 
+typedef struct
+{
+    uint8   ucCmdHeader[CFE_SB_CMD_HDR_SIZE];
+    uint8   ucDiagMode;       /* GPS_KALMAN_DIAG_* flags */
+    uint8   ucSpare;
+    uint16  usSummaryPeriod;  /* cycles between summary events, 0 keeps the current */
+} GPS_KALMAN_SetDiagCmd_t;
+
 
 typedef struct
 {
@@ -50,15 +59,13 @@ typedef struct
     /* TODO:  Add input data to this application here, such as raw data read from I/O
     **        devices or data subscribed from other apps' output data.
     */
+    boolean gpsNew;   /* a GpsInfoMsg_t arrived since the filter last ran on it */
     boolean gpsFixOk; /* is the data any good? */
-    double  gpsLat;   /* GPS Lattidue */
-    double  gpsLon;   /* GPS Longitude */
-    double  gpsVel;   /* GPS Velocity */
-    double  gpsHdg;   /* GPS Heading */
-    double  gpsDOP;   /* GPS Position Dilution of Position */
+    GPS_KALMAN_Fix_t gpsFix; /* the last GpsInfoMsg_t, decoded once, as the filter reads it */
 } GPS_KALMAN_InData_t;
 
-/* NOTE:  Moved GPS_KALMAN_OutData_t to mission_inc/gps_kalman_msg.h. */
+/* NOTE:  Moved GPS_KALMAN_OutData_t to mission_inc/gps_kalman_msg.h. It is built in
+**        place in a zero copy SB buffer, see GPS_KALMAN_SendOutData. */
 
 /* TODO:  Add more private structure definitions here, if necessary. */
 
@@ -0,0 +1,456 @@
+/*=======================================================================================
+** File Name:  gps_kalman_smooth.c
+**
+** Title:  Fixed-lag smoother for GPS_KALMAN Application
+**
+** $Author:    GPS_KALMAN Team
+** $Revision: 1.1 $
+** $Date:      2026-10-17
+**
+** Purpose:  This file smooths the GPS_KALMAN filter estimates with a fixed-lag
+**           Rauch-Tung-Striebel pass over the last few fixes
+**
+** Functions Defined:
+**    Function GPS_KALMAN_Smooth_Init: empty the smoother and set its lag
+**    Function GPS_KALMAN_Smooth_Reset: forget every fix
+**    Function GPS_KALMAN_Smooth_Predicted: record a fix's prediction
+**    Function GPS_KALMAN_Smooth_Filtered: record a fix's update and smooth
+**    Function GPS_KALMAN_Smooth_Estimate: smoothed state to latitude, longitude etc.
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. No cFE, OSAL or GSL dependency, and no allocation
+**    2. The arithmetic is double whatever GPS_KALMAN_PRECISION is
+**    3. Cost per fix is one 4x4 Cholesky solve for the new gain plus lag backward
+**       steps of a few 4x4 products each
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**   2026-10-17 | GPS_KALMAN Team | Build #: Code Started
+**
+**=====================================================================================*/
+
+#include <math.h>
+#include <string.h>
+
+#include "gps_kalman_smooth.h"
+
+#define GPS_KALMAN_SN GPS_KALMAN_FILTER_LEN
+
+/* Row-major and packed symmetric element access, any (i, j) */
+#define GPS_KALMAN_SM(A, i, j) ((A)[(i) * GPS_KALMAN_SN + (j)])
+#define GPS_KALMAN_SS(A, i, j) \
+    ((A)[((i) <= (j)) ? GPS_KALMAN_SYM_IDX(i, j) : GPS_KALMAN_SYM_IDX(j, i)])
+
+/* Entry of the fix age fixes before the newest */
+#define GPS_KALMAN_SMOOTH_AT(sm, age) \
+    (&(sm)->entry[((sm)->head + GPS_KALMAN_SMOOTH_LEN - (age)) % GPS_KALMAN_SMOOTH_LEN])
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Smooth_Gain
+**
+** Purpose: To work out the smoother gain from one fix to the next
+**
+** Arguments:
+**    const double PFilt[]  - covariance after the first fix's update, packed
+**    const double F[]      - state transition to the next fix
+**    const double PPred[]  - covariance predicted to the next fix, packed
+**    double C[]            - gain (output)
+**
+** Returns:
+**    None
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. If PPred is not positive definite the gain is 0: the first fix is then left
+**       at its filtered estimate, and the fixes before it get nothing from the later
+**       ones
+**
+** Algorithm:
+**    C = PFilt * F' * PPred^-1. PPred is symmetric, so row i of C is the solution of
+**    PPred * c = (F * PFilt)(:, i), by Cholesky factor.
+**=====================================================================================*/
+static void GPS_KALMAN_Smooth_Gain(const double PFilt[GPS_KALMAN_FILTER_SYM_LEN],
+                                   const double F[GPS_KALMAN_FILTER_MAT_LEN],
+                                   const double PPred[GPS_KALMAN_FILTER_SYM_LEN],
+                                   double C[GPS_KALMAN_FILTER_MAT_LEN])
+{
+    double L[GPS_KALMAN_FILTER_MAT_LEN];
+    double dinv[GPS_KALMAN_FILTER_LEN];
+    double B[GPS_KALMAN_FILTER_MAT_LEN];
+    double y[GPS_KALMAN_FILTER_LEN];
+    double s;
+    int    i;
+    int    j;
+    int    k;
+
+    /* PPred = L * L' */
+    for (j = 0; j < GPS_KALMAN_SN; j++)
+    {
+        s = GPS_KALMAN_SS(PPred, j, j);
+        for (k = 0; k < j; k++)
+        {
+            s -= GPS_KALMAN_SM(L, j, k) * GPS_KALMAN_SM(L, j, k);
+        }
+        if (!(s > 0.0))
+        {
+            memset((void*) C, 0x00, sizeof(double) * GPS_KALMAN_FILTER_MAT_LEN);
+            return;
+        }
+        dinv[j] = 1.0 / sqrt(s);
+        for (i = j + 1; i < GPS_KALMAN_SN; i++)
+        {
+            s = GPS_KALMAN_SS(PPred, i, j);
+            for (k = 0; k < j; k++)
+            {
+                s -= GPS_KALMAN_SM(L, i, k) * GPS_KALMAN_SM(L, j, k);
+            }
+            GPS_KALMAN_SM(L, i, j) = s * dinv[j];
+        }
+    }
+
+    /* B = F * PFilt */
+    for (i = 0; i < GPS_KALMAN_SN; i++)
+    {
+        for (j = 0; j < GPS_KALMAN_SN; j++)
+        {
+            s = 0.0;
+            for (k = 0; k < GPS_KALMAN_SN; k++)
+            {
+                s += GPS_KALMAN_SM(F, i, k) * GPS_KALMAN_SS(PFilt, k, j);
+            }
+            GPS_KALMAN_SM(B, i, j) = s;
+        }
+    }
+
+    /* C(i, :) = PPred^-1 * B(:, i) */
+    for (i = 0; i < GPS_KALMAN_SN; i++)
+    {
+        for (j = 0; j < GPS_KALMAN_SN; j++)
+        {
+            s = GPS_KALMAN_SM(B, j, i);
+            for (k = 0; k < j; k++)
+            {
+                s -= GPS_KALMAN_SM(L, j, k) * y[k];
+            }
+            y[j] = s * dinv[j];
+        }
+        for (j = GPS_KALMAN_SN - 1; j >= 0; j--)
+        {
+            s = y[j];
+            for (k = j + 1; k < GPS_KALMAN_SN; k++)
+            {
+                s -= GPS_KALMAN_SM(L, k, j) * GPS_KALMAN_SM(C, i, k);
+            }
+            GPS_KALMAN_SM(C, i, j) = s * dinv[j];
+        }
+    }
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Smooth_Rebase
+**
+** Purpose: To move the recorded fixes into a new local frame
+**
+** Arguments:
+**    GPS_KALMAN_Smooth_t *sm               - smoother
+**    const GPS_KALMAN_EnuAnchor_t *anchor  - new frame
+**
+** Returns:
+**    None
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. Only positions move, through latitude and longitude, as the core carries its
+**       own state across; covariances are kept
+**=====================================================================================*/
+static void GPS_KALMAN_Smooth_Rebase(GPS_KALMAN_Smooth_t *sm,
+                                     const GPS_KALMAN_EnuAnchor_t *anchor)
+{
+    unsigned int i;
+    double lat;
+    double lon;
+
+    for (i = 0; i < sm->count; i++)
+    {
+        GPS_KALMAN_SmoothEntry_t *e = GPS_KALMAN_SMOOTH_AT(sm, i);
+
+        enu2geodetic_fast(&sm->anchor, e->xPred[GPS_KALMAN_STATE_E],
+                e->xPred[GPS_KALMAN_STATE_N], &lat, &lon);
+        geodetic2enu_fast(anchor, lat, lon,
+                &e->xPred[GPS_KALMAN_STATE_E], &e->xPred[GPS_KALMAN_STATE_N]);
+        enu2geodetic_fast(&sm->anchor, e->xFilt[GPS_KALMAN_STATE_E],
+                e->xFilt[GPS_KALMAN_STATE_N], &lat, &lon);
+        geodetic2enu_fast(anchor, lat, lon,
+                &e->xFilt[GPS_KALMAN_STATE_E], &e->xFilt[GPS_KALMAN_STATE_N]);
+    }
+    sm->anchor = *anchor;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Smooth_Init
+**
+** Purpose: To empty the smoother and set its lag
+**
+** Arguments:
+**    GPS_KALMAN_Smooth_t *sm  - smoother
+**    unsigned int lag         - fixes the smoothed estimate trails the filter by
+**
+** Returns:
+**    GPS_KALMAN_FILTER_SUCCESS, or -1 if lag is 0 or over GPS_KALMAN_SMOOTH_LAG
+**=====================================================================================*/
+int GPS_KALMAN_Smooth_Init(GPS_KALMAN_Smooth_t *sm, unsigned int lag)
+{
+    if ((lag == 0) || (lag > GPS_KALMAN_SMOOTH_LAG))
+    {
+        return -1;
+    }
+
+    memset((void*) sm, 0x00, sizeof(*sm));
+    sm->lag = lag;
+
+    return GPS_KALMAN_FILTER_SUCCESS;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Smooth_Reset
+**
+** Purpose: To forget every recorded fix
+**
+** Arguments:
+**    GPS_KALMAN_Smooth_t *sm  - smoother
+**
+** Returns:
+**    None
+**=====================================================================================*/
+void GPS_KALMAN_Smooth_Reset(GPS_KALMAN_Smooth_t *sm)
+{
+    sm->count = 0;
+    sm->open  = 0;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Smooth_Predicted
+**
+** Purpose: To record the prediction to a new fix
+**
+** Arguments:
+**    GPS_KALMAN_Smooth_t *sm          - smoother
+**    const GPS_KALMAN_Core_t *core    - core, just after GPS_KALMAN_Core_Predict
+**
+** Returns:
+**    None
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. The oldest fix drops out once the buffer is full
+**    2. A fix whose update never came is dropped too, so a prediction always follows
+**       the update of the fix before it
+**
+** Algorithm:
+**    The fix before this one now has everything its smoother gain needs: its own
+**    filtered covariance, and the core's F and predicted covariance to this one
+**=====================================================================================*/
+void GPS_KALMAN_Smooth_Predicted(GPS_KALMAN_Smooth_t *sm, const GPS_KALMAN_Core_t *core)
+{
+    const GPS_KALMAN_Data_t *data = &core->data;
+    GPS_KALMAN_SmoothEntry_t *prev;
+    GPS_KALMAN_SmoothEntry_t *e;
+    double F[GPS_KALMAN_FILTER_MAT_LEN];
+    int    i;
+
+    if (sm->open)
+    {
+        sm->head  = (sm->head + GPS_KALMAN_SMOOTH_LEN - 1) % GPS_KALMAN_SMOOTH_LEN;
+        sm->count--;
+        sm->open  = 0;
+    }
+
+    if (sm->count == 0)
+    {
+        sm->anchor = core->anchor;
+    }
+    else if ((sm->anchor.lat0 != core->anchor.lat0) ||
+             (sm->anchor.lon0 != core->anchor.lon0))
+    {
+        GPS_KALMAN_Smooth_Rebase(sm, &core->anchor);
+    }
+
+    prev = GPS_KALMAN_SMOOTH_AT(sm, 0);
+    sm->head = (sm->head + 1) % GPS_KALMAN_SMOOTH_LEN;
+    e = GPS_KALMAN_SMOOTH_AT(sm, 0);
+
+    e->time = core->lastFixTime;
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        e->xPred[i] = GPS_KALMAN_R2D(data->XHatData[i]);
+    }
+    for (i = 0; i < GPS_KALMAN_FILTER_SYM_LEN; i++)
+    {
+        e->PPred[i] = GPS_KALMAN_R2D(data->PMatrixData[i]);
+    }
+
+    if (sm->count > 0)
+    {
+        for (i = 0; i < GPS_KALMAN_FILTER_MAT_LEN; i++)
+        {
+            F[i] = GPS_KALMAN_R2D(data->FMatrixData[i]);
+        }
+        GPS_KALMAN_Smooth_Gain(prev->PFilt, F, e->PPred, prev->C);
+    }
+
+    if (sm->count < GPS_KALMAN_SMOOTH_LEN)
+    {
+        sm->count++;
+    }
+    sm->open = 1;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Smooth_Filtered
+**
+** Purpose: To record the update of the newest fix and smooth back over the lag
+**
+** Arguments:
+**    GPS_KALMAN_Smooth_t *sm          - smoother
+**    const GPS_KALMAN_Core_t *core    - core, just after GPS_KALMAN_Core_Update, or
+**                                       after GPS_KALMAN_Core_Prepare restarted it
+**
+** Returns:
+**    1 if outTime, outX and outP were set, else 0
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. With no prediction recorded, as after a restart, the fix starts a new buffer
+**    2. A gated or rejected update is recorded as it was: the filtered estimate is the
+**       prediction
+**
+** Algorithm:
+**    Rauch-Tung-Striebel, from the newest fix n, where the smoothed estimate is the
+**    filtered one, back to fix n - lag:
+**        x(k|n) = xFilt(k) + C(k) * (x(k+1|n) - xPred(k+1))
+**        P(k|n) = PFilt(k) + C(k) * (P(k+1|n) - PPred(k+1)) * C(k)'
+**=====================================================================================*/
+int GPS_KALMAN_Smooth_Filtered(GPS_KALMAN_Smooth_t *sm, const GPS_KALMAN_Core_t *core)
+{
+    const GPS_KALMAN_Data_t *data = &core->data;
+    const GPS_KALMAN_SmoothEntry_t *next;
+    const GPS_KALMAN_SmoothEntry_t *e;
+    double xs[GPS_KALMAN_FILTER_LEN];
+    double Ps[GPS_KALMAN_FILTER_SYM_LEN];
+    double d[GPS_KALMAN_FILTER_LEN];
+    double D[GPS_KALMAN_FILTER_SYM_LEN];
+    double T[GPS_KALMAN_FILTER_MAT_LEN];
+    double s;
+    unsigned int age;
+    GPS_KALMAN_SmoothEntry_t *newest;
+    int    i;
+    int    j;
+    int    k;
+
+    if (!sm->open)
+    {
+        GPS_KALMAN_Smooth_Reset(sm);
+        GPS_KALMAN_Smooth_Predicted(sm, core);
+    }
+    sm->open = 0;
+
+    newest = GPS_KALMAN_SMOOTH_AT(sm, 0);
+    for (i = 0; i < GPS_KALMAN_FILTER_LEN; i++)
+    {
+        newest->xFilt[i] = GPS_KALMAN_R2D(data->XHatData[i]);
+    }
+    for (i = 0; i < GPS_KALMAN_FILTER_SYM_LEN; i++)
+    {
+        newest->PFilt[i] = GPS_KALMAN_R2D(data->PMatrixData[i]);
+    }
+
+    if (sm->count <= sm->lag)
+    {
+        return 0;
+    }
+
+    memcpy((void*) xs, (const void*) newest->xFilt, sizeof(xs));
+    memcpy((void*) Ps, (const void*) newest->PFilt, sizeof(Ps));
+    next = newest;
+    for (age = 1; age <= sm->lag; age++)
+    {
+        e = GPS_KALMAN_SMOOTH_AT(sm, age);
+
+        for (i = 0; i < GPS_KALMAN_SN; i++)
+        {
+            d[i] = xs[i] - next->xPred[i];
+        }
+        for (i = 0; i < GPS_KALMAN_FILTER_SYM_LEN; i++)
+        {
+            D[i] = Ps[i] - next->PPred[i];
+        }
+
+        /* x = xFilt + C * d, T = C * D */
+        for (i = 0; i < GPS_KALMAN_SN; i++)
+        {
+            s = e->xFilt[i];
+            for (k = 0; k < GPS_KALMAN_SN; k++)
+            {
+                s += GPS_KALMAN_SM(e->C, i, k) * d[k];
+            }
+            xs[i] = s;
+
+            for (j = 0; j < GPS_KALMAN_SN; j++)
+            {
+                s = 0.0;
+                for (k = 0; k < GPS_KALMAN_SN; k++)
+                {
+                    s += GPS_KALMAN_SM(e->C, i, k) * GPS_KALMAN_SS(D, k, j);
+                }
+                GPS_KALMAN_SM(T, i, j) = s;
+            }
+        }
+
+        /* P = PFilt + T * C', upper triangle */
+        for (i = 0; i < GPS_KALMAN_SN; i++)
+        {
+            for (j = i; j < GPS_KALMAN_SN; j++)
+            {
+                s = e->PFilt[GPS_KALMAN_SYM_IDX(i, j)];
+                for (k = 0; k < GPS_KALMAN_SN; k++)
+                {
+                    s += GPS_KALMAN_SM(T, i, k) * GPS_KALMAN_SM(e->C, j, k);
+                }
+                Ps[GPS_KALMAN_SYM_IDX(i, j)] = s;
+            }
+        }
+
+        next = e;
+    }
+
+    sm->outTime = next->time;
+    memcpy((void*) sm->outX, (const void*) xs, sizeof(xs));
+    memcpy((void*) sm->outP, (const void*) Ps, sizeof(Ps));
+
+    return 1;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Smooth_Estimate
+**
+** Purpose: To express the smoothed state as latitude, longitude, speed and heading
+**
+** Arguments:
+**    const GPS_KALMAN_Smooth_t *sm  - smoother
+**    double *lat                    - latitude, degrees (output)
+**    double *lon                    - longitude, degrees (output)
+**    double *vel                    - ground speed, kph (output)
+**    double *hdg                    - heading, degrees true in [0, 360) (output)
+**
+** Returns:
+**    None
+**=====================================================================================*/
+void GPS_KALMAN_Smooth_Estimate(const GPS_KALMAN_Smooth_t *sm, double *lat, double *lon,
+                                double *vel, double *hdg)
+{
+    enu2geodetic_fast(&sm->anchor, sm->outX[GPS_KALMAN_STATE_E],
+            sm->outX[GPS_KALMAN_STATE_N], lat, lon);
+    north_east2speed_heading(sm->outX[GPS_KALMAN_STATE_VN],
+            sm->outX[GPS_KALMAN_STATE_VE], vel, hdg);
+}
+
+/*=======================================================================================
+** End of file gps_kalman_smooth.c
+**=====================================================================================*/
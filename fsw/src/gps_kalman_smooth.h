@@ -0,0 +1,84 @@
+/*=======================================================================================
+** File Name:  gps_kalman_smooth.h
+**
+** Title:  Header File for the GPS_KALMAN fixed-lag smoother
+**
+** $Author:    GPS_KALMAN Team
+** $Revision: 1.1 $
+** $Date:      2026-10-17
+**
+** Purpose:  To define a fixed-lag Rauch-Tung-Striebel smoother that runs beside one
+**           GPS_KALMAN_Core_t. It keeps the predicted and filtered state and
+**           covariance of the last few fixes in a ring buffer, and after every fix
+**           gives the estimate of the fix lag fixes back, smoothed with all the fixes
+**           since. For survey and post-flight products, where a late estimate is
+**           worth having if it is a better one.
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**   2026-10-17 | GPS_KALMAN Team | Build #: Code Started
+**
+**=====================================================================================*/
+
+#ifndef _GPS_KALMAN_SMOOTH_H_
+#define _GPS_KALMAN_SMOOTH_H_
+
+#include "gps_kalman_platform_cfg.h"
+#include "gps_kalman_core.h"
+
+/* Ring buffer entries: the fix being smoothed and the GPS_KALMAN_SMOOTH_LAG after it */
+#define GPS_KALMAN_SMOOTH_LEN  (GPS_KALMAN_SMOOTH_LAG + 1)
+
+/* One fix as the filter saw it. Always double, as GPS_KALMAN_Checkpoint_t. */
+typedef struct
+{
+    double time;                            /* time the state is at, s */
+    double xPred[GPS_KALMAN_FILTER_LEN];    /* predicted to this fix */
+    double PPred[GPS_KALMAN_FILTER_SYM_LEN];
+    double xFilt[GPS_KALMAN_FILTER_LEN];    /* after this fix's update */
+    double PFilt[GPS_KALMAN_FILTER_SYM_LEN];
+    double C[GPS_KALMAN_FILTER_MAT_LEN];    /* smoother gain to the next fix, row-major */
+} GPS_KALMAN_SmoothEntry_t;
+
+/* The smoother of one core. Statically sized; nothing is allocated. */
+typedef struct
+{
+    GPS_KALMAN_SmoothEntry_t entry[GPS_KALMAN_SMOOTH_LEN]; /* ring buffer */
+    unsigned int lag;     /* fixes the smoothed estimate trails the filter by */
+    unsigned int head;    /* entry of the newest fix */
+    unsigned int count;   /* entries in use, [0, lag + 1] */
+    int          open;    /* the newest entry has its prediction but not its update */
+    GPS_KALMAN_EnuAnchor_t anchor; /* local frame of the entries */
+
+    /* Smoothed estimate of the last GPS_KALMAN_Smooth_Filtered that returned 1 */
+    double outTime;
+    double outX[GPS_KALMAN_FILTER_LEN];
+    double outP[GPS_KALMAN_FILTER_SYM_LEN];
+} GPS_KALMAN_Smooth_t;
+
+/* Empty the smoother and set its lag, 1 to GPS_KALMAN_SMOOTH_LAG fixes. Returns
+** GPS_KALMAN_FILTER_SUCCESS, or -1 for a lag out of range. */
+int  GPS_KALMAN_Smooth_Init(GPS_KALMAN_Smooth_t *sm, unsigned int lag);
+
+/* Forget every fix, e.g. because the filter restarted; the lag is kept */
+void GPS_KALMAN_Smooth_Reset(GPS_KALMAN_Smooth_t *sm);
+
+/* Record the core's state after GPS_KALMAN_Core_Predict as the next fix's prediction */
+void GPS_KALMAN_Smooth_Predicted(GPS_KALMAN_Smooth_t *sm, const GPS_KALMAN_Core_t *core);
+
+/* Record the core's state after GPS_KALMAN_Core_Update, or after a restart, as the
+** newest fix's estimate. Returns 1 when outTime, outX and outP hold a new smoothed
+** estimate, lag fixes back, or 0 while fewer fixes than that have been seen. */
+int  GPS_KALMAN_Smooth_Filtered(GPS_KALMAN_Smooth_t *sm, const GPS_KALMAN_Core_t *core);
+
+/* The smoothed estimate as latitude/longitude (degrees), speed (kph) and heading
+** (degrees true), as GPS_KALMAN_Core_Estimate */
+void GPS_KALMAN_Smooth_Estimate(const GPS_KALMAN_Smooth_t *sm, double *lat, double *lon,
+                                double *vel, double *hdg);
+
+#endif /* _GPS_KALMAN_SMOOTH_H_ */
+
+/*=======================================================================================
+** End of file gps_kalman_smooth.h
+**=====================================================================================*/
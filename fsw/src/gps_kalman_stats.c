@@ -0,0 +1,216 @@
+/*=======================================================================================
+** File Name:  gps_kalman_stats.c
+**
+** Title:  Execution time statistics for GPS_KALMAN Application
+**
+** $Author:    GPS_KALMAN Team
+** $Revision: 1.1 $
+** $Date:      2026-10-17
+**
+** Purpose:  This file accumulates per-stage execution times for housekeeping
+**
+** Functions Defined:
+**    Function GPS_KALMAN_Stats_NowNs: read the local clock
+**    Function GPS_KALMAN_Stats_Reset: clear an accumulator
+**    Function GPS_KALMAN_Stats_Add: add one sample
+**    Function GPS_KALMAN_Stats_MeanNs: mean sample
+**    Function GPS_KALMAN_Stats_PercentileNs: percentile from the histogram
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. In the app the clock is the PSP local time, CFE_PSP_GetTime, which cFE TIME
+**       counts MET on and does not step; microsecond resolution. The host tools,
+**       built with GPS_KALMAN_HOST_TOOLS, read POSIX CLOCK_MONOTONIC instead.
+**    2. Adding a sample is constant time with no allocation, so it is safe to do
+**       on every cycle
+**    3. No cFE or OSAL dependency but the PSP clock, and none with GPS_KALMAN_HOST_TOOLS
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**   2026-10-17 | GPS_KALMAN Team | Build #: Code Started
+**   2026-10-17 | GPS_KALMAN Team | PSP clock in the app, POSIX only in host tools
+**
+**=====================================================================================*/
+
+#ifdef GPS_KALMAN_HOST_TOOLS
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 199309L
+#endif
+#endif
+
+#include <string.h>
+
+#ifdef GPS_KALMAN_HOST_TOOLS
+#include <time.h>
+#else
+#include "cfe_psp.h"
+#endif
+
+#include "gps_kalman_stats.h"
+
+/* Index of the most significant set bit of a nonzero value */
+static int GPS_KALMAN_Stats_Msb(uint32_t v)
+{
+    return 31 - __builtin_clz(v);
+}
+
+/* Histogram bin of a sample: the octave, then the next SUB_BITS bits below the
+** leading one. Values below 2^SUB_BITS get a bin each. */
+static uint32_t GPS_KALMAN_Stats_Bin(uint32_t ns)
+{
+    int b;
+
+    if (ns < (1u << GPS_KALMAN_STATS_SUB_BITS))
+    {
+        return ns;
+    }
+
+    b = GPS_KALMAN_Stats_Msb(ns) - GPS_KALMAN_STATS_SUB_BITS;
+    return ((uint32_t) (b + 1) << GPS_KALMAN_STATS_SUB_BITS) |
+           ((ns >> b) & ((1u << GPS_KALMAN_STATS_SUB_BITS) - 1));
+}
+
+/* Largest sample that falls in a bin */
+static uint64_t GPS_KALMAN_Stats_BinTop(uint32_t bin)
+{
+    int b;
+    uint64_t lower;
+
+    if (bin < (1u << GPS_KALMAN_STATS_SUB_BITS))
+    {
+        return bin;
+    }
+
+    b = (int) (bin >> GPS_KALMAN_STATS_SUB_BITS) - 1;
+    lower = (uint64_t) ((1u << GPS_KALMAN_STATS_SUB_BITS) |
+                        (bin & ((1u << GPS_KALMAN_STATS_SUB_BITS) - 1))) << b;
+    return lower + ((uint64_t) 1 << b) - 1;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Stats_NowNs
+**
+** Purpose: To read the local clock
+**
+** Arguments:
+**    None
+**
+** Returns:
+**    uint64_t - nanoseconds from an arbitrary origin; whole microseconds in the app
+**=====================================================================================*/
+uint64_t GPS_KALMAN_Stats_NowNs(void)
+{
+#ifdef GPS_KALMAN_HOST_TOOLS
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t) ts.tv_sec) * 1000000000u + (uint64_t) ts.tv_nsec;
+#else
+    OS_time_t LocalTime;
+
+    CFE_PSP_GetTime(&LocalTime);
+    return ((uint64_t) LocalTime.seconds) * 1000000000u +
+           ((uint64_t) LocalTime.microsecs) * 1000u;
+#endif
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Stats_Reset
+**
+** Purpose: To clear an accumulator
+**
+** Arguments:
+**    GPS_KALMAN_Stats_t *stats  - accumulator
+**
+** Returns:
+**    None
+**=====================================================================================*/
+void GPS_KALMAN_Stats_Reset(GPS_KALMAN_Stats_t *stats)
+{
+    memset((void*) stats, 0x00, sizeof(*stats));
+    stats->minNs = UINT32_MAX;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Stats_Add
+**
+** Purpose: To add one sample to an accumulator
+**
+** Arguments:
+**    GPS_KALMAN_Stats_t *stats  - accumulator
+**    uint64_t ns                - sample, nanoseconds
+**
+** Returns:
+**    None
+**=====================================================================================*/
+void GPS_KALMAN_Stats_Add(GPS_KALMAN_Stats_t *stats, uint64_t ns)
+{
+    uint32_t v = (ns > UINT32_MAX) ? UINT32_MAX : (uint32_t) ns;
+
+    stats->count++;
+    stats->sumNs += v;
+    stats->minNs  = (v < stats->minNs) ? v : stats->minNs;
+    stats->maxNs  = (v > stats->maxNs) ? v : stats->maxNs;
+    stats->hist[GPS_KALMAN_Stats_Bin(v)]++;
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Stats_MeanNs
+**
+** Purpose: To find the mean sample
+**
+** Arguments:
+**    const GPS_KALMAN_Stats_t *stats  - accumulator
+**
+** Returns:
+**    uint32_t - mean, nanoseconds, 0 with no samples
+**=====================================================================================*/
+uint32_t GPS_KALMAN_Stats_MeanNs(const GPS_KALMAN_Stats_t *stats)
+{
+    return (stats->count == 0) ? 0 : (uint32_t) (stats->sumNs / stats->count);
+}
+
+/*=====================================================================================
+** Name: GPS_KALMAN_Stats_PercentileNs
+**
+** Purpose: To estimate a percentile from the histogram
+**
+** Arguments:
+**    const GPS_KALMAN_Stats_t *stats  - accumulator
+**    uint32_t pct                     - percentile, (0, 100]
+**
+** Returns:
+**    uint32_t - upper edge of the bin holding the percentile, clamped to the longest
+**               sample, nanoseconds; 0 with no samples
+**=====================================================================================*/
+uint32_t GPS_KALMAN_Stats_PercentileNs(const GPS_KALMAN_Stats_t *stats, uint32_t pct)
+{
+    uint64_t target;
+    uint64_t seen = 0;
+    uint64_t top = 0;
+    uint32_t bin;
+
+    if (stats->count == 0)
+    {
+        return 0;
+    }
+
+    /* rank of the sample at the percentile, rounded up */
+    target = ((uint64_t) stats->count * pct + 99) / 100;
+
+    for (bin = 0; bin < GPS_KALMAN_STATS_BINS; bin++)
+    {
+        seen += stats->hist[bin];
+        if (seen >= target)
+        {
+            top = GPS_KALMAN_Stats_BinTop(bin);
+            break;
+        }
+    }
+
+    return (top > stats->maxNs) ? stats->maxNs : (uint32_t) top;
+}
+
+/*=======================================================================================
+** End of file gps_kalman_stats.c
+**=====================================================================================*/
@@ -0,0 +1,59 @@
+/*=======================================================================================
+** File Name:  gps_kalman_stats.h
+**
+** Title:  Header File for GPS_KALMAN execution time statistics
+**
+** $Author:    GPS_KALMAN Team
+** $Revision: 1.1 $
+** $Date:      2026-10-17
+**
+** Purpose:  To define the per-stage execution time accumulators reported in
+**           housekeeping: min, max, mean and 99th percentile, from a monotonic clock
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**   2026-10-17 | GPS_KALMAN Team | Build #: Code Started
+**
+**=====================================================================================*/
+
+#ifndef _GPS_KALMAN_STATS_H_
+#define _GPS_KALMAN_STATS_H_
+
+#include <stdint.h>
+
+/* The percentile comes from a log-scale histogram with four bins per octave, so
+** it is reported to within 19%. 128 bins cover 1 ns up to 2^32 ns. */
+#define GPS_KALMAN_STATS_SUB_BITS   2
+#define GPS_KALMAN_STATS_BINS       (32 << GPS_KALMAN_STATS_SUB_BITS)
+
+typedef struct
+{
+    uint32_t count;                           /* samples since the last reset */
+    uint32_t minNs;                           /* shortest sample */
+    uint32_t maxNs;                           /* longest sample */
+    uint64_t sumNs;                           /* sum of all samples, for the mean */
+    uint32_t hist[GPS_KALMAN_STATS_BINS];     /* log-scale sample counts */
+} GPS_KALMAN_Stats_t;
+
+/* Monotonic clock in nanoseconds, for differences only */
+uint64_t GPS_KALMAN_Stats_NowNs(void);
+
+/* Clear an accumulator */
+void     GPS_KALMAN_Stats_Reset(GPS_KALMAN_Stats_t *stats);
+
+/* Add one sample; samples of 2^32 ns or more saturate */
+void     GPS_KALMAN_Stats_Add(GPS_KALMAN_Stats_t *stats, uint64_t ns);
+
+/* Mean sample, 0 with no samples */
+uint32_t GPS_KALMAN_Stats_MeanNs(const GPS_KALMAN_Stats_t *stats);
+
+/* Upper edge of the histogram bin holding the given percentile (0-100], clamped to
+** the longest sample; 0 with no samples */
+uint32_t GPS_KALMAN_Stats_PercentileNs(const GPS_KALMAN_Stats_t *stats, uint32_t pct);
+
+#endif /* _GPS_KALMAN_STATS_H_ */
+
+/*=======================================================================================
+** End of file gps_kalman_stats.h
+**=====================================================================================*/
@@ -0,0 +1,32 @@
+/*=======================================================================================
+** File Name:  gps_kalman_tbldefs.h
+**
+** Title:  Table Definitions Header File for GPS_KALMAN Application
+**
+** $Author:    GPS_KALMAN Team
+** $Revision: 1.1 $
+** $Date:      2026-10-17
+**
+** Purpose:  To define the layout of GPS_KALMAN's parameter table, shared by the app and
+**           the default table source in fsw/tables
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**   2026-10-17 | GPS_KALMAN Team | Build #: Code Started
+**
+**=====================================================================================*/
+
+#ifndef _GPS_KALMAN_TBLDEFS_H_
+#define _GPS_KALMAN_TBLDEFS_H_
+
+#include "gps_kalman_core.h"
+
+/* The filter tuning, exactly as the core takes it, so a load is applied by copying */
+typedef GPS_KALMAN_Params_t GPS_KALMAN_ParamTbl_t;
+
+#endif /* _GPS_KALMAN_TBLDEFS_H_ */
+
+/*=======================================================================================
+** End of file gps_kalman_tbldefs.h
+**=====================================================================================*/
@@ -11,6 +11,12 @@
 **
 ** Functions Defined:
 **    Function decimal_minutes2decimal_decimal: converts a decimal-minutes formatted number to pure decimal
+**    Function decimal_minutes2decimal_decimal_n: the same on an array, vectorised
+**    Function enu_anchor_set: anchors the local east/north frame at a fix
+**    Function geodetic2enu_fast: latitude/longitude to local east/north metres
+**    Function enu2geodetic_fast: local east/north metres to latitude/longitude
+**    Function speed_heading2north_east: converts speed and heading to north/east rates
+**    Function north_east2speed_heading: converts north/east rates to speed and heading
 **
 ** Limitations, Assumptions, External Events, and Notes:
 **    1. List assumptions that are made that apply to all functions in the file.
@@ -26,17 +32,119 @@
 **   Date | Author | Description
 **   ---------------------------
 **   2019-08-19 | Jacob Killelea | Build #: Code Started
+**   2026-10-17 | GPS_KALMAN Team | Speed/heading to north/east velocity conversions
+**   2026-10-17 | GPS_KALMAN Team | Local east/north frame, velocities in m/s
+**   2026-10-17 | GPS_KALMAN Team | Sign-aware decimal minutes conversion, batch form
+**   2026-10-17 | GPS_KALMAN Team | NaN for decimal minutes too large to convert
 **
 **=====================================================================================*/
 
+#include <math.h>
+
+#include "gps_kalman_utils.h"
+
+#define GPS_KALMAN_DEG2RAD (3.14159265358979323846 / 180.0)
+#define GPS_KALMAN_KPH2MPS (1.0 / 3.6)
+
+/* WGS84 ellipsoid */
+#define GPS_KALMAN_WGS84_A   (6378137.0)         /* semi-major axis, m */
+#define GPS_KALMAN_WGS84_E2  (6.69437999014e-3)  /* first eccentricity squared */
+
+/* Whole degrees a decimal minutes value may have; more would overflow the conversion
+** to int. Far beyond any coordinate. */
+#define GPS_KALMAN_DM_MAX_DEG (2.0e9)
+
+
+/* DDDMM.mmmmm to DDD.dddddd, shared by the scalar and array forms so they agree bit for
+** bit. Works on the magnitude and puts the sign back, so both hemispheres take the
+** same path and -0 stays -0. |dm| / 100 never rounds up to the next whole degree,
+** and the minutes are then exact, so the only rounding is in minutes / 60 and the sum.
+** Branch free, and the whole degrees come from an int conversion rather than trunc(),
+** so the array loop vectorises with SSE2 alone (needs -fno-trapping-math). A value
+** of GPS_KALMAN_DM_MAX_DEG degrees or more, infinite or NaN is not converted: the
+** result is NaN, never a wrong coordinate. */
+static inline double decimal_minutes2decimal(const double dm) {
+    double mag     = fabs(dm);
+    double degrees = mag / 100.0;                                 /* DDD.MMmmmmm */
+    int    valid   = (degrees < GPS_KALMAN_DM_MAX_DEG);           /* NaN is not */
+    double decimal;
+
+    degrees = valid ? degrees : 0.0;
+    degrees = (double) ((int) degrees);                           /* DDD */
+    decimal = copysign(degrees + (mag - 100.0 * degrees) / 60.0, dm); /* DDD.dddddd */
+    return valid ? decimal : NAN;
+}
 
 /* convert from DDDMM.mmmmm (decimal minutes) to DDD.dddddd (plain decimal) format */
-/* TODO: double check this! */
 double decimal_minutes2decimal_decimal(const double decimal_minutes) {
-    double degrees = ((int) (decimal_minutes/100.0)); /* DDD */
-    double minutes = decimal_minutes - 100*degrees;   /* MM.mmmmmm */
-    double decimal = minutes / 60;                    /* 0.ddddddd */
-    return (degrees + decimal);                       /* DDD.dddddd */
+    return decimal_minutes2decimal(decimal_minutes);
+}
+
+/* convert n decimal minutes values, e.g. interleaved lat/lon pairs, to plain decimal */
+void decimal_minutes2decimal_decimal_n(const double *restrict decimal_minutes,
+                                       double *restrict decimal, size_t n) {
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        decimal[i] = decimal_minutes2decimal(decimal_minutes[i]);
+    }
 }
 
+/* anchor the local east/north frame: the only trig, done once per anchor */
+void enu_anchor_set(GPS_KALMAN_EnuAnchor_t *anchor, const double lat_deg,
+                    const double lon_deg) {
+    double sin_lat0 = sin(lat_deg * GPS_KALMAN_DEG2RAD);
+    double cos_lat0 = cos(lat_deg * GPS_KALMAN_DEG2RAD);
+    double w2 = 1.0 - GPS_KALMAN_WGS84_E2 * sin_lat0 * sin_lat0;
+    double rn = GPS_KALMAN_WGS84_A / sqrt(w2);          /* prime vertical radius */
+    double rm = rn * (1.0 - GPS_KALMAN_WGS84_E2) / w2;  /* meridian radius */
+
+    anchor->lat0     = lat_deg;
+    anchor->lon0     = lon_deg;
+    anchor->mPerDegN = rm * GPS_KALMAN_DEG2RAD;
+    anchor->mPerDegE = rn * cos_lat0 * GPS_KALMAN_DEG2RAD;
+}
 
+/* latitude and longitude to east and north metres from the anchor, no trig */
+void geodetic2enu_fast(const GPS_KALMAN_EnuAnchor_t *anchor, const double lat_deg,
+                       const double lon_deg, double *east_m, double *north_m) {
+    double dlon = lon_deg - anchor->lon0;
+
+    /* take the short way round the antimeridian */
+    if (dlon > 180.0) {
+        dlon -= 360.0;
+    } else if (dlon < -180.0) {
+        dlon += 360.0;
+    }
+
+    *east_m  = dlon * anchor->mPerDegE;
+    *north_m = (lat_deg - anchor->lat0) * anchor->mPerDegN;
+}
+
+/* east and north metres from the anchor to latitude and longitude */
+void enu2geodetic_fast(const GPS_KALMAN_EnuAnchor_t *anchor, const double east_m,
+                       const double north_m, double *lat_deg, double *lon_deg) {
+    double lon = anchor->lon0 + east_m / anchor->mPerDegE;
+
+    *lat_deg = anchor->lat0 + north_m / anchor->mPerDegN;
+    *lon_deg = (lon > 180.0) ? (lon - 360.0) : ((lon < -180.0) ? (lon + 360.0) : lon);
+}
+
+/* convert ground speed and heading to north and east velocity */
+void speed_heading2north_east(const double speed_kph, const double heading_deg,
+                              double *vn, double *ve) {
+    double mps = speed_kph * GPS_KALMAN_KPH2MPS;
+    double hdg = heading_deg * GPS_KALMAN_DEG2RAD;
+
+    *vn = mps * cos(hdg);
+    *ve = mps * sin(hdg);
+}
+
+/* convert north and east velocity to ground speed and heading */
+void north_east2speed_heading(const double vn, const double ve,
+                              double *speed_kph, double *heading_deg) {
+    double hdg = atan2(ve, vn) / GPS_KALMAN_DEG2RAD; /* (-180, 180] */
+
+    *speed_kph   = sqrt(vn * vn + ve * ve) / GPS_KALMAN_KPH2MPS;
+    *heading_deg = (hdg < 0.0) ? (hdg + 360.0) : hdg;
+}
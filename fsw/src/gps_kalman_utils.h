@@ -13,16 +13,60 @@
 **   Date | Author | Description
 **   ---------------------------
 **   2019-08-19 | Jacob Killelea | Build #: Code Started
+**   2026-10-17 | GPS_KALMAN Team | Sign-aware decimal minutes conversion, batch form
+**   2026-10-17 | GPS_KALMAN Team | NaN for decimal minutes too large to convert
 **
 **=====================================================================================*/
     
 #ifndef _GPS_KALMAN_UTIL_H_
 #define _GPS_KALMAN_UTIL_H_
-#endif /* _GPS_KALMAN_UTIL_H_ */
 
-/* convert from DDDMM.mmmmm (decimal minutes) to DDD.dddddd (plain decimal) format */
+#include <stddef.h>
+
+/* Local tangent plane anchored at a reference fix. The anchor's sin/cos and the
+** ellipsoid radii of curvature there are folded into two scale factors once, when
+** the anchor is set, so per-sample conversions need no trig. */
+typedef struct
+{
+    double lat0;      /* anchor latitude, degrees */
+    double lon0;      /* anchor longitude, degrees */
+    double mPerDegN;  /* metres north per degree of latitude at the anchor */
+    double mPerDegE;  /* metres east per degree of longitude at the anchor */
+} GPS_KALMAN_EnuAnchor_t;
+
+/* convert from DDDMM.mmmmm (decimal minutes) to DDD.dddddd (plain decimal) format; the
+** sign, i.e. the hemisphere, is kept. NaN for 2e11 or more, far beyond any coordinate,
+** infinity or NaN. */
 double decimal_minutes2decimal_decimal(const double decimal_minutes);
 
+/* decimal_minutes2decimal_decimal on n values, with the same results; an array of
+** lat/lon pairs is 2 * pairs values. The arrays must not overlap. */
+void decimal_minutes2decimal_decimal_n(const double *restrict decimal_minutes,
+                                       double *restrict decimal, size_t n);
+
+/* anchor the local east/north frame at a latitude and longitude (degrees, WGS84) */
+void enu_anchor_set(GPS_KALMAN_EnuAnchor_t *anchor, const double lat_deg,
+                    const double lon_deg);
+
+/* latitude and longitude (degrees) to east and north metres from the anchor, without
+** trig: the tangent plane to first order, using the cached anchor terms */
+void geodetic2enu_fast(const GPS_KALMAN_EnuAnchor_t *anchor, const double lat_deg,
+                       const double lon_deg, double *east_m, double *north_m);
+
+/* exact inverse of geodetic2enu_fast */
+void enu2geodetic_fast(const GPS_KALMAN_EnuAnchor_t *anchor, const double east_m,
+                       const double north_m, double *lat_deg, double *lon_deg);
+
+/* convert ground speed (kph) and heading (degrees true) to north and east velocity (m/s) */
+void speed_heading2north_east(const double speed_kph, const double heading_deg,
+                              double *vn, double *ve);
+
+/* inverse of speed_heading2north_east, heading in [0, 360) */
+void north_east2speed_heading(const double vn, const double ve,
+                              double *speed_kph, double *heading_deg);
+
+#endif /* _GPS_KALMAN_UTIL_H_ */
+
 /*=======================================================================================
 ** End of file gps_kalman_utils.h
 **=====================================================================================*/
@@ -0,0 +1,67 @@
+/*=======================================================================================
+** File Name:  gps_kalman_param_tbl.c
+**
+** Title:  Default parameter table for GPS_KALMAN Application
+**
+** $Author:    GPS_KALMAN Team
+** $Revision: 1.1 $
+** $Date:      2026-10-17
+**
+** Purpose:  This file holds the default filter tuning, built into
+**           gps_kalman_prm.tbl and loaded at startup
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    1. Values are range checked by GPS_KALMAN_ValidateParamTbl on load; see
+**       GPS_KALMAN_Core_CheckParams for the limits
+**    2. One source entry per GPS_KALMAN_SOURCE_MAX, whether or not the receiver is
+**       flown; a missing entry is all zero and fails validation
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**   2026-10-17 | GPS_KALMAN Team | Build #: Code Started
+**   2026-10-17 | GPS_KALMAN Team | Innovation gate
+**   2026-10-17 | GPS_KALMAN Team | Noise model and latency per receiver
+**   2026-10-17 | GPS_KALMAN Team | Heading filter
+**   2026-10-17 | GPS_KALMAN Team | Steady-state gain
+**   2026-10-17 | GPS_KALMAN Team | Coast time limit
+**   2026-10-17 | GPS_KALMAN Team | Checkpoint resume age
+**
+**=====================================================================================*/
+
+#include "cfe.h"
+#include "cfe_tbl_filedef.h"
+
+#include "gps_kalman_platform_cfg.h"
+#include "gps_kalman_tbldefs.h"
+
+GPS_KALMAN_ParamTbl_t GPS_KALMAN_ParamTbl =
+{
+    {                            /* source: uereM, velSigmaMps, latencySec */
+        { GPS_KALMAN_UERE_M, GPS_KALMAN_VEL_SIGMA_MPS, GPS_KALMAN_LATENCY_SEC },
+        { GPS_KALMAN_UERE_M, GPS_KALMAN_VEL_SIGMA_MPS, GPS_KALMAN_LATENCY_SEC },
+        { GPS_KALMAN_UERE_M, GPS_KALMAN_VEL_SIGMA_MPS, GPS_KALMAN_LATENCY_SEC }
+    },
+    GPS_KALMAN_ACCEL_PSD,        /* accelPsd */
+    GPS_KALMAN_INIT_VAR_SCALE,   /* initVarScale */
+    GPS_KALMAN_DT_QUANTUM_SEC,   /* dtQuantumSec */
+    GPS_KALMAN_MAX_DT_SEC,       /* maxDtSec */
+    GPS_KALMAN_ENU_MAX_RANGE_M,  /* enuMaxRangeM */
+    GPS_KALMAN_GATE_CHI2,        /* gateChi2 */
+    GPS_KALMAN_GATE_MAX_REJECTS, /* gateMaxRejects */
+    0,                           /* spare */
+    GPS_KALMAN_HDG_MIN_SPEED_KPH, /* hdgMinSpeedKph */
+    GPS_KALMAN_YAW_ACCEL_PSD,    /* yawAccelPsd */
+    GPS_KALMAN_YAW_RATE_SIGMA0,  /* yawRateSigma0 */
+    GPS_KALMAN_STEADY_GAIN_TOL,  /* steadyGainTol */
+    GPS_KALMAN_STEADY_SETTLE_FIXES, /* steadySettleFixes */
+    0,                           /* spare2 */
+    GPS_KALMAN_COAST_MAX_SEC,    /* coastMaxSec */
+    GPS_KALMAN_RESUME_MAX_SEC    /* resumeMaxSec */
+};
+
+CFE_TBL_FILEDEF(GPS_KALMAN_ParamTbl, GPS_KALMAN.ParamTbl, GPS_KALMAN filter parameters, gps_kalman_prm.tbl)
+
+/*=======================================================================================
+** End of file gps_kalman_param_tbl.c
+**=====================================================================================*/